@@ -0,0 +1,363 @@
+// Source.h
+// The polynomials of hw7 and their arithmetic.
+//
+// A polynomial is a pair of parallel arrays, coefficients and exponents, with a size and a
+// capacity. Source.cpp tests these functions, and PolynomialBenchmark times them beside the
+// versions of hw8, which share their names; hence namespace hw7.
+
+#ifndef HW7_SOURCE_H
+#define HW7_SOURCE_H
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+
+#include "../polynomial/HeapMultiplication.h"
+#include "../polynomial/HeapDivision.h"
+
+namespace hw7
+{
+
+using std::cout;
+using std::endl;
+using std::istream;
+using std::copy;
+
+// polynomial = 0; the storage is kept for reuse
+inline void reset(int& size);
+
+// frees the storage of the specified polynomial
+inline void release(int*& coefficient, int*& exponent, int& size, int& capacity);
+
+// makes room for at least size terms, keeping the first numTerms terms;
+// the capacity at least doubles whenever the storage has to grow
+inline void reserve(int*& coefficient, int*& exponent, int& capacity, int size, int numTerms);
+
+// enable user to input a polynomial
+inline void input(istream& inFile, int*& coefficient, int*& exponent, int& size, int& capacity);
+
+// outputs the specified polynomial
+inline void output(int* coefficient, int* exponent, int size);
+
+// returns true if and only if the specified polynomial has at least a zero term
+inline bool hasZeroTerm(int* coefficient, int size);
+
+// returns true if and only if polynomial1 == polynomial2
+inline bool equal(int* coefficient1, int* exponent1, int size1,
+    int* coefficient2, int* exponent2, int size2);
+
+// polynomial1 = -polynomial2
+inline void minus(int*& coefficient1, int*& exponent1, int& size1, int& capacity1,
+    int* coefficient2, int* exponent2, int size2);
+
+// addend += sign * adder, merging backward in place
+inline void merge(int*& addendCoef, int*& addendExpon, int& addendSize, int& addendCapacity,
+    int* adderCoef, int* adderExpon, int adderSize, int sign);
+
+// addend += adder
+inline void addition(int*& addendCoef, int*& addendExpon, int& addendSize, int& addendCapacity,
+    int* adderCoef, int* adderExpon, int adderSize);
+
+// minuend -= subtrahend
+inline void subtraction(int*& minuendCoef, int*& minuendExpon, int& minuendSize, int& minuendCapacity,
+    int* subtrahendCoef, int* subtrahendExpon, int subtrahendSize);
+
+// product = multiplicand * multiplier
+inline void multiplication(int* multiplicandCoef, int* multiplicandExpon, int multiplicandSize,
+    int* multiplierCoef, int* multiplierExpon, int multiplierSize,
+    int*& productCoef, int*& productExpon, int& productSize, int& productCapacity);
+
+// quotient = dividend / divisor; remainder = dividend % divisor
+// provided that dividendExpon[ dividendSize - 1 ] >= divisorExpon[ divisorSize - 1 ]
+inline void division(int* dividendCoef, int* dividendExpon, int dividendSize,
+    int* divisorCoef, int* divisorExpon, int divisorSize,
+    int*& quotientCoef, int*& quotientExpon, int& quotientSize, int& quotientCapacity,
+    int*& remainderCoef, int*& remainderExpon, int& remainderSize, int& remainderCapacity);
+
+const int arraySize = 20;
+
+// polynomial = 0; the storage is kept for reuse
+inline void reset(int& size)
+{
+    size = 0;
+}
+
+// frees the storage of the specified polynomial
+inline void release(int*& coefficient, int*& exponent, int& size, int& capacity)
+{
+    size = 0;
+    capacity = 0;
+    if (coefficient != nullptr)
+    {
+        delete[] coefficient;
+        coefficient = nullptr;
+    }
+    if (exponent != nullptr)
+    {
+        delete[] exponent;
+        exponent = nullptr;
+    }
+}
+
+// makes room for at least size terms, keeping the first numTerms terms;
+// the capacity at least doubles whenever the storage has to grow
+inline void reserve(int*& coefficient, int*& exponent, int& capacity, int size, int numTerms)
+{
+    if (size <= capacity)
+        return;
+
+    int newCapacity = capacity < 4 ? 4 : 2 * capacity;
+    if (newCapacity < size)
+        newCapacity = size;
+
+    int* newCoef = new int[newCapacity];
+    int* newExpon = new int[newCapacity];
+    for (int i = 0; i < numTerms; i++)
+    {
+        newCoef[i] = coefficient[i];
+        newExpon[i] = exponent[i];
+    }
+
+    delete[] coefficient;
+    delete[] exponent;
+    coefficient = newCoef;
+    exponent = newExpon;
+    capacity = newCapacity;
+}
+
+// enable user to input a polynomial
+inline void input(istream& inFile, int*& coefficient, int*& exponent, int& size, int& capacity)
+{
+    int numericString[arraySize] = {};
+
+    inFile.read(reinterpret_cast<char*>(numericString), 80);
+
+    size = arraySize;
+    while (size > 0 && numericString[size - 1] == 0)
+        size--;
+
+    reserve(coefficient, exponent, capacity, size, 0);
+    for (int i = 0; i < size; ++i)
+        coefficient[i] = numericString[i];
+
+    inFile.read(reinterpret_cast<char*>(numericString), 80);
+
+    for (int i = 0; i < size; ++i)
+        exponent[i] = numericString[i];
+}
+
+// outputs the specified polynomial
+inline void output(int* coefficient, int* exponent, int size)
+{
+    // the specified polynomial is zero polynomial
+    if (size == 0)
+        cout << 0;
+    else
+    {
+        if (coefficient[0] < 0)
+            cout << "-" << -coefficient[0];
+        else if (coefficient[0] > 0)
+            cout << coefficient[0];
+
+        if (exponent[0] > 0)
+        {
+            if (exponent[0] == 1)
+                cout << "x";
+            else
+                cout << "x^" << exponent[0];
+        }
+
+        for (int i = 1; i < size; i++)
+        {
+            if (coefficient[i] < 0)
+                cout << " - " << -coefficient[i];
+            else if (coefficient[i] > 0)
+                cout << " + " << coefficient[i];
+
+            if (exponent[i] > 0)
+            {
+                if (exponent[i] == 1)
+                    cout << "x";
+                else
+                    cout << "x^" << exponent[i];
+            }
+        }
+    }
+
+    cout << endl;
+}
+
+// returns true if and only if the specified polynomial has at least a zero term
+inline bool hasZeroTerm(int* coefficient, int size)
+{
+    if (size != 0)
+        for (int i = 0; i < size; i++)
+            if (coefficient[i] == 0)
+                return true;
+
+    return false;
+}
+
+// returns true if and only if polynomial1 == polynomial2
+inline bool equal(int* coefficient1, int* exponent1, int size1,
+    int* coefficient2, int* exponent2, int size2)
+{
+    if (size1 != size2)
+        return false;
+
+    for (int i = 0; i < size1; i++)
+        if (coefficient1[i] != coefficient2[i] || exponent1[i] != exponent2[i])
+            return false;
+
+    return true;
+}
+
+// polynomial1 = -polynomial2
+inline void minus(int*& coefficient1, int*& exponent1, int& size1, int& capacity1,
+    int* coefficient2, int* exponent2, int size2)
+{
+    // the terms of polynomial1 are all replaced, so none is copied
+    reserve(coefficient1, exponent1, capacity1, size2, 0);
+    size1 = size2;
+    for (int i = 0; i < size1; i++)
+    {
+        coefficient1[i] = -coefficient2[i];
+        exponent1[i] = exponent2[i];
+    }
+}
+
+// addend += sign * adder, merging backward in place
+inline void merge(int*& addendCoef, int*& addendExpon, int& addendSize, int& addendCapacity,
+    int* adderCoef, int* adderExpon, int adderSize, int sign)
+{
+    // the sum has at most addendSize + adderSize terms
+    reserve(addendCoef, addendExpon, addendCapacity, addendSize + adderSize, addendSize);
+
+    int i = addendSize - 1; // addend
+    int j = adderSize - 1;  // adder
+    int k = addendSize + adderSize; // sum, filled from the back
+
+    // terms are stored in descending order of exponents, so the back holds the smallest ones;
+    // k > i + j + 1 always holds, thus no unread term of addend is overwritten
+    while (j >= 0)
+    {
+        if (i >= 0 && addendExpon[i] < adderExpon[j])
+        {
+            k--;
+            addendCoef[k] = addendCoef[i];
+            addendExpon[k] = addendExpon[i];
+            i--;
+        }
+        else if (i >= 0 && addendExpon[i] == adderExpon[j])
+        {
+            int coefficient = addendCoef[i] + sign * adderCoef[j];
+            if (coefficient != 0)
+            {
+                k--;
+                addendCoef[k] = coefficient;
+                addendExpon[k] = addendExpon[i];
+            }
+            i--;
+            j--;
+        }
+        else
+        {
+            k--;
+            addendCoef[k] = sign * adderCoef[j];
+            addendExpon[k] = adderExpon[j];
+            j--;
+        }
+    }
+
+    // addend[ 0 .. i ] are already in place; close the gap left by cancelled terms
+    int numMerged = addendSize + adderSize - k;
+    if (k != i + 1)
+    {
+        copy(addendCoef + k, addendCoef + k + numMerged, addendCoef + i + 1);
+        copy(addendExpon + k, addendExpon + k + numMerged, addendExpon + i + 1);
+    }
+
+    addendSize = i + 1 + numMerged;
+}
+
+// addend += adder
+inline void addition(int*& addendCoef, int*& addendExpon, int& addendSize, int& addendCapacity,
+    int* adderCoef, int* adderExpon, int adderSize)
+{
+    merge(addendCoef, addendExpon, addendSize, addendCapacity, adderCoef, adderExpon, adderSize, 1);
+}
+
+// minuend -= subtrahend
+inline void subtraction(int*& minuendCoef, int*& minuendExpon, int& minuendSize, int& minuendCapacity,
+    int* subtrahendCoef, int* subtrahendExpon, int subtrahendSize)
+{
+    // minuend = minuend + ( -subtrahend ), without materializing -subtrahend
+    merge(minuendCoef, minuendExpon, minuendSize, minuendCapacity,
+        subtrahendCoef, subtrahendExpon, subtrahendSize, -1);
+
+    if (minuendSize > 0 && minuendCoef[0] == 0)
+        cout << "Leading zeroes in minuend not allowed!\n";
+}
+
+// product = multiplicand * multiplier
+inline void multiplication(int* multiplicandCoef, int* multiplicandExpon, int multiplicandSize,
+    int* multiplierCoef, int* multiplierExpon, int multiplierSize,
+    int*& productCoef, int*& productExpon, int& productSize, int& productCapacity)
+{
+    // product = 0;
+    productSize = 0;
+
+    // merge the multiplicandSize * multiplierSize products in exponent order
+    heapMultiplication(arrayLayout(multiplicandCoef, multiplicandExpon, multiplicandSize),
+        arrayLayout(multiplierCoef, multiplierExpon, multiplierSize),
+        [&](int coef, int expon)
+        {
+            reserve(productCoef, productExpon, productCapacity, productSize + 1, productSize);
+            productCoef[productSize] = coef;
+            productExpon[productSize] = expon;
+            productSize++;
+        });
+
+    if (productSize > 0 && productCoef[0] == 0)
+        cout << "Leading zeroes in product not allowed!\n";
+}
+
+// quotient = dividend / divisor; remainder = dividend % divisor
+// provided that dividendExpon[ dividendSize - 1 ] >= divisorExpon[ divisorSize - 1 ]
+inline void division(int* dividendCoef, int* dividendExpon, int dividendSize,
+    int* divisorCoef, int* divisorExpon, int divisorSize,
+    int*& quotientCoef, int*& quotientExpon, int& quotientSize, int& quotientCapacity,
+    int*& remainderCoef, int*& remainderExpon, int& remainderSize, int& remainderCapacity)
+{
+    quotientSize = 0;
+    remainderSize = 0;
+
+    // the terms of dividend - divisor * quotient come out of a heap one at a time,
+    // so the remainder is written once instead of being rewritten for every quotient term
+    heapDivision(arrayLayout(dividendCoef, dividendExpon, dividendSize),
+        arrayLayout(divisorCoef, divisorExpon, divisorSize),
+        [&](int coef, int expon)
+        {
+            reserve(quotientCoef, quotientExpon, quotientCapacity, quotientSize + 1, quotientSize);
+            quotientCoef[quotientSize] = coef;
+            quotientExpon[quotientSize] = expon;
+            quotientSize++;
+        },
+        [&](int coef, int expon)
+        {
+            reserve(remainderCoef, remainderExpon, remainderCapacity, remainderSize + 1, remainderSize);
+            remainderCoef[remainderSize] = coef;
+            remainderExpon[remainderSize] = expon;
+            remainderSize++;
+        });
+
+    if (quotientSize > 0 && quotientCoef[0] == 0)
+        cout << "Leading zeroes in quotient not allowed!\n";
+
+    if (remainderSize > 0 && remainderCoef[0] == 0)
+        cout << "Leading zeroes in remainder not allowed!\n";
+}
+
+} // end namespace hw7
+
+#endif
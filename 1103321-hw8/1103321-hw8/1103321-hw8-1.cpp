@@ -13,46 +13,10 @@ using std::istream;
 using std::ifstream;
 using std::ios;
 
-struct Term
-{
-    int coef = 0;  // the coefficient of a term
-    int expon = 0; // the exponent of a term
-};
-
-void reset(Term*& polynomial, int& size);
-
-// enable user to input a polynomial
-void input(istream& inFile, Term*& polynomial, int& size);
-
-// outputs the specified polynomial
-void output(Term* polynomial, int size);
-
-// returns true if and only if the specified polynomial has at least a zero term
-bool hasZeroTerm(Term* polynomial, int size);
-
-// returns true if and only if polynomial1 == polynomial2
-bool equal(Term* polynomial1, int size1, Term* polynomial2, int size2);
-
-// polynomial1 = -polynomial2
-void minus(Term*& polynomial1, int& size1, Term*& polynomial2, int size2);
-
-// addend += adder
-void addition(Term*& addend, int& addendSize, Term* adder, int adderSize);
-
-// minuend -= subtrahend
-void subtraction(Term*& minuend, int& minuendSize, Term* subtrahend, int subtrahendSize);
-
-// product = multiplicand * multiplier
-void multiplication(Term* multiplicand, int multiplicandSize,
-    Term* multiplier, int multiplierSize, Term*& product, int& productSize);
-
-// quotient = dividend / divisor; remainder = dividend % divisor
-// provided that dividendExpon[ dividendSize - 1 ] >= divisorExpon[ divisorSize - 1 ]
-void division(Term* dividend, int dividendSize, Term* divisor, int divisorSize,
-    Term*& quotient, int& quotientSize, Term*& remainder, int& remainderSize);
+#include "1103321-hw8-1.h"
+using namespace hw81;
 
 const int numTestCases = 200; // the number of test cases
-const int arraySize = 20;
 
 int main()
 {
@@ -66,6 +30,9 @@ int main()
         exit(1);
     }
 
+    // every array of a test case is allocated in the arena
+    Arena arena;
+
     Term* dividend = nullptr;
     Term* divisor = nullptr;
     int dividendSize = 0;
@@ -83,8 +50,8 @@ int main()
     for (int i = 0; i < numTestCases; i++)
     {
         // input dividend and divisor from the file Polynomials.dat
-        input(inFile, dividend, dividendSize);
-        input(inFile, divisor, divisorSize);
+        input(inFile, dividend, dividendSize, arena);
+        input(inFile, divisor, divisorSize, arena);
         /**/
         cout << "dividend:  ";
         output(dividend, dividendSize);
@@ -95,7 +62,7 @@ int main()
         // quotient = dividend / divisor; remainder = dividend % divisor
         // thus, dividend == divisor * quotient + remainder
         division(dividend, dividendSize, divisor, divisorSize,
-            quotient, quotientSize, remainder, remainderSize);
+            quotient, quotientSize, remainder, remainderSize, arena);
 
         /**/
         cout << "quotient:  ";
@@ -110,14 +77,14 @@ int main()
             {
                 // buffer = divisor * quotient
                 multiplication(divisor, divisorSize,
-                    quotient, quotientSize, buffer, bufferSize);
+                    quotient, quotientSize, buffer, bufferSize, arena);
 
                 if (hasZeroTerm(buffer, bufferSize))
                     cout << "buffer has at least a zero term!\n";
                 else
                 {
                     // buffer = buffer + remainder = divisor * quotient + remainder
-                    addition(buffer, bufferSize, remainder, remainderSize);
+                    addition(buffer, bufferSize, remainder, remainderSize, arena);
 
 /*                    for (int n = 0; n < bufferSize; n++)
                         cout << buffer[n].expon << "  ";
@@ -143,6 +110,9 @@ int main()
         reset(remainder, remainderSize);
 
         reset(buffer, bufferSize);
+
+        // all arrays of this test case are freed at once
+        arena.reset();
     }
 
     inFile.close();
@@ -151,350 +121,3 @@ int main()
 
     system("pause");
 }
-
-void reset(Term*& polynomial, int& size)
-{
-    size = 0;
-    if (polynomial != nullptr)
-    {
-        delete[] polynomial;
-        polynomial = nullptr;
-    }
-}
-
-// enable user to input a polynomial
-void input(istream& inFile, Term*& polynomial, int& size)
-{
-    int numericString[arraySize] = {};
-
-    inFile.read(reinterpret_cast<char*>(numericString), 80);
-
-    size = arraySize;
-    while (size > 0 && numericString[size - 1] == 0)
-        size--;
-
-    polynomial = new Term[size];
-    for (int i = 0; i < size; ++i)
-        polynomial[i].coef = numericString[i];
-    /*
-       for( int i = 0; i < size; ++i )
-          cout << setw( 4 ) << numericString[ i ];
-       cout << endl;
-    */
-    inFile.read(reinterpret_cast<char*>(numericString), 80);
-
-    for (int i = 0; i < size; ++i)
-        polynomial[i].expon = numericString[i];
-    /*
-       for( int i = 0; i < size; ++i )
-          cout << setw( 4 ) << exponent[ i ];
-       cout << endl;
-    */
-}
-
-// outputs the specified polynomial
-void output(Term* polynomial, int size)
-{
-    // the specified polynomial is zero polynomial
-    if (size == 0)
-        cout << 0;
-    else
-    {
-        if (polynomial[0].coef < 0)
-            cout << "-" << -polynomial[0].coef;
-        else if (polynomial[0].coef > 0)
-            cout << polynomial[0].coef;
-
-        if (polynomial[0].expon > 0)
-        {
-            if (polynomial[0].expon == 1)
-                cout << "x";
-            else
-                cout << "x^" << polynomial[0].expon;
-        }
-
-        for (int i = 1; i < size; i++)
-        {
-            if (polynomial[i].coef < 0)
-                cout << " - " << -polynomial[i].coef;
-            else if (polynomial[i].coef > 0)
-                cout << " + " << polynomial[i].coef;
-
-            if (polynomial[i].expon > 0)
-            {
-                if (polynomial[i].expon == 1)
-                    cout << "x";
-                else
-                    cout << "x^" << polynomial[i].expon;
-            }
-        }
-    }
-
-    cout << endl;
-}
-
-// returns true if and only if the specified polynomial has at least a zero term
-bool hasZeroTerm(Term* polynomial, int size)
-{
-    if (size != 0)
-        for (int i = 0; i < size; i++)
-            if (polynomial[i].coef == 0)
-                return true;
-
-    return false;
-}
-
-// returns true if and only if polynomial1 == polynomial2
-bool equal(Term* polynomial1, int size1, Term* polynomial2, int size2)
-{
-    if (size1 != size2)
-        return false;
-
-    for (int i = 0; i < size1; i++)
-        if (polynomial1[i].coef != polynomial2[i].coef ||
-            polynomial1[i].expon != polynomial2[i].expon)
-            return false;
-
-    return true;
-}
-
-// polynomial1 = -polynomial2
-void minus(Term*& polynomial1, int& size1, Term*& polynomial2, int size2)
-{
-    size1 = size2;
-    for (int i = 0; i < size1; i++)
-    {
-        polynomial1[i].coef = -polynomial2[i].coef;
-        polynomial1[i].expon = polynomial2[i].expon;
-    }
-}
-
-// addend += adder
-void addition(Term*& addend, int& addendSize, Term* adder, int adderSize)
-{
-    Term* sum = new Term[arraySize]();
-    int i = 0;//addend
-    int j = 0;//adder
-    int k = 0;//sum
-
-/*    for (int n = 0; n < addendSize; n++)
-        cout << addend[n].expon << "  ";
-    cout << endl;
-    for (int n = 0; n < addendSize; n++)
-        cout << addend[n].coef << "  ";
-    cout << endl;
-
-    for (int n = 0; n < adderSize; n++)
-        cout << adder[n].expon << "  ";
-    cout << endl;
-    for (int n = 0; n < adderSize; n++)
-        cout << adder[n].coef << "  ";
-    cout << endl;*/
-
-    if (adderSize == 0)
-    {
-        for (; k < addendSize; k++)
-        {
-            sum[k].expon = addend[k].expon;
-            sum[k].coef = addend[k].coef;
-        }            
-    }
-    else if (addendSize == 0)
-    {
-        for (; k < adderSize; k++)
-        {
-            sum[k].coef = adder[k].coef;
-            sum[k].expon = adder[k].expon;
-        }
-    }
-    else
-    {
-        while (1)
-        {
-            if (i == addendSize && j == adderSize)
-                break;
-
-            if (i == addendSize)
-            {
-                for (; j < adderSize; j++)
-                {
-                    sum[k] = adder[j];
-                    k++;
-                }
-                break;
-            }
-
-            if (j == adderSize)
-            {
-                for (; i < addendSize; i++)
-                {
-                    sum[k] = addend[i];
-                    k++;
-                }
-                break;
-            }
-
-            if (addend[i].expon > adder[j].expon)
-            {
-                sum[k].expon = addend[i].expon;
-                sum[k].coef = addend[i].coef;
-                i++; k++;
-            }
-            else if (addend[i].expon < adder[j].expon)
-            {
-                sum[k].expon = adder[j].expon;
-                sum[k].coef = adder[j].coef;
-                j++; k++;
-            }
-            else
-            {
-                if (addend[i].coef + adder[j].coef == 0)
-                {
-                    i++; j++;
-                    continue;
-                }
-
-                sum[k].coef = addend[i].coef + adder[j].coef;
-                sum[k].expon = addend[i].expon;
-                i++; j++; k++;
-            }
-            
-/*            for (int n = 0; n < addendSize; n++)
-                cout << sum[n].expon << "  ";
-            cout << endl;
-            for (int n = 0; n < addendSize; n++)
-                cout << sum[n].coef << "  ";
-            cout << endl;
-            cout << endl;*/
-        }
-    }
-
-/*    for (int n = 0; n < k; n++)
-        cout << sum[n].expon << "  ";
-    cout << endl;
-    for (int n = 0; n < k; n++)
-        cout << sum[n].coef << "  ";
-    cout << endl;*/
-
-    if (addendSize != k)
-        addend = new Term[k];
-
-    addendSize = k;
-    for (int i = 0; i < addendSize; i++) // addend = sum
-        addend[i] = sum[i];
-
-    delete[] sum;
-}
-
-// minuend -= subtrahend
-void subtraction(Term*& minuend, int& minuendSize, Term* subtrahend, int subtrahendSize)
-{
-    // buffer = 0
-    int bufferSize = subtrahendSize;
-    Term* buffer = new Term[bufferSize]();
-
-    // buffer = -subtrahend
-    minus(buffer, bufferSize, subtrahend, subtrahendSize);
-
-    // minuend = minuend + buffer = minuend - subtrahend
-    addition(minuend, minuendSize, buffer, bufferSize);
-
-    delete[] buffer;
-
-    if (minuendSize > 0 && minuend[0].coef == 0)
-        cout << "Leading zeroes in minuend not allowed!\n";
-}
-
-// product = multiplicand * multiplier
-void multiplication(Term* multiplicand, int multiplicandSize,
-    Term* multiplier, int multiplierSize, Term*& product, int& productSize)
-{
-    // product = 0;
-    productSize = 0;
-
-    int bufferSize = multiplicandSize;
-    Term* buffer = new Term[bufferSize]();
-
-    // if( multiplicand != 0 && multiplier != 0 )
-    if (multiplicandSize != 0 && multiplierSize != 0)
-    {
-        for (int i = 0; i < multiplierSize; i++)
-        {
-            for (int j = 0; j < multiplicandSize; j++)
-            {
-                buffer[j].coef = multiplicand[j].coef * multiplier[i].coef;
-                buffer[j].expon = multiplicand[j].expon + multiplier[i].expon;
-            }
-            addition(product, productSize, buffer, bufferSize);
-            
-/*            for (int i = 0; i < productSize; i++)
-            {
-                cout << product[i].expon << "  ";
-            }
-            cout << endl;
-            for (int i = 0; i < productSize; i++)
-            {
-                cout << product[i].coef << "  ";
-            }
-            cout << endl;*/
-
-        }  
-    }
-
-    delete[] buffer;
-
-    if (productSize > 0 && product[0].coef == 0)
-        cout << "Leading zeroes in product not allowed!\n";
-}
-
-// quotient = dividend / divisor; remainder = dividend % divisor
-// provided that dividendExpon[ dividendSize - 1 ] >= divisorExpon[ divisorSize - 1 ]
-void division(Term* dividend, int dividendSize, Term* divisor, int divisorSize,
-    Term*& quotient, int& quotientSize, Term*& remainder, int& remainderSize)
-{
-    // remainder = dividend
-    remainderSize = dividendSize;
-    remainder = new Term[remainderSize]();
-    for (int i = 0; i < remainderSize; i++)
-        remainder[i] = dividend[i];
-
-    int monomialSize = 1;
-    Term* monomial = new Term[1]();
-
-    int bufferSize = 0;
-    Term* buffer = nullptr;
-
-    Term temp[arraySize] = {};
-    quotientSize = 0;
-
-    while (remainderSize != 0 && remainder[0].expon >= divisor[0].expon)
-    {
-        temp[quotientSize].coef = remainder[0].coef / divisor[0].coef;
-        temp[quotientSize].expon = remainder[0].expon - divisor[0].expon;
-        
-/*        cout << temp[quotientSize].expon << endl;
-        cout << temp[quotientSize].coef << endl;*/ 
-        
-        monomial[0].expon = temp[quotientSize].expon;
-        monomial[0].coef = temp[quotientSize].coef;
-
-        multiplication(divisor, divisorSize, monomial, monomialSize, buffer, bufferSize);
-
-        subtraction(remainder, remainderSize, buffer, bufferSize);
-        quotientSize++;
-    }
-
-    quotient = new Term[quotientSize];
-    for (int i = 0; i < quotientSize; ++i)
-        quotient[i] = temp[i];
-
-    delete[] monomial;
-
-    delete[] buffer;
-
-    if (quotientSize > 0 && quotient[0].coef == 0)
-        cout << "Leading zeroes in quotient not allowed!\n";
-
-    if (remainderSize > 0 && remainder[0].coef == 0)
-        cout << "Leading zeroes in remainder not allowed!\n";
-}
\ No newline at end of file
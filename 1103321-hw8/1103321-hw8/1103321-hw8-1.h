@@ -0,0 +1,253 @@
+// 1103321-hw8-1.h
+// The polynomials of hw8-1 and their arithmetic, in namespace hw81.
+//
+// A polynomial is an array of terms allocated in an arena, which the caller resets after each
+// test case. Used by 1103321-hw8-1.cpp and by PolynomialBenchmark.
+
+#ifndef HW8_1_H
+#define HW8_1_H
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+
+#include "../../polynomial/SparseMultiplication.h"
+#include "../../polynomial/HeapDivision.h"
+#include "../../polynomial/MergeAddition.h"
+#include "../../polynomial/Arena.h"
+
+namespace hw81
+{
+
+using std::cout;
+using std::endl;
+using std::setw;
+using std::istream;
+
+struct Term
+{
+    int coef = 0;  // the coefficient of a term
+    int expon = 0; // the exponent of a term
+};
+
+// polynomial = 0; its terms stay in the arena until the arena is reset
+inline void reset(Term*& polynomial, int& size);
+
+// enable user to input a polynomial
+inline void input(istream& inFile, Term*& polynomial, int& size, Arena& arena);
+
+// outputs the specified polynomial
+inline void output(Term* polynomial, int size);
+
+// returns true if and only if the specified polynomial has at least a zero term
+inline bool hasZeroTerm(Term* polynomial, int size);
+
+// returns true if and only if polynomial1 == polynomial2
+inline bool equal(Term* polynomial1, int size1, Term* polynomial2, int size2);
+
+// polynomial1 = -polynomial2
+inline void minus(Term*& polynomial1, int& size1, Term*& polynomial2, int size2);
+
+// addend += adder
+inline void addition(Term*& addend, int& addendSize, Term* adder, int adderSize, Arena& arena);
+
+// minuend -= subtrahend
+inline void subtraction(Term*& minuend, int& minuendSize, Term* subtrahend, int subtrahendSize, Arena& arena);
+
+// product = multiplicand * multiplier
+inline void multiplication(Term* multiplicand, int multiplicandSize,
+    Term* multiplier, int multiplierSize, Term*& product, int& productSize, Arena& arena);
+
+// quotient = dividend / divisor; remainder = dividend % divisor
+// provided that dividendExpon[ dividendSize - 1 ] >= divisorExpon[ divisorSize - 1 ]
+inline void division(Term* dividend, int dividendSize, Term* divisor, int divisorSize,
+    Term*& quotient, int& quotientSize, Term*& remainder, int& remainderSize, Arena& arena);
+
+const int arraySize = 20;
+
+// polynomial = 0; its terms stay in the arena until the arena is reset
+inline void reset(Term*& polynomial, int& size)
+{
+    size = 0;
+    polynomial = nullptr;
+}
+
+// enable user to input a polynomial
+inline void input(istream& inFile, Term*& polynomial, int& size, Arena& arena)
+{
+    int numericString[arraySize] = {};
+
+    inFile.read(reinterpret_cast<char*>(numericString), 80);
+
+    size = arraySize;
+    while (size > 0 && numericString[size - 1] == 0)
+        size--;
+
+    polynomial = arenaArray< Term >(arena, size);
+    for (int i = 0; i < size; ++i)
+        polynomial[i].coef = numericString[i];
+    /*
+       for( int i = 0; i < size; ++i )
+          cout << setw( 4 ) << numericString[ i ];
+       cout << endl;
+    */
+    inFile.read(reinterpret_cast<char*>(numericString), 80);
+
+    for (int i = 0; i < size; ++i)
+        polynomial[i].expon = numericString[i];
+    /*
+       for( int i = 0; i < size; ++i )
+          cout << setw( 4 ) << exponent[ i ];
+       cout << endl;
+    */
+}
+
+// outputs the specified polynomial
+inline void output(Term* polynomial, int size)
+{
+    // the specified polynomial is zero polynomial
+    if (size == 0)
+        cout << 0;
+    else
+    {
+        if (polynomial[0].coef < 0)
+            cout << "-" << -polynomial[0].coef;
+        else if (polynomial[0].coef > 0)
+            cout << polynomial[0].coef;
+
+        if (polynomial[0].expon > 0)
+        {
+            if (polynomial[0].expon == 1)
+                cout << "x";
+            else
+                cout << "x^" << polynomial[0].expon;
+        }
+
+        for (int i = 1; i < size; i++)
+        {
+            if (polynomial[i].coef < 0)
+                cout << " - " << -polynomial[i].coef;
+            else if (polynomial[i].coef > 0)
+                cout << " + " << polynomial[i].coef;
+
+            if (polynomial[i].expon > 0)
+            {
+                if (polynomial[i].expon == 1)
+                    cout << "x";
+                else
+                    cout << "x^" << polynomial[i].expon;
+            }
+        }
+    }
+
+    cout << endl;
+}
+
+// returns true if and only if the specified polynomial has at least a zero term
+inline bool hasZeroTerm(Term* polynomial, int size)
+{
+    if (size != 0)
+        for (int i = 0; i < size; i++)
+            if (polynomial[i].coef == 0)
+                return true;
+
+    return false;
+}
+
+// returns true if and only if polynomial1 == polynomial2
+inline bool equal(Term* polynomial1, int size1, Term* polynomial2, int size2)
+{
+    if (size1 != size2)
+        return false;
+
+    for (int i = 0; i < size1; i++)
+        if (polynomial1[i].coef != polynomial2[i].coef ||
+            polynomial1[i].expon != polynomial2[i].expon)
+            return false;
+
+    return true;
+}
+
+// polynomial1 = -polynomial2
+inline void minus(Term*& polynomial1, int& size1, Term*& polynomial2, int size2)
+{
+    size1 = size2;
+    for (int i = 0; i < size1; i++)
+    {
+        polynomial1[i].coef = -polynomial2[i].coef;
+        polynomial1[i].expon = polynomial2[i].expon;
+    }
+}
+
+// addend += adder
+inline void addition(Term*& addend, int& addendSize, Term* adder, int adderSize, Arena& arena)
+{
+    // the merge and the compaction of like terms both run in the new arena array
+    Term* sum = arenaArray< Term >(arena, addendSize + adderSize);
+    int k = mergeAddition(addend, addendSize, adder, adderSize, sum);
+
+    // addend = sum; the old terms of addend stay in the arena until it is reset
+    addend = sum;
+    addendSize = k;
+}
+
+// minuend -= subtrahend
+inline void subtraction(Term*& minuend, int& minuendSize, Term* subtrahend, int subtrahendSize, Arena& arena)
+{
+    // buffer = 0
+    int bufferSize = subtrahendSize;
+    Term* buffer = arenaArray< Term >(arena, bufferSize);
+
+    // buffer = -subtrahend
+    minus(buffer, bufferSize, subtrahend, subtrahendSize);
+
+    // minuend = minuend + buffer = minuend - subtrahend
+    addition(minuend, minuendSize, buffer, bufferSize, arena);
+
+    if (minuendSize > 0 && minuend[0].coef == 0)
+        cout << "Leading zeroes in minuend not allowed!\n";
+}
+
+// product = multiplicand * multiplier
+inline void multiplication(Term* multiplicand, int multiplicandSize,
+    Term* multiplier, int multiplierSize, Term*& product, int& productSize, Arena& arena)
+{
+    // product = 0;
+    reset(product, productSize);
+
+    // the multiplicandSize * multiplierSize products are merged by a heap or accumulated in a hash table,
+    // whichever suits the expected density of the product
+    int productCapacity = 0;
+    sparseMultiplication(termLayout(multiplicand, multiplicandSize), termLayout(multiplier, multiplierSize),
+        [&](int coef, int expon) { appendTerm(arena, product, productSize, productCapacity, coef, expon); });
+
+    if (productSize > 0 && product[0].coef == 0)
+        cout << "Leading zeroes in product not allowed!\n";
+}
+
+// quotient = dividend / divisor; remainder = dividend % divisor
+// provided that dividendExpon[ dividendSize - 1 ] >= divisorExpon[ divisorSize - 1 ]
+inline void division(Term* dividend, int dividendSize, Term* divisor, int divisorSize,
+    Term*& quotient, int& quotientSize, Term*& remainder, int& remainderSize, Arena& arena)
+{
+    reset(quotient, quotientSize);
+    reset(remainder, remainderSize);
+
+    // the terms of dividend - divisor * quotient come out of a heap one at a time,
+    // so the remainder is written once instead of being rewritten for every quotient term
+    int quotientCapacity = 0;
+    int remainderCapacity = 0;
+    heapDivision(termLayout(dividend, dividendSize), termLayout(divisor, divisorSize),
+        [&](int coef, int expon) { appendTerm(arena, quotient, quotientSize, quotientCapacity, coef, expon); },
+        [&](int coef, int expon) { appendTerm(arena, remainder, remainderSize, remainderCapacity, coef, expon); });
+
+    if (quotientSize > 0 && quotient[0].coef == 0)
+        cout << "Leading zeroes in quotient not allowed!\n";
+
+    if (remainderSize > 0 && remainder[0].coef == 0)
+        cout << "Leading zeroes in remainder not allowed!\n";
+}
+
+} // end namespace hw81
+
+#endif
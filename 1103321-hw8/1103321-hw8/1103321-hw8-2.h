@@ -0,0 +1,292 @@
+// 1103321-hw8-2.h
+// The Polynomial struct of hw8-2 and its arithmetic, in namespace hw82.
+//
+// A polynomial holds its size and an array of terms allocated with new[]. Used by
+// 1103321-hw8-2.cpp and by PolynomialBenchmark.
+
+#ifndef HW8_2_H
+#define HW8_2_H
+
+#include <iostream>
+#include <fstream>
+
+#include "../../polynomial/SparseMultiplication.h"
+#include "../../polynomial/HeapDivision.h"
+#include "../../polynomial/MergeAddition.h"
+
+namespace hw82
+{
+
+using std::cout;
+using std::endl;
+using std::istream;
+
+struct Term
+{
+    int coef = 0;  // the coefficient of a term
+    int expon = 0; // the exponent of a term
+};
+
+// Polynomial struct definition
+struct Polynomial
+{
+    int size = 0;          // the number of terms of the polynomial
+    Term* terms = nullptr; // all terms of the polynomial
+};
+
+// term1 = term2
+inline void assign(Term& term1, const Term& term2);
+
+// polynomial = 0
+inline void reset(Polynomial& polynomial);
+
+// inputs a polynomial from the file Polynomials.dat
+inline void input(istream& inFile, Polynomial& polynomial);
+
+// outputs the specified polynomial
+inline void output(const Polynomial& polynomial);
+
+// returns true if and only if the specified polynomial has at least a zero term
+inline bool hasZeroTerm(const Polynomial& polynomial);
+
+// returns true if and only if polynomial1 == polynomial2
+inline bool equal(const Polynomial& polynomial1, const Polynomial& polynomial2);
+
+// polynomial1 = -polynomial2
+inline void minus(Polynomial& polynomial1, const Polynomial& polynomial2);
+
+// addend += adder
+inline void addition(Polynomial& addend, const Polynomial adder);
+
+// minuend -= subtrahend
+inline void subtraction(Polynomial& minuend, const Polynomial& subtrahend);
+
+// product = multiplicand * multiplier
+inline void multiplication(const Polynomial& multiplicand, const Polynomial& multiplier, Polynomial& product);
+
+// quotient = dividend / divisor; remainder = dividend % divisor
+// provided that the degree of dividend >= the degree of divisor
+inline void division(const Polynomial& dividend, const Polynomial& divisor,
+    Polynomial& quotient, Polynomial& remainder);
+
+const int arraySize = 20;
+
+// term1 = term2
+inline void assign(Term& term1, const Term& term2)
+{
+    term1.coef = term2.coef;
+    term1.expon = term2.expon;
+}
+
+// polynomial = 0
+inline void reset(Polynomial& polynomial)
+{
+    polynomial.size = 0;
+    if (polynomial.terms != nullptr)
+    {
+        delete[] polynomial.terms;
+        polynomial.terms = nullptr;
+    }
+}
+
+// inputs a polynomial from the file Polynomials.dat
+inline void input(istream& inFile, Polynomial& polynomial)
+{
+    int numericString[arraySize] = {};
+
+    inFile.read(reinterpret_cast<char*>(numericString), 80);
+
+    polynomial.size = arraySize;
+    while (polynomial.size > 0 && numericString[polynomial.size - 1] == 0)
+        polynomial.size--;
+
+    polynomial.terms = new Term[polynomial.size];
+    for (int i = 0; i < polynomial.size; ++i)
+        polynomial.terms[i].coef = numericString[i];
+
+    inFile.read(reinterpret_cast<char*>(numericString), 80);
+
+    for (int i = 0; i < polynomial.size; ++i)
+        polynomial.terms[i].expon = numericString[i];
+}
+
+// outputs the specified polynomial
+inline void output(const Polynomial& polynomial)
+{
+    // the specified polynomial is zero polynomial
+    if (polynomial.size == 0)
+        cout << 0;
+    else
+    {
+        if (polynomial.terms[0].coef < 0)
+            cout << "-" << -polynomial.terms[0].coef;
+        else if (polynomial.terms[0].coef > 0)
+            cout << polynomial.terms[0].coef;
+
+        if (polynomial.terms[0].expon > 0)
+        {
+            if (polynomial.terms[0].expon == 1)
+                cout << "x";
+            else
+                cout << "x^" << polynomial.terms[0].expon;
+        }
+
+        for (int i = 1; i < polynomial.size; i++)
+        {
+            if (polynomial.terms[i].coef < 0)
+                cout << " - " << -polynomial.terms[i].coef;
+            else if (polynomial.terms[i].coef > 0)
+                cout << " + " << polynomial.terms[i].coef;
+
+            if (polynomial.terms[i].expon > 0)
+            {
+                if (polynomial.terms[i].expon == 1)
+                    cout << "x";
+                else
+                    cout << "x^" << polynomial.terms[i].expon;
+            }
+        }
+    }
+
+    cout << endl;
+}
+
+// returns true if and only if the specified polynomial has at least a zero term
+inline bool hasZeroTerm(const Polynomial& polynomial)
+{
+    if (polynomial.size != 0)
+        for (int i = 0; i < polynomial.size; i++)
+            if (polynomial.terms[i].coef == 0)
+                return true;
+
+    return false;
+}
+
+// returns true if and only if polynomial1 == polynomial2
+inline bool equal(const Polynomial& polynomial1, const Polynomial& polynomial2)
+{
+    if (polynomial1.size != polynomial2.size)
+        return false;
+
+    for (int i = 0; i < polynomial1.size; i++)
+        if (polynomial1.terms[i].coef != polynomial2.terms[i].coef ||
+            polynomial1.terms[i].expon != polynomial2.terms[i].expon)
+            return false;
+
+    return true;
+}
+
+// polynomial1 = -polynomial2
+inline void minus(Polynomial& polynomial1, const Polynomial& polynomial2)
+{
+    if (polynomial1.size != 0)
+        delete[] polynomial1.terms;
+    polynomial1.terms = new Term[polynomial2.size];
+
+    polynomial1.size = polynomial2.size;
+    for (int i = 0; i < polynomial1.size; i++)
+    {
+        polynomial1.terms[i].coef = -polynomial2.terms[i].coef;
+        polynomial1.terms[i].expon = polynomial2.terms[i].expon;
+    }
+}
+
+// addend += adder
+inline void addition(Polynomial& addend, const Polynomial adder)
+{
+    // like terms meet in the merged array and are combined there
+    Polynomial sum;
+    sum.terms = new Term[addend.size + adder.size];
+    int k = mergeAddition(addend.terms, addend.size, adder.terms, adder.size, sum.terms);
+
+    if (addend.size != k)
+    {
+        if (addend.size != 0)
+            delete[] addend.terms;
+        addend.terms = new Term[k];
+        addend.size = k;
+    }
+
+    for (int i = 0; i < addend.size; i++) // addend = sum
+        assign(addend.terms[i], sum.terms[i]);
+/*    for (int n = 0; n < k; n++)
+    {
+        addend.terms[n].expon = sum.terms[n].expon;
+        addend.terms[n].coef = sum.terms[n].coef;
+    }*/
+
+/*   for (int n = 0; n < addend.size; n++)
+        cout << addend.terms[n].expon << "  ";
+    cout << endl;
+    for (int n = 0; n < addend.size; n++)
+        cout << addend.terms[n].coef << "  ";
+    cout << endl;*/
+
+    delete[] sum.terms;
+
+    if (addend.size > 0 && addend.terms[0].coef == 0)
+        cout << "Leading zeroes in addend not allowed!\n";
+}
+
+// minuend -= subtrahend
+inline void subtraction(Polynomial& minuend, const Polynomial& subtrahend)
+{
+    Polynomial buffer;
+    buffer.size = subtrahend.size;
+    buffer.terms = new Term[buffer.size]();
+
+    // buffer = -subtrahend
+    minus(buffer, subtrahend);
+
+    // minuend = minuend + buffer = minuend - subtrahend
+    addition(minuend, buffer);
+
+    delete[] buffer.terms;
+
+    if (minuend.size > 0 && minuend.terms[0].coef == 0)
+        cout << "Leading zeroes in minuend not allowed!\n";
+}
+
+// product = multiplicand * multiplier
+inline void multiplication(const Polynomial& multiplicand, const Polynomial& multiplier, Polynomial& product)
+{
+    // product = 0;
+    reset(product);
+
+    // the multiplicand.size * multiplier.size products are merged by a heap or accumulated in a hash table,
+    // whichever suits the expected density of the product
+    int productCapacity = 0;
+    sparseMultiplication(termLayout(multiplicand.terms, multiplicand.size),
+        termLayout(multiplier.terms, multiplier.size),
+        [&](int coef, int expon) { appendTerm(product.terms, product.size, productCapacity, coef, expon); });
+
+    if (product.size > 0 && product.terms[0].coef == 0)
+        cout << "Leading zeroes in product not allowed!\n";
+}
+
+// quotient = dividend / divisor; remainder = dividend % divisor
+// provided that the degree of dividend >= the degree of divisor
+inline void division(const Polynomial& dividend, const Polynomial& divisor,
+    Polynomial& quotient, Polynomial& remainder)
+{
+    reset(quotient);
+    reset(remainder);
+
+    // the terms of dividend - divisor * quotient come out of a heap one at a time,
+    // so the remainder is written once instead of being rewritten for every quotient term
+    int quotientCapacity = 0;
+    int remainderCapacity = 0;
+    heapDivision(termLayout(dividend.terms, dividend.size), termLayout(divisor.terms, divisor.size),
+        [&](int coef, int expon) { appendTerm(quotient.terms, quotient.size, quotientCapacity, coef, expon); },
+        [&](int coef, int expon) { appendTerm(remainder.terms, remainder.size, remainderCapacity, coef, expon); });
+
+    if (quotient.size > 0 && quotient.terms[0].coef == 0)
+        cout << "Leading zeroes in quotient not allowed!\n";
+
+    if (remainder.size > 0 && remainder.terms[0].coef == 0)
+        cout << "Leading zeroes in remainder not allowed!\n";
+}
+
+} // end namespace hw82
+
+#endif
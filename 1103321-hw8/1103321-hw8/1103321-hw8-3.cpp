@@ -13,57 +13,10 @@ using std::istream;
 using std::ifstream;
 using std::ios;
 
-struct Term
-{
-    int coef = 0;  // the coefficient of a term
-    int expon = 0; // the exponent of a term
-};
-
-// term1 = term2
-void assign(Term& term1, Term& term2);
-
-// Polynomial class definition
-class Polynomial
-{
-public:
-    // polynomial = 0
-    void reset();
-
-    // inputs a polynomial from the file Polynomials.dat
-    void input(istream& inFile);
-
-    // outputs the specified polynomial
-    void output();
-
-    // returns true if and only if the specified polynomial has at least a zero term
-    bool hasZeroTerm();
-
-    // returns true if and only if polynomial1 == polynomial2
-    bool equal(Polynomial& polynomial2);
-
-    // polynomial1 = -polynomial2
-    void minus(Polynomial& polynomial2);
-
-    // addend += adder
-    void addition(Polynomial adder);
-
-    // minuend -= subtrahend
-    void subtraction(Polynomial& subtrahend);
-
-    // product = multiplicand * multiplier
-    void multiplication(Polynomial& multiplier, Polynomial& product);
-
-    // quotient = dividend / divisor; remainder = dividend % divisor
-    // provided that the degree of dividend >= the degree of divisor
-    void division(Polynomial& divisor, Polynomial& quotient, Polynomial& remainder);
-
-    int size = 0;          // the number of terms of the polynomial
-    Term* terms = nullptr; // all terms of the polynomial
-};
-
+#include "1103321-hw8-3.h"
+using namespace hw83;
 
 int numTestCases = 200; // the number of test cases
-const int arraySize = 20;
 
 int main()
 {
@@ -142,345 +95,3 @@ int main()
 
     system("pause");
 }
-
-// term1 = term2
-void assign(Term& term1, Term& term2)
-{
-    term1.coef = term2.coef;
-    term1.expon = term2.expon;
-}
-
-// polynomial = 0
-void Polynomial::reset()
-{
-    size = 0;
-    if (terms != nullptr)
-    {
-        delete[] terms;
-        terms = nullptr;
-    }
-}
-
-// inputs a polynomial from the file Polynomials.dat
-void Polynomial::input(istream& inFile)
-{
-    int numericString[arraySize] = {};
-
-    inFile.read(reinterpret_cast<char*>(numericString), 80);
-
-    size = arraySize;
-    while (size > 0 && numericString[size - 1] == 0)
-        size--;
-
-    terms = new Term[size];
-    for (int i = 0; i < size; ++i)
-        terms[i].coef = numericString[i];
-
-    inFile.read(reinterpret_cast<char*>(numericString), 80);
-
-    for (int i = 0; i < size; ++i)
-        terms[i].expon = numericString[i];
-}
-
-// outputs the specified polynomial
-void Polynomial::output()
-{
-    // the specified polynomial is zero polynomial
-    if (size == 0)
-        cout << 0;
-    else
-    {
-        if (terms[0].coef < 0)
-            cout << "-" << -terms[0].coef;
-        else if (terms[0].coef > 0)
-            cout << terms[0].coef;
-
-        if (terms[0].expon > 0)
-        {
-            if (terms[0].expon == 1)
-                cout << "x";
-            else
-                cout << "x^" << terms[0].expon;
-        }
-
-        for (int i = 1; i < size; i++)
-        {
-            if (terms[i].coef < 0)
-                cout << " - " << -terms[i].coef;
-            else if (terms[i].coef > 0)
-                cout << " + " << terms[i].coef;
-
-            if (terms[i].expon > 0)
-            {
-                if (terms[i].expon == 1)
-                    cout << "x";
-                else
-                    cout << "x^" << terms[i].expon;
-            }
-        }
-    }
-
-    cout << endl;
-}
-
-// returns true if and only if the specified polynomial has at least a zero term
-bool Polynomial::hasZeroTerm()
-{
-    if (size != 0)
-        for (int i = 0; i < size; i++)
-            if (terms[i].coef == 0)
-                return true;
-
-    return false;
-}
-
-// returns true if and only if polynomial1 == polynomial2
-bool Polynomial::equal(Polynomial& polynomial2)
-{
-    if (size != polynomial2.size)
-        return false;
-
-    for (int i = 0; i < size; i++)
-        if (terms[i].coef != polynomial2.terms[i].coef ||
-            terms[i].expon != polynomial2.terms[i].expon)
-            return false;
-
-    return true;
-}
-
-// polynomial1 = -polynomial2
-void Polynomial::minus(Polynomial& polynomial2)
-{
-    if (size != 0)
-        delete[] terms;
-    terms = new Term[polynomial2.size];
-
-    size = polynomial2.size;
-    for (int i = 0; i < size; i++)
-    {
-        terms[i].coef = -polynomial2.terms[i].coef;
-        terms[i].expon = polynomial2.terms[i].expon;
-    }
-}
-
-// addend += adder
-void Polynomial::addition(Polynomial adder)
-{
-    Polynomial sum;
-    sum.terms = new Term[arraySize];
-    int i = 0;
-    int j = 0;
-    int k = 0;
-
-/*    for (int n = 0; n < size; n++)
-        cout << terms[n].expon << "  ";
-    cout << endl;
-    for (int n = 0; n < size; n++)
-        cout << terms[n].coef << "  ";
-    cout << endl;
-
-    for (int n = 0; n < adder.size; n++)
-        cout << adder.terms[n].expon << "  ";
-    cout << endl;
-    for (int n = 0; n < adder.size; n++)
-        cout << adder.terms[n].coef << "  ";
-    cout << endl;*/
-
-    if (size == 0)
-        for (; k < adder.size; k++)
-            assign(sum.terms[k], adder.terms[k]);
-    else if (adder.size == 0)
-        for (; k < size; k++)
-            assign(sum.terms[k], terms[k]);
-    else
-    {
-        while (1)
-        {
-            if (i == size && j == adder.size)
-                break;
-            if (i == size)
-            {
-                for (; j < adder.size; j++)
-                {
-                    assign(sum.terms[k], adder.terms[j]);
-                    k++;
-                }
-                break;
-            }
-            if (j == adder.size)
-            {
-                for (; i < size; i++)
-                {
-                    assign(sum.terms[k], terms[i]);
-                    k++;
-                }
-                break;
-            }
-
-            if (terms[i].expon > adder.terms[j].expon)
-            {
-                assign(sum.terms[k], terms[i]);
-                i++; k++;
-            }
-            else if (terms[i].expon < adder.terms[j].expon)
-            {
-                assign(sum.terms[k], adder.terms[j]);
-                j++; k++;
-            }
-            else
-            {
-                if (terms[i].coef + adder.terms[j].coef == 0)
-                {
-                    i++; j++;
-                    continue;
-                }
-                sum.terms[k].expon = terms[i].expon;
-                sum.terms[k].coef = terms[i].coef + adder.terms[j].coef;
-                i++; j++; k++;
-            }
-        }
-    }
-    
-
-
-    if (size != k)
-    {
-        if (size != 0)
-            delete[] terms;
-        terms = new Term[k];
-        size = k;
-    }
-
-    for (int i = 0; i < size; i++) // addend = sum
-        assign(terms[i], sum.terms[i]);
-
-    delete[] sum.terms;
-}
-
-// minuend -= subtrahend
-void Polynomial::subtraction(Polynomial& subtrahend)
-{
-    Polynomial buffer;
-    buffer.size = subtrahend.size;
-    buffer.terms = new Term[buffer.size]();
-
-    // buffer = -subtrahend
-    buffer.minus(subtrahend);
-
-    // minuend = minuend + buffer = minuend - subtrahend
-    addition(buffer);
-
-    delete[] buffer.terms;
-
-    if (size > 0 && terms[0].coef == 0)
-        cout << "Leading zeroes in minuend not allowed!\n";
-}
-
-// product = multiplicand * multiplier
-void Polynomial::multiplication(Polynomial& multiplier, Polynomial& product)
-{
-    // product = 0;
-    if (product.size != 0)
-    {
-        product.size = 0;
-        delete[] product.terms;
-    }
-
-    Polynomial buffer;
-    buffer.size = size;
-    buffer.terms = new Term[size]();
-
-/*    for (int n = 0; n < size; n++)
-        cout << terms[n].expon << "  ";
-    cout << endl;
-    for (int n = 0; n < size; n++)
-        cout << terms[n].coef << "  ";
-    cout << endl;
-
-    for (int n = 0; n < multiplier.size; n++)
-        cout << multiplier.terms[n].expon << "  ";
-    cout << endl;
-    for (int n = 0; n <  multiplier.size; n++)
-        cout << multiplier.terms[n].coef << "  ";
-    cout << endl;*/
-
-    // if( multiplicand != 0 && multiplier != 0 )
-    if (size != 0 && multiplier.size != 0)
-    {
-        for (int j = 0; j < multiplier.size; j++)
-        {
-            for (int i = 0; i < size; i++)
-            {
-                buffer.terms[i].expon = terms[i].expon + multiplier.terms[j].expon;
-                buffer.terms[i].coef = terms[i].coef * multiplier.terms[j].coef;
-            }
-            product.addition(buffer);
-        }
-    }
-    delete buffer.terms;
-
-
-    if (product.size > 0 && product.terms[0].coef == 0)
-        cout << "Leading zeroes in product not allowed!\n";
-}
-
-// quotient = dividend / divisor; remainder = dividend % divisor
-// provided that the degree of dividend >= the degree of divisor
-void Polynomial::division(Polynomial& divisor, Polynomial& quotient, Polynomial& remainder)
-{
-    // remainder = dividend
-    remainder.size = size;
-    remainder.terms = new Term[remainder.size]();
-    for (int i = 0; i < remainder.size; i++)
-        assign(remainder.terms[i], terms[i]);
-
-    Polynomial monomial;
-    monomial.size = 1;
-    monomial.terms = new Term[1]();
-
-    Polynomial buffer;
-
-    Polynomial temp;
-    temp.size = arraySize;
-    temp.terms = new Term[arraySize]();
-
-    if (quotient.size != 0)
-        delete[] quotient.terms;
-    quotient.size = 0;
-
-    while (remainder.size != 0 && remainder.terms[0].expon >= divisor.terms[0].expon)
-    {
-        temp.terms[quotient.size].expon = remainder.terms[0].expon - divisor.terms[0].expon;
-        temp.terms[quotient.size].coef = remainder.terms[0].coef / divisor.terms[0].coef;
-
-        monomial.terms[0].expon = temp.terms[quotient.size].expon;
-        monomial.terms[0].coef = temp.terms[quotient.size].coef;
-
-        divisor.multiplication(monomial,buffer);
-
-/*        for (int n = 0; n < buffer.size; n++)
-            cout << buffer.terms[n].expon << "  ";
-        cout << endl;
-        for (int n = 0; n < buffer.size; n++)
-            cout << buffer.terms[n].coef << "  ";
-        cout << endl;*/
-
-        remainder.subtraction(buffer);
-        quotient.size++;
-    }
-
-
-    quotient.terms = new Term[quotient.size];
-    for (int i = 0; i < quotient.size; ++i)
-        assign(quotient.terms[i], temp.terms[i]);
-
-    delete[] monomial.terms;
-    delete[] buffer.terms;
-    delete[] temp.terms;
-
-    if (quotient.size > 0 && quotient.terms[0].coef == 0)
-        cout << "Leading zeroes in quotient not allowed!\n";
-
-    if (remainder.size > 0 && remainder.terms[0].coef == 0)
-        cout << "Leading zeroes in remainder not allowed!\n";
-}
\ No newline at end of file
@@ -0,0 +1,457 @@
+// 1103321-hw8-3.h
+// The Polynomial class of hw8-3, in namespace hw83.
+//
+// A polynomial owns its terms and keeps short ones in the object itself. Used by
+// 1103321-hw8-3.cpp and by PolynomialBenchmark.
+
+#ifndef HW8_3_H
+#define HW8_3_H
+
+#include <iostream>
+#include <fstream>
+#include <utility>
+
+#include "../../polynomial/SparseMultiplication.h"
+#include "../../polynomial/HeapDivision.h"
+
+namespace hw83
+{
+
+using std::cout;
+using std::endl;
+using std::istream;
+using std::move;
+
+struct Term
+{
+    int coef = 0;  // the coefficient of a term
+    int expon = 0; // the exponent of a term
+};
+
+// term1 = term2
+inline void assign(Term& term1, const Term& term2);
+
+// the number of terms a polynomial holds without allocating
+const int numInlineTerms = 8;
+
+// Polynomial class definition;
+// a polynomial owns its terms, and its storage is kept and reused until it is destroyed;
+// the first numInlineTerms terms are stored in the object itself
+class Polynomial
+{
+public:
+    Polynomial() = default;
+
+    // copies the terms of polynomial2
+    Polynomial(const Polynomial& polynomial2);
+
+    // takes the storage of polynomial2 ( or copies its inline terms ), which becomes zero
+    Polynomial(Polynomial&& polynomial2) noexcept;
+
+    ~Polynomial();
+
+    // copies the terms of polynomial2 into the storage of this polynomial
+    Polynomial& operator=(const Polynomial& polynomial2);
+
+    // takes the storage of polynomial2 ( or copies its inline terms ), which becomes zero
+    Polynomial& operator=(Polynomial&& polynomial2) noexcept;
+
+    // polynomial = 0; the storage is kept for reuse
+    void reset();
+
+    // appends a term whose exponent is smaller than those of all terms of the polynomial
+    void append(int coef, int expon);
+
+    // inputs a polynomial from the file Polynomials.dat
+    void input(istream& inFile);
+
+    // outputs the specified polynomial
+    void output() const;
+
+    // returns true if and only if the specified polynomial has at least a zero term
+    bool hasZeroTerm() const;
+
+    // returns true if and only if polynomial1 == polynomial2
+    bool equal(const Polynomial& polynomial2) const;
+
+    // polynomial1 = -polynomial2
+    void minus(const Polynomial& polynomial2);
+
+    // addend += adder
+    void addition(const Polynomial& adder);
+
+    // addend += adder, taking the storage of adder when addend is zero
+    void addition(Polynomial&& adder);
+
+    // minuend -= subtrahend
+    void subtraction(const Polynomial& subtrahend);
+
+    // product = multiplicand * multiplier
+    void multiplication(const Polynomial& multiplier, Polynomial& product) const;
+
+    // quotient = dividend / divisor; remainder = dividend % divisor
+    // provided that the degree of dividend >= the degree of divisor
+    void division(const Polynomial& divisor, Polynomial& quotient, Polynomial& remainder) const;
+
+private:
+    // makes room for numTerms terms, keeping the current ones
+    void reserve(int numTerms);
+
+    // addend += sign * adder, merging backward in place
+    void merge(const Polynomial& adder, int sign);
+
+    Term inlineTerms[numInlineTerms]; // the storage of a short polynomial
+    int size = 0;                     // the number of terms of the polynomial
+    int capacity = numInlineTerms;    // the number of terms the storage can hold
+    Term* terms = inlineTerms;        // all terms of the polynomial
+};
+
+const int arraySize = 20;
+
+// term1 = term2
+inline void assign(Term& term1, const Term& term2)
+{
+    term1.coef = term2.coef;
+    term1.expon = term2.expon;
+}
+
+// copies the terms of polynomial2
+inline Polynomial::Polynomial(const Polynomial& polynomial2)
+{
+    *this = polynomial2;
+}
+
+// takes the storage of polynomial2 ( or copies its inline terms ), which becomes zero
+inline Polynomial::Polynomial(Polynomial&& polynomial2) noexcept
+{
+    *this = move(polynomial2);
+}
+
+inline Polynomial::~Polynomial()
+{
+    if (terms != inlineTerms)
+        delete[] terms;
+}
+
+// copies the terms of polynomial2 into the storage of this polynomial
+inline Polynomial& Polynomial::operator=(const Polynomial& polynomial2)
+{
+    if (this != &polynomial2)
+    {
+        size = 0;
+        reserve(polynomial2.size);
+
+        size = polynomial2.size;
+        for (int i = 0; i < size; i++)
+            assign(terms[i], polynomial2.terms[i]);
+    }
+
+    return *this;
+}
+
+// takes the storage of polynomial2 ( or copies its inline terms ), which becomes zero
+inline Polynomial& Polynomial::operator=(Polynomial&& polynomial2) noexcept
+{
+    if (this == &polynomial2)
+        return *this;
+
+    // inline terms fit in the storage of this polynomial, so they are copied without allocating
+    if (polynomial2.terms == polynomial2.inlineTerms)
+    {
+        size = polynomial2.size;
+        for (int i = 0; i < size; i++)
+            assign(terms[i], polynomial2.terms[i]);
+    }
+    else
+    {
+        if (terms != inlineTerms)
+            delete[] terms;
+
+        size = polynomial2.size;
+        capacity = polynomial2.capacity;
+        terms = polynomial2.terms;
+
+        polynomial2.capacity = numInlineTerms;
+        polynomial2.terms = polynomial2.inlineTerms;
+    }
+
+    polynomial2.size = 0;
+    return *this;
+}
+
+// polynomial = 0; the storage is kept for reuse
+inline void Polynomial::reset()
+{
+    size = 0;
+}
+
+// makes room for numTerms terms, keeping the current ones
+inline void Polynomial::reserve(int numTerms)
+{
+    if (numTerms <= capacity)
+        return;
+
+    int newCapacity = 2 * capacity;
+    if (newCapacity < numTerms)
+        newCapacity = numTerms;
+
+    Term* newTerms = new Term[newCapacity];
+    for (int i = 0; i < size; i++)
+        assign(newTerms[i], terms[i]);
+
+    if (terms != inlineTerms)
+        delete[] terms;
+    terms = newTerms;
+    capacity = newCapacity;
+}
+
+// appends a term whose exponent is smaller than those of all terms of the polynomial
+inline void Polynomial::append(int coef, int expon)
+{
+    if (size == capacity)
+        reserve(size + 1);
+
+    terms[size].coef = coef;
+    terms[size].expon = expon;
+    size++;
+}
+
+// inputs a polynomial from the file Polynomials.dat
+inline void Polynomial::input(istream& inFile)
+{
+    int numericString[arraySize] = {};
+
+    inFile.read(reinterpret_cast<char*>(numericString), 80);
+
+    int numTerms = arraySize;
+    while (numTerms > 0 && numericString[numTerms - 1] == 0)
+        numTerms--;
+
+    size = 0;
+    reserve(numTerms);
+
+    size = numTerms;
+    for (int i = 0; i < size; ++i)
+        terms[i].coef = numericString[i];
+
+    inFile.read(reinterpret_cast<char*>(numericString), 80);
+
+    for (int i = 0; i < size; ++i)
+        terms[i].expon = numericString[i];
+}
+
+// outputs the specified polynomial
+inline void Polynomial::output() const
+{
+    // the specified polynomial is zero polynomial
+    if (size == 0)
+        cout << 0;
+    else
+    {
+        if (terms[0].coef < 0)
+            cout << "-" << -terms[0].coef;
+        else if (terms[0].coef > 0)
+            cout << terms[0].coef;
+
+        if (terms[0].expon > 0)
+        {
+            if (terms[0].expon == 1)
+                cout << "x";
+            else
+                cout << "x^" << terms[0].expon;
+        }
+
+        for (int i = 1; i < size; i++)
+        {
+            if (terms[i].coef < 0)
+                cout << " - " << -terms[i].coef;
+            else if (terms[i].coef > 0)
+                cout << " + " << terms[i].coef;
+
+            if (terms[i].expon > 0)
+            {
+                if (terms[i].expon == 1)
+                    cout << "x";
+                else
+                    cout << "x^" << terms[i].expon;
+            }
+        }
+    }
+
+    cout << endl;
+}
+
+// returns true if and only if the specified polynomial has at least a zero term
+inline bool Polynomial::hasZeroTerm() const
+{
+    if (size != 0)
+        for (int i = 0; i < size; i++)
+            if (terms[i].coef == 0)
+                return true;
+
+    return false;
+}
+
+// returns true if and only if polynomial1 == polynomial2
+inline bool Polynomial::equal(const Polynomial& polynomial2) const
+{
+    if (size != polynomial2.size)
+        return false;
+
+    for (int i = 0; i < size; i++)
+        if (terms[i].coef != polynomial2.terms[i].coef ||
+            terms[i].expon != polynomial2.terms[i].expon)
+            return false;
+
+    return true;
+}
+
+// polynomial1 = -polynomial2
+inline void Polynomial::minus(const Polynomial& polynomial2)
+{
+    *this = polynomial2;
+    for (int i = 0; i < size; i++)
+        terms[i].coef = -terms[i].coef;
+}
+
+// addend += sign * adder, merging backward in place
+inline void Polynomial::merge(const Polynomial& adder, int sign)
+{
+    // a polynomial added to itself would be overwritten while it is read
+    if (&adder == this)
+    {
+        Polynomial copy(adder);
+        merge(copy, sign);
+        return;
+    }
+
+    // the sum has at most size + adder.size terms
+    reserve(size + adder.size);
+
+    int i = size - 1;       // addend
+    int j = adder.size - 1; // adder
+    int k = size + adder.size; // sum, filled from the back
+
+    // terms are stored in descending order of exponents, so the back holds the smallest ones;
+    // k > i + j + 1 always holds, thus no unread term of addend is overwritten
+    while (j >= 0)
+    {
+        if (i >= 0 && terms[i].expon < adder.terms[j].expon)
+        {
+            k--;
+            assign(terms[k], terms[i]);
+            i--;
+        }
+        else if (i >= 0 && terms[i].expon == adder.terms[j].expon)
+        {
+            int coefficient = terms[i].coef + sign * adder.terms[j].coef;
+            if (coefficient != 0)
+            {
+                k--;
+                terms[k].coef = coefficient;
+                terms[k].expon = terms[i].expon;
+            }
+            i--;
+            j--;
+        }
+        else
+        {
+            k--;
+            terms[k].coef = sign * adder.terms[j].coef;
+            terms[k].expon = adder.terms[j].expon;
+            j--;
+        }
+    }
+
+    // terms[ 0 .. i ] are already in place; close the gap left by cancelled terms
+    int numMerged = size + adder.size - k;
+    if (k != i + 1)
+        for (int n = 0; n < numMerged; n++)
+            assign(terms[i + 1 + n], terms[k + n]);
+
+    size = i + 1 + numMerged;
+}
+
+// addend += adder
+inline void Polynomial::addition(const Polynomial& adder)
+{
+    merge(adder, 1);
+}
+
+// addend += adder, taking the storage of adder when addend is zero
+inline void Polynomial::addition(Polynomial&& adder)
+{
+    if (size == 0)
+        *this = move(adder);
+    else
+        merge(adder, 1);
+}
+
+// minuend -= subtrahend
+inline void Polynomial::subtraction(const Polynomial& subtrahend)
+{
+    merge(subtrahend, -1);
+
+    if (size > 0 && terms[0].coef == 0)
+        cout << "Leading zeroes in minuend not allowed!\n";
+}
+
+// product = multiplicand * multiplier
+inline void Polynomial::multiplication(const Polynomial& multiplier, Polynomial& product) const
+{
+    // the product is written while the operands are read, so it must be another polynomial
+    if (&product == this || &product == &multiplier)
+    {
+        Polynomial temporary;
+        multiplication(multiplier, temporary);
+        product = move(temporary);
+        return;
+    }
+
+    // product = 0;
+    product.reset();
+
+    // the size * multiplier.size products are merged by a heap or accumulated in a hash table,
+    // whichever suits the expected density of the product
+    sparseMultiplication(termLayout(terms, size), termLayout(multiplier.terms, multiplier.size),
+        [&](int coef, int expon) { product.append(coef, expon); });
+
+    if (product.size > 0 && product.terms[0].coef == 0)
+        cout << "Leading zeroes in product not allowed!\n";
+}
+
+// quotient = dividend / divisor; remainder = dividend % divisor
+// provided that the degree of dividend >= the degree of divisor
+inline void Polynomial::division(const Polynomial& divisor, Polynomial& quotient, Polynomial& remainder) const
+{
+    // the quotient and remainder are written while the operands are read
+    if (&quotient == this || &quotient == &divisor || &remainder == this || &remainder == &divisor)
+    {
+        Polynomial temporaryQuotient;
+        Polynomial temporaryRemainder;
+        division(divisor, temporaryQuotient, temporaryRemainder);
+        quotient = move(temporaryQuotient);
+        remainder = move(temporaryRemainder);
+        return;
+    }
+
+    quotient.reset();
+    remainder.reset();
+
+    // the terms of dividend - divisor * quotient come out of a heap one at a time,
+    // so the remainder is written once instead of being rewritten for every quotient term;
+    // quotient and remainder grow in the storage they already own
+    heapDivision(termLayout(terms, size), termLayout(divisor.terms, divisor.size),
+        [&](int coef, int expon) { quotient.append(coef, expon); },
+        [&](int coef, int expon) { remainder.append(coef, expon); });
+
+    if (quotient.size > 0 && quotient.terms[0].coef == 0)
+        cout << "Leading zeroes in quotient not allowed!\n";
+
+    if (remainder.size > 0 && remainder.terms[0].coef == 0)
+        cout << "Leading zeroes in remainder not allowed!\n";
+}
+
+} // end namespace hw83
+
+#endif
@@ -16,46 +16,10 @@ using std::ios;
 #include <vector>
 using std::vector;
 
-struct Term
-{
-    int coef = 0;  // the coefficient of a term
-    int expon = 0; // the exponent of a term
-};
-
-// term1 =m term2
-void assign(Term& term1, const Term& term2);
-
-// enable user to input a polynomial
-void input(istream& inFile, vector< Term >& polynomial);
-
-// outputs the specified polynomial
-void output(const vector< Term >& polynomial);
-
-// returns true if and only if the specified polynomial has at least a zero term
-bool hasZeroTerm(const vector< Term >& polynomial);
-
-// returns true if and only if polynomial1 == polynomial2
-bool equal(const vector< Term >& polynomial1, const vector< Term >& polynomial2);
-
-// polynomial1 = -polynomial2
-void minus(vector< Term >& polynomial1, const vector< Term >& polynomial2);
-
-// addend += adder
-void addition(vector< Term >& addend, const vector< Term > adder);
-
-// minuend -= subtrahend
-void subtraction(vector< Term >& minuend, const vector< Term >& subtrahend);
-
-// product = multiplicand * multiplier
-void multiplication(const vector< Term >& multiplicand, const vector< Term >& multiplier, vector< Term >& product);
-
-// quotient = dividend / divisor; remainder = dividend % divisor
-// provided that dividendExpon[ dividendSize - 1 ] >= divisorExpon[ divisorSize - 1 ]
-void division(const vector< Term >& dividend, const vector< Term >& divisor,
-    vector< Term >& quotient, vector< Term >& remainder);
+#include "1103321-hw8-4.h"
+using namespace hw84;
 
 const int numTestCases = 200; // the number of test cases
-const int arraySize = 20;
 
 int main()
 {
@@ -69,11 +33,13 @@ int main()
         exit(1);
     }
 
-    vector< Term > dividend;
-    vector< Term > divisor;
-    vector< Term > quotient;
-    vector< Term > remainder;
-    vector< Term > buffer;
+    Arena arena;
+    ArenaAllocator< Term > allocator(arena);
+
+    Polynomial dividend(allocator);
+    Polynomial divisor(allocator);
+    Polynomial quotient(allocator);
+    Polynomial remainder(allocator);
 
     int numErrors = numTestCases;
     for (int i = 0; i < numTestCases; i++)
@@ -101,25 +67,20 @@ int main()
         if (hasZeroTerm(quotient))
             cout << "quotient has at least a zero term!\n";
         else
-        {
-            // buffer = divisor * quotient
-            multiplication(divisor, quotient, buffer);
+            // the terms of divisor * quotient + remainder are produced one at a time and compared
+            // with dividend as they come, without building divisor * quotient;
+            // if they differ, an error occurred!
+            if (divisor * quotient + remainder == dividend)
+                numErrors--;
 
-            if (hasZeroTerm(buffer))
-                cout << "buffer has at least a zero term!\n";
-            else
-            {
-                // buffer = buffer + remainder = divisor * quotient + remainder
-                addition(buffer, remainder);
+        release(dividend);
+        release(divisor);
 
-                if (hasZeroTerm(buffer))
-                    cout << "buffer has at least a zero term!\n";
-                else
-                    // if buffer != dividend, an error occurred!
-                    if (equal(buffer, dividend))
-                        numErrors--;
-            }
-        }
+        release(quotient);
+        release(remainder);
+
+        // all terms of this test case are freed at once
+        arena.reset();
     }
 
     inFile.close();
@@ -128,276 +89,3 @@ int main()
 
     system("pause");
 }
-
-void assign(Term& term1, const Term& term2)
-{
-    term1.coef = term2.coef;
-    term1.expon = term2.expon;
-}
-
-// enable user to input a polynomial
-void input(istream& inFile, vector< Term >& polynomial)
-{
-    int numericString[arraySize] = {};
-
-    inFile.read(reinterpret_cast<char*>(numericString), 80);
-
-    int size = arraySize;
-    while (size > 0 && numericString[size - 1] == 0)
-        size--;
-
-    polynomial.resize(size);
-    for (size_t i = 0; i < polynomial.size(); ++i)
-        polynomial[i].coef = numericString[i];
-
-    inFile.read(reinterpret_cast<char*>(numericString), 80);
-
-    for (size_t i = 0; i < polynomial.size(); ++i)
-        polynomial[i].expon = numericString[i];
-}
-
-// outputs the specified polynomial
-void output(const vector< Term >& polynomial)
-{
-    // the specified polynomial is zero polynomial
-    if (polynomial.size() == 0)
-        cout << 0;
-    else
-    {
-        if (polynomial[0].coef < 0)
-            cout << "-" << -polynomial[0].coef;
-        else if (polynomial[0].coef > 0)
-            cout << polynomial[0].coef;
-
-        if (polynomial[0].expon > 0)
-        {
-            if (polynomial[0].expon == 1)
-                cout << "x";
-            else
-                cout << "x^" << polynomial[0].expon;
-        }
-
-        for (size_t i = 1; i < polynomial.size(); i++)
-        {
-            if (polynomial[i].coef < 0)
-                cout << " - " << -polynomial[i].coef;
-            else if (polynomial[i].coef > 0)
-                cout << " + " << polynomial[i].coef;
-
-            if (polynomial[i].expon > 0)
-            {
-                if (polynomial[i].expon == 1)
-                    cout << "x";
-                else
-                    cout << "x^" << polynomial[i].expon;
-            }
-        }
-    }
-
-    cout << endl;
-}
-
-// returns true if and only if the specified polynomial has at least a zero term
-bool hasZeroTerm(const vector< Term >& polynomial)
-{
-    if (polynomial.size() != 0)
-        for (size_t i = 0; i < polynomial.size(); i++)
-            if (polynomial[i].coef == 0)
-                return true;
-
-    return false;
-}
-
-// returns true if and only if polynomial1 == polynomial2
-bool equal(const vector< Term >& polynomial1, const vector< Term >& polynomial2)
-{
-    if (polynomial1.size() != polynomial2.size())
-        return false;
-
-    for (size_t i = 0; i < polynomial1.size(); i++)
-        if (polynomial1[i].coef != polynomial2[i].coef ||
-            polynomial1[i].expon != polynomial2[i].expon)
-            return false;
-
-    return true;
-}
-
-// polynomial1 = -polynomial2
-void minus(vector< Term >& polynomial1, const vector< Term >& polynomial2)
-{
-    polynomial1.resize(polynomial2.size());
-    for (size_t i = 0; i < polynomial1.size(); i++)
-    {
-        polynomial1[i].coef = -polynomial2[i].coef;
-        polynomial1[i].expon = polynomial2[i].expon;
-    }
-}
-
-// addend += adder
-void addition(vector< Term >& addend, const vector< Term > adder)
-{
-    vector< Term > sum(arraySize);
-    size_t i = 0;
-    size_t j = 0;
-    size_t k = 0;
-
-    if (addend.size() == 0)
-    {
-        for (; k < adder.size(); k++)
-            assign(sum[k], adder[k]);
-    }
-    else if (adder.size() == 0)
-    {
-        for (; k < addend.size(); k++)
-            assign(sum[k], addend[k]);
-    }
-    else
-    {
-        while (1)
-        {
-            if (i == addend.size() && j == adder.size())
-                break;
-            if (i == addend.size())
-            {
-                for (; j < adder.size(); j++)
-                {
-                    assign(sum[k], adder[j]);
-                    k++;
-                }
-                break;
-            }
-            if (j == adder.size())
-            {
-                for (; i < addend.size(); i++)
-                {
-                    assign(sum[k], addend[i]);
-                    k++;
-                }
-                break;
-            }
-            if (addend[i].expon > adder[j].expon)
-            {
-                assign(sum[k], addend[i]);
-                i++; k++;
-            }
-            else if (addend[i].expon < adder[j].expon)
-            {
-                assign(sum[k], adder[j]);
-                j++; k++;
-            }
-            else
-            {
-                if (addend[i].coef + adder[j].coef == 0)
-                {
-                    i++; j++;
-                    continue;
-                }
-                sum[k].coef = addend[i].coef + adder[j].coef;
-                sum[k].expon = addend[i].expon;
-                i++; j++; k++;
-            }
-        }
-    }
-
-/*    for (int n = 0; n < sum.size(); n++)
-        cout << sum[n].expon << "  ";
-    cout << endl;
-    for (int n = 0; n < sum.size(); n++)
-        cout << sum[n].coef << "  ";
-    cout << endl;*/
-
-    if (addend.size() != k)
-        addend.resize(k);
-
-    for (size_t i = 0; i < addend.size(); i++) // addend = sum
-        assign(addend[i], sum[i]);
-}
-
-// minuend -= subtrahend
-void subtraction(vector< Term >& minuend, const vector< Term >& subtrahend)
-{
-    // buffer = 0
-    vector< Term > buffer(subtrahend.size());
-
-    // buffer = -subtrahend
-    minus(buffer, subtrahend);
-
-    // minuend = minuend + buffer = minuend - subtrahend
-    addition(minuend, buffer);
-
-    if (minuend.size() > 0 && minuend[0].coef == 0)
-        cout << "Leading zeroes in minuend not allowed!\n";
-}
-
-// product = multiplicand * multiplier
-void multiplication(const vector< Term >& multiplicand, const vector< Term >& multiplier, vector< Term >& product)
-{
-    // product = 0;
-    product.clear();
-
-    vector< Term > buffer(multiplicand.size());
-
-    // if( multiplicand != 0 && multiplier != 0 )
-    if (multiplicand.size() != 0 && multiplier.size() != 0)
-    {
-        for (int j = 0; j < multiplier.size(); j++) 
-        {
-            for (int i = 0; i < multiplicand.size(); i++) 
-            {
-                buffer[i].expon = multiplicand[i].expon + multiplier[j].expon;
-                buffer[i].coef = multiplicand[i].coef * multiplier[j].coef;
-            }
-            addition(product,buffer);
-        }
-    }
-
-    if (product.size() > 0 && product[0].coef == 0)
-        cout << "Leading zeroes in product not allowed!\n";
-}
-
-// quotient = dividend / divisor; remainder = dividend % divisor
-// provided that dividendExpon[ dividendSize - 1 ] >= divisorExpon[ divisorSize - 1 ]
-void division(const vector< Term >& dividend, const vector< Term >& divisor,
-    vector< Term >& quotient, vector< Term >& remainder)
-{
-    remainder = dividend;
-    quotient.clear();
-    int quotientSize = 0;
-
-    vector<Term> temp(arraySize);
-    
-    vector<Term> monomial(1);
-
-    vector<Term> buffer(arraySize);
-
-    while (remainder.size() != 0 && remainder[0].expon >= divisor[0].expon)
-    {
-        temp[quotientSize].expon = remainder[0].expon - divisor[0].expon;
-        temp[quotientSize].coef = remainder[0].coef / divisor[0].coef;
-
-/*        cout << temp[quotientSize].expon << endl;
-        cout << temp[quotientSize].coef << endl;*/
-
-        monomial[0].expon = temp[quotientSize].expon;
-        monomial[0].coef = temp[quotientSize].coef;
-
-        multiplication(divisor, monomial, buffer);
-
-        subtraction(remainder, buffer);
-        
-        quotientSize++;
-    }
-
-    for (int i = arraySize - 1; i > 0; i--)
-    {
-        if (temp[i].coef == 0)
-            temp.pop_back();
-    }
-    quotient = temp;
-
-    if (quotient.size() > 0 && quotient[0].coef == 0)
-        cout << "Leading zeroes in quotient not allowed!\n";
-
-    if (remainder.size() > 0 && remainder[0].coef == 0)
-        cout << "Leading zeroes in remainder not allowed!\n";
-}
\ No newline at end of file
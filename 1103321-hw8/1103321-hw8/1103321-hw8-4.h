@@ -0,0 +1,290 @@
+// 1103321-hw8-4.h
+// The polynomials of hw8-4 and their arithmetic, in namespace hw84.
+//
+// A polynomial is a vector of terms; the functions take any allocator, so the driver keeps its
+// temporaries in an arena. Used by 1103321-hw8-4.cpp and by PolynomialBenchmark.
+
+#ifndef HW8_4_H
+#define HW8_4_H
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+#include "../../polynomial/SparseMultiplication.h"
+#include "../../polynomial/HeapDivision.h"
+#include "../../polynomial/MergeAddition.h"
+#include "../../polynomial/Arena.h"
+#include "../../polynomial/PolynomialExpression.h"
+
+namespace hw84
+{
+
+using std::cout;
+using std::endl;
+using std::istream;
+using std::vector;
+
+struct Term
+{
+    int coef = 0;  // the coefficient of a term
+    int expon = 0; // the exponent of a term
+};
+
+// term1 =m term2
+inline void assign(Term& term1, const Term& term2);
+
+// the polynomials of a test case; their storage comes from an arena released after every case
+typedef vector< Term, ArenaAllocator< Term > > Polynomial;
+
+// polynomial = 0, giving its storage back to the allocator
+template< typename Allocator >
+void release(vector< Term, Allocator >& polynomial);
+
+// enable user to input a polynomial
+template< typename Allocator >
+void input(istream& inFile, vector< Term, Allocator >& polynomial);
+
+// outputs the specified polynomial
+template< typename Allocator >
+void output(const vector< Term, Allocator >& polynomial);
+
+// returns true if and only if the specified polynomial has at least a zero term
+template< typename Allocator >
+bool hasZeroTerm(const vector< Term, Allocator >& polynomial);
+
+// returns true if and only if polynomial1 == polynomial2
+template< typename Allocator >
+bool equal(const vector< Term, Allocator >& polynomial1, const vector< Term, Allocator >& polynomial2);
+
+// polynomial1 = -polynomial2
+template< typename Allocator >
+void minus(vector< Term, Allocator >& polynomial1, const vector< Term, Allocator >& polynomial2);
+
+// addend += adder
+template< typename Allocator >
+void addition(vector< Term, Allocator >& addend, const vector< Term, Allocator >& adder);
+
+// minuend -= subtrahend
+template< typename Allocator >
+void subtraction(vector< Term, Allocator >& minuend, const vector< Term, Allocator >& subtrahend);
+
+// product = multiplicand * multiplier
+template< typename Allocator >
+void multiplication(const vector< Term, Allocator >& multiplicand, const vector< Term, Allocator >& multiplier, vector< Term, Allocator >& product);
+
+// quotient = dividend / divisor; remainder = dividend % divisor
+// provided that dividendExpon[ dividendSize - 1 ] >= divisorExpon[ divisorSize - 1 ]
+template< typename Allocator >
+void division(const vector< Term, Allocator >& dividend, const vector< Term, Allocator >& divisor,
+    vector< Term, Allocator >& quotient, vector< Term, Allocator >& remainder);
+
+const int arraySize = 20;
+
+inline void assign(Term& term1, const Term& term2)
+{
+    term1.coef = term2.coef;
+    term1.expon = term2.expon;
+}
+
+// polynomial = 0, giving its storage back to the allocator
+template< typename Allocator >
+void release(vector< Term, Allocator >& polynomial)
+{
+    vector< Term, Allocator >(polynomial.get_allocator()).swap(polynomial);
+}
+
+// enable user to input a polynomial
+template< typename Allocator >
+void input(istream& inFile, vector< Term, Allocator >& polynomial)
+{
+    int numericString[arraySize] = {};
+
+    inFile.read(reinterpret_cast<char*>(numericString), 80);
+
+    int size = arraySize;
+    while (size > 0 && numericString[size - 1] == 0)
+        size--;
+
+    polynomial.resize(size);
+    for (size_t i = 0; i < polynomial.size(); ++i)
+        polynomial[i].coef = numericString[i];
+
+    inFile.read(reinterpret_cast<char*>(numericString), 80);
+
+    for (size_t i = 0; i < polynomial.size(); ++i)
+        polynomial[i].expon = numericString[i];
+}
+
+// outputs the specified polynomial
+template< typename Allocator >
+void output(const vector< Term, Allocator >& polynomial)
+{
+    // the specified polynomial is zero polynomial
+    if (polynomial.size() == 0)
+        cout << 0;
+    else
+    {
+        if (polynomial[0].coef < 0)
+            cout << "-" << -polynomial[0].coef;
+        else if (polynomial[0].coef > 0)
+            cout << polynomial[0].coef;
+
+        if (polynomial[0].expon > 0)
+        {
+            if (polynomial[0].expon == 1)
+                cout << "x";
+            else
+                cout << "x^" << polynomial[0].expon;
+        }
+
+        for (size_t i = 1; i < polynomial.size(); i++)
+        {
+            if (polynomial[i].coef < 0)
+                cout << " - " << -polynomial[i].coef;
+            else if (polynomial[i].coef > 0)
+                cout << " + " << polynomial[i].coef;
+
+            if (polynomial[i].expon > 0)
+            {
+                if (polynomial[i].expon == 1)
+                    cout << "x";
+                else
+                    cout << "x^" << polynomial[i].expon;
+            }
+        }
+    }
+
+    cout << endl;
+}
+
+// returns true if and only if the specified polynomial has at least a zero term
+template< typename Allocator >
+bool hasZeroTerm(const vector< Term, Allocator >& polynomial)
+{
+    if (polynomial.size() != 0)
+        for (size_t i = 0; i < polynomial.size(); i++)
+            if (polynomial[i].coef == 0)
+                return true;
+
+    return false;
+}
+
+// returns true if and only if polynomial1 == polynomial2
+template< typename Allocator >
+bool equal(const vector< Term, Allocator >& polynomial1, const vector< Term, Allocator >& polynomial2)
+{
+    if (polynomial1.size() != polynomial2.size())
+        return false;
+
+    for (size_t i = 0; i < polynomial1.size(); i++)
+        if (polynomial1[i].coef != polynomial2[i].coef ||
+            polynomial1[i].expon != polynomial2[i].expon)
+            return false;
+
+    return true;
+}
+
+// polynomial1 = -polynomial2
+template< typename Allocator >
+void minus(vector< Term, Allocator >& polynomial1, const vector< Term, Allocator >& polynomial2)
+{
+    polynomial1.resize(polynomial2.size());
+    for (size_t i = 0; i < polynomial1.size(); i++)
+    {
+        polynomial1[i].coef = -polynomial2[i].coef;
+        polynomial1[i].expon = polynomial2[i].expon;
+    }
+}
+
+// addend += adder
+template< typename Allocator >
+void addition(vector< Term, Allocator >& addend, const vector< Term, Allocator >& adder)
+{
+    vector< Term, Allocator > sum(addend.size() + adder.size(), Term(), addend.get_allocator());
+    size_t k = mergeAddition(addend.data(), static_cast< int >(addend.size()),
+        adder.data(), static_cast< int >(adder.size()), sum.data());
+
+    if (addend.size() != k)
+        addend.resize(k);
+
+    for (size_t i = 0; i < addend.size(); i++) // addend = sum
+        assign(addend[i], sum[i]);
+}
+
+// minuend -= subtrahend
+template< typename Allocator >
+void subtraction(vector< Term, Allocator >& minuend, const vector< Term, Allocator >& subtrahend)
+{
+    // buffer = 0
+    vector< Term, Allocator > buffer(subtrahend.size(), Term(), minuend.get_allocator());
+
+    // buffer = -subtrahend
+    minus(buffer, subtrahend);
+
+    // minuend = minuend + buffer = minuend - subtrahend
+    addition(minuend, buffer);
+
+    if (minuend.size() > 0 && minuend[0].coef == 0)
+        cout << "Leading zeroes in minuend not allowed!\n";
+}
+
+// product = multiplicand * multiplier
+template< typename Allocator >
+void multiplication(const vector< Term, Allocator >& multiplicand, const vector< Term, Allocator >& multiplier, vector< Term, Allocator >& product)
+{
+    // product = 0;
+    product.clear();
+
+    // the multiplicand.size() * multiplier.size() products are merged by a heap or accumulated in a hash table,
+    // whichever suits the expected density of the product
+    sparseMultiplication(termLayout(multiplicand), termLayout(multiplier),
+        [&](int coef, int expon)
+        {
+            Term term;
+            term.coef = coef;
+            term.expon = expon;
+            product.push_back(term);
+        });
+
+    if (product.size() > 0 && product[0].coef == 0)
+        cout << "Leading zeroes in product not allowed!\n";
+}
+
+// quotient = dividend / divisor; remainder = dividend % divisor
+// provided that dividendExpon[ dividendSize - 1 ] >= divisorExpon[ divisorSize - 1 ]
+template< typename Allocator >
+void division(const vector< Term, Allocator >& dividend, const vector< Term, Allocator >& divisor,
+    vector< Term, Allocator >& quotient, vector< Term, Allocator >& remainder)
+{
+    quotient.clear();
+    remainder.clear();
+
+    // the terms of dividend - divisor * quotient come out of a heap one at a time,
+    // so the remainder is written once instead of being rewritten for every quotient term
+    heapDivision(termLayout(dividend), termLayout(divisor),
+        [&](int coef, int expon)
+        {
+            Term term;
+            term.coef = coef;
+            term.expon = expon;
+            quotient.push_back(term);
+        },
+        [&](int coef, int expon)
+        {
+            Term term;
+            term.coef = coef;
+            term.expon = expon;
+            remainder.push_back(term);
+        });
+
+    if (quotient.size() > 0 && quotient[0].coef == 0)
+        cout << "Leading zeroes in quotient not allowed!\n";
+
+    if (remainder.size() > 0 && remainder[0].coef == 0)
+        cout << "Leading zeroes in remainder not allowed!\n";
+}
+
+} // end namespace hw84
+
+#endif
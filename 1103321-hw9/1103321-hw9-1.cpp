@@ -2,50 +2,75 @@
 using namespace::std;
 #include <fstream>
 #include <cstring>
+#include <cstdlib>
 
-// input all words from the file Dictionary.txt, and put them to the array "dictionary"
-void readDictionary(char(*dictionary)[21], int& numDicWords);
+#include "../dictionary/WordSet.h"
+#include "../dictionary/DeletionIndex.h"
+#include "../dictionary/WordTrie.h"
 
-// return true if and only if wordToCheck == dictionary[ i ] for some i
-bool legal(char* wordToCheck, char(*dictionary)[21], int numDicWords);
+// input all words from the file Dictionary.txt, and put them to the array "dictionary", to wordSet,
+// to deletionIndex and to wordTrie
+void readDictionary(char(*dictionary)[21], int& numDicWords, WordSet& wordSet, DeletionIndex& deletionIndex, WordTrie& wordTrie);
 
-// Find every word w in the array "dictionary" which satisfies two conditions:
+// return true if and only if wordToCheck is in wordSet, which holds the words of the dictionary
+bool legal(char* wordToCheck, const WordSet& wordSet);
+
+// Find every word w of the dictionary in deletionIndex which satisfies two conditions:
 // 1. the length of w is equal to the length of wordToCheck, and
 // 2. wordToCheck and w are different on exactly one character.
 // Put these words into the array "result".
-void spellCheck1(char* wordToCheck, char(*dictionary)[21], int numDicWords, char(*&result)[21], int& numResult);
+void spellCheck1(char* wordToCheck, const DeletionIndex& deletionIndex, char(*&result)[21], int& numResult, int& capacity);
 
-// Find every word w in the array "dictionary" which satisfies two conditions:
+// Find every word w of the dictionary in deletionIndex which satisfies two conditions:
 // 1. the length of w is one greater than the length of wordToCheck, and
 // 2. wordToCheck is equal to the substring obtained by deleting a character from w.
 // Put these words into the array "result".
-void spellCheck2(char* wordToCheck, char(*dictionary)[21], int numDicWords, char(*&result)[21], int& numResult);
+void spellCheck2(char* wordToCheck, const DeletionIndex& deletionIndex, char(*&result)[21], int& numResult, int& capacity);
 
-// Find every word w in the array "dictionary" which satisfies two conditions:
+// Find every word w of the dictionary in deletionIndex which satisfies two conditions:
 // 1. the length of w is one less than the length of wordToCheck, and
 // 2. w is equal to the substring obtained by deleting a character from wordToCheck.
 // Put these words into the array "result".
-void spellCheck3(char* wordToCheck, char(*dictionary)[21], int numDicWords, char(*&result)[21], int& numResult);
+void spellCheck3(char* wordToCheck, const DeletionIndex& deletionIndex, char(*&result)[21], int& numResult, int& capacity);
+
+// Find every word w of the dictionary in wordTrie within maxDistance edits ( a character deleted,
+// inserted or replaced ) of wordToCheck, nearest first and in dictionary order among words as near.
+// Put these words into the array "result".
+void spellCheck4(char* wordToCheck, const WordTrie& wordTrie, int maxDistance, char(*&result)[21], int& numResult, int& capacity);
 
-// find the words in the array "dictionary" whose length is equal to the last parameter "length",
-// and puts these words into the array "words"
-void findWords(char(*&words)[21], int& numWords, char(*dictionary)[21], int numDicWords, int length);
+// put word[ 0 .. length - 1 ] into result[ numResult ], and increment numResult;
+// a full array "result" is replaced by one of twice the capacity
+void appendWord(char(*&result)[21], int& numResult, int& capacity, const char* word, size_t length);
 
 // output all words in the array "result" to the file Result.txt
 void saveWords(char(*result)[21], int numResult);
 
-int main()
+// usage: hw9-1 [maxDistance]
+//   maxDistance  suggest the words within 1 to 3 edits with spellCheck4 instead of
+//                spellCheck1, spellCheck2 and spellCheck3
+int main(int argc, char* argv[])
 {
+    int maxDistance = argc > 1 ? atoi(argv[1]) : 0;
+    if (argc > 1 && (maxDistance < 1 || maxDistance > 3))
+    {
+        cout << "maxDistance must be 1, 2 or 3" << endl;
+        return 1;
+    }
+
     srand(1);
 
     int numDicWords = 0;
     char(*dictionary)[21] = new char[40000][21];
 
-    readDictionary(dictionary, numDicWords);
+    WordSet wordSet(40000);
+    DeletionIndex deletionIndex;
+    WordTrie wordTrie;
+    readDictionary(dictionary, numDicWords, wordSet, deletionIndex, wordTrie);
 
     char wordToCheck[21];
     int numResult = 0;
-    char(*result)[21] = new char[3000][21];
+    int capacity = 3000;
+    char(*result)[21] = new char[capacity][21];
     for (int i = 0; i < 10; i++)
     {
         strcpy_s(wordToCheck, 21, dictionary[rand() + numDicWords - 32768]);
@@ -53,19 +78,24 @@ int main()
         for (int j = rand() % length; j < length; j++)
             wordToCheck[j] = wordToCheck[j + 1];
 
-        if (legal(wordToCheck, dictionary, numDicWords))
+        if (legal(wordToCheck, wordSet))
             cout << wordToCheck << " is a legal english word.\n";
         else
         {
             cout << wordToCheck << endl;
 
-            strcpy_s(result[numResult++], 21, wordToCheck);
+            appendWord(result, numResult, capacity, wordToCheck, strlen(wordToCheck));
 
-            spellCheck1(wordToCheck, dictionary, numDicWords, result, numResult);
-            spellCheck2(wordToCheck, dictionary, numDicWords, result, numResult);
-            spellCheck3(wordToCheck, dictionary, numDicWords, result, numResult);
+            if (maxDistance > 0)
+                spellCheck4(wordToCheck, wordTrie, maxDistance, result, numResult, capacity);
+            else
+            {
+                spellCheck1(wordToCheck, deletionIndex, result, numResult, capacity);
+                spellCheck2(wordToCheck, deletionIndex, result, numResult, capacity);
+                spellCheck3(wordToCheck, deletionIndex, result, numResult, capacity);
+            }
 
-            strcpy_s(result[numResult++], 21, "");
+            appendWord(result, numResult, capacity, "", 0);
         }
     }
 
@@ -77,15 +107,12 @@ int main()
     system("pause");
 }
 
-bool legal(char* wordToCheck, char(*dictionary)[21], int numDicWords)
+bool legal(char* wordToCheck, const WordSet& wordSet)
 {
-    for (int i = 0; i < numDicWords; i++)
-        if (strcmp(dictionary[i], wordToCheck) == 0)
-            return true;
-    return false;
+    return wordSet.contains(wordToCheck);
 }
 
-void readDictionary(char(*dictionary)[21], int& numDicWords)
+void readDictionary(char(*dictionary)[21], int& numDicWords, WordSet& wordSet, DeletionIndex& deletionIndex, WordTrie& wordTrie)
 {
     ifstream inFile("Dictionary.txt", ios::in);
 
@@ -96,173 +123,63 @@ void readDictionary(char(*dictionary)[21], int& numDicWords)
     }
 
     while (inFile >> dictionary[numDicWords])
+    {
+        wordSet.insert(dictionary[numDicWords], strlen(dictionary[numDicWords]));
+        deletionIndex.insert(dictionary[numDicWords], strlen(dictionary[numDicWords]));
+        wordTrie.insert(dictionary[numDicWords], strlen(dictionary[numDicWords]));
         numDicWords++;
+    }
+
+    deletionIndex.build();
+    wordTrie.build();
 
     inFile.close();
 }
 
-void spellCheck1(char* wordToCheck, char(*dictionary)[21],
-    int numDicWords, char(*&result)[21], int& numResult)
+void spellCheck1(char* wordToCheck, const DeletionIndex& deletionIndex, char(*&result)[21], int& numResult, int& capacity)
 {
-    int length = strlen(wordToCheck);
-    int numWords = 0;
-    char(*words)[21] = 0;
-
-    findWords(words, numWords, dictionary, numDicWords, length);
-
-    char buffer1[21];
-    char buffer2[21];
-
-    for (int n = 0; n < length; n++) //buffer2 = wordToCheck
-        buffer2[n] = wordToCheck[n];
-
-    for (int i = 0; i < numWords; i++)
-    {
-        for (int n = 0; n < length; n++) //buffer1 = the words with same length of wordToCheck
-            buffer1[n] = words[i][n];
-
-        for (int j = 0; j < length; j++) //the one be erased (buffer1)
-        {
-            int counter = 0; 
-            for (int n = 0; n < length; n++) //find the words with one difference
-            {
-                if (n == j)
-                    continue;
-                else
-                {
-                    if (buffer1[n] == buffer2[n])
-                        counter++;
-                }
-            }
-            if (counter == length - 1)
-            {
-                for (int n = 0; n < length; n++)
-                    result[numResult][n] = buffer1[n];
-                
-                for (int n = length; n < 21; n++) //let remain space = {}
-                    result[numResult][n] = {};
-
-                numResult++;
-            }
-        }
-    }
-
-    delete[] words;
+    substitutionWords(deletionIndex, wordToCheck, strlen(wordToCheck),
+        [&](const char* word, size_t length) { appendWord(result, numResult, capacity, word, length); });
 }
 
-void spellCheck2(char* wordToCheck, char(*dictionary)[21],
-    int numDicWords, char(*&result)[21], int& numResult)
+void spellCheck2(char* wordToCheck, const DeletionIndex& deletionIndex, char(*&result)[21], int& numResult, int& capacity)
 {
-    int length = strlen(wordToCheck) + 1;
-    int numWords = 0;
-    char(*words)[21] = 0;
-    
-    findWords(words, numWords, dictionary, numDicWords, length);
-    
-    char buffer[21];
-
-    for (int i = 0; i < numWords; i++)
-    {
-        for (int n = 0; n < length; n++)
-            buffer[n] = words[i][n];
-
-        for (int j = 0; j < length; j++) //the space be added (words)
-        {
-            int counter = 0;
-            for (int n = 0; n < length; n++)
-            {                
-                if (n < j)
-                {
-                    if (buffer[n] == wordToCheck[n])
-                        counter++;
-                }
-
-                else if (n > j)
-                {
-                    if (buffer[n] == wordToCheck[n - 1])
-                        counter++;
-                }
-            }
-            if (counter == length - 1)
-            {
-                for (int n = 0; n < length; n++)
-                    result[numResult][n] = buffer[n];
-
-                for (int n = length; n < 21; n++) //let remain space = {}
-                    result[numResult][n] = {};
-
-                numResult++;
-            }
-        }
-    }
-
-    delete[] words;
+    insertionWords(deletionIndex, wordToCheck, strlen(wordToCheck),
+        [&](const char* word, size_t length) { appendWord(result, numResult, capacity, word, length); });
 }
 
-void spellCheck3(char* wordToCheck, char(*dictionary)[21],
-    int numDicWords, char(*&result)[21], int& numResult)
+void spellCheck3(char* wordToCheck, const DeletionIndex& deletionIndex, char(*&result)[21], int& numResult, int& capacity)
 {
-    int length = strlen(wordToCheck) - 1;
-    int numWords = 0;
-    char(*words)[21] = 0;
+    deletionWords(deletionIndex, wordToCheck, strlen(wordToCheck),
+        [&](const char* word, size_t length) { appendWord(result, numResult, capacity, word, length); });
+}
 
-    findWords(words, numWords, dictionary, numDicWords, length);
+void spellCheck4(char* wordToCheck, const WordTrie& wordTrie, int maxDistance, char(*&result)[21], int& numResult, int& capacity)
+{
+    nearWords(wordTrie, wordToCheck, strlen(wordToCheck), maxDistance,
+        [&](const char* word, size_t length, int) { appendWord(result, numResult, capacity, word, length); });
+}
 
-    char buffer[21];
-    for (int i = 0; i < numWords; i++)
+void appendWord(char(*&result)[21], int& numResult, int& capacity, const char* word, size_t length)
+{
+    if (numResult == capacity)
     {
-        for (int n = 0; n < length; n++)
-            buffer[n] = words[i][n];
+        char(*buffer)[21] = new char[2 * capacity][21];
+        for (int i = 0; i < numResult; i++)
+            memcpy(buffer[i], result[i], 21);
 
-        for (int j = 0; j < length + 1; j++) //the space be added (buffer)
-        {
-            int counter = 0;
-            for (int n = 0; n < length + 1; n++)
-            {
-                if (n < j)
-                {
-                    if (buffer[n] == wordToCheck[n])
-                        counter++;
-                }
-
-                else if (n > j)
-                {
-                    if (buffer[n - 1] == wordToCheck[n])
-                        counter++;
-                }
-            }
-            if (counter == length)
-            {
-                for (int n = 0; n < length; n++)
-                    result[numResult][n] = buffer[n];
-
-                for (int n = length; n < 21; n++) //let remain space = {}
-                    result[numResult][n] = {};
-
-                numResult++;
-            }
-        }
+        delete[] result;
+        result = buffer;
+        capacity *= 2;
     }
 
-    delete[] words;
-}
-
-void findWords(char(*&words)[21], int& numWords,
-    char(*dictionary)[21], int numDicWords, int length)
-{
-    for (int i = 0; i < numDicWords; i++)
-        if (strlen(dictionary[i]) == length)
-            numWords++;
+    for (size_t n = 0; n < length; n++)
+        result[numResult][n] = word[n];
 
-    words = new char[numWords][21];
+    for (size_t n = length; n < 21; n++) //let remain space = {}
+        result[numResult][n] = {};
 
-    numWords = 0;
-    for (int i = 0; i < numDicWords; i++)
-        if (strlen(dictionary[i]) == length)
-        {
-            strcpy_s(words[numWords], 21, dictionary[i]);
-            numWords++;
-        }
+    numResult++;
 }
 
 void saveWords(char(*result)[21], int numResult)
@@ -3,66 +3,96 @@ using namespace::std;
 #include <fstream>
 #include <string>
 #include <ctime>
+#include <cstdlib>
 
-// input all words from the file Dictionary.txt, and put them to the array "dictionary"
-void readDictionary(string* dictionary, int& numDicWords);
+#include "../dictionary/WordSet.h"
+#include "../dictionary/DeletionIndex.h"
+#include "../dictionary/WordTrie.h"
 
-// return true if and only if wordToCheck == dictionary[ i ] for some i
-bool legal(string wordToCheck, string* dictionary, int numDicWords);
+// input all words from the file Dictionary.txt, and put them to the array "dictionary", to wordSet,
+// to deletionIndex and to wordTrie
+void readDictionary(string* dictionary, int& numDicWords, WordSet& wordSet, DeletionIndex& deletionIndex, WordTrie& wordTrie);
 
-// Find every word w in the array "dictionary" which satisfies two conditions:
+// return true if and only if wordToCheck is in wordSet, which holds the words of the dictionary
+bool legal(const string& wordToCheck, const WordSet& wordSet);
+
+// Find every word w of the dictionary in deletionIndex which satisfies two conditions:
 // 1. the length of w is equal to the length of wordToCheck, and
 // 2. wordToCheck and w are different on exactly one character.
 // Put these words into the array "result".
-void spellCheck1(string wordToCheck, string* dictionary, int numDicWords, string* result, int& numResult);
+void spellCheck1(const string& wordToCheck, const DeletionIndex& deletionIndex, string*& result, int& numResult, int& capacity);
 
-// Find every word w in the array "dictionary" which satisfies two conditions:
+// Find every word w of the dictionary in deletionIndex which satisfies two conditions:
 // 1. the length of w is one greater than the length of wordToCheck, and
 // 2. wordToCheck is equal to the substring obtained by deleting a character from w.
 // Put these words into the array "result".
-void spellCheck2(string wordToCheck, string* dictionary, int numDicWords, string* result, int& numResult);
+void spellCheck2(const string& wordToCheck, const DeletionIndex& deletionIndex, string*& result, int& numResult, int& capacity);
 
-// Find every word w in the array "dictionary" which satisfies two conditions:
+// Find every word w of the dictionary in deletionIndex which satisfies two conditions:
 // 1. the length of w is one less than the length of wordToCheck, and
 // 2. w is equal to the substring obtained by deleting a character from wordToCheck.
 // Put these words into the array "result".
-void spellCheck3(string wordToCheck, string* dictionary, int numDicWords, string* result, int& numResult);
+void spellCheck3(const string& wordToCheck, const DeletionIndex& deletionIndex, string*& result, int& numResult, int& capacity);
+
+// Find every word w of the dictionary in wordTrie within maxDistance edits ( a character deleted,
+// inserted or replaced ) of wordToCheck, nearest first and in dictionary order among words as near.
+// Put these words into the array "result".
+void spellCheck4(const string& wordToCheck, const WordTrie& wordTrie, int maxDistance, string*& result, int& numResult, int& capacity);
 
-// find the words in the array "dictionary" whose length is equal to the last parameter "length",
-// and puts these words into the array "words"
-void findWords(string*& words, int& numWords, string* dictionary, int numDicWords, size_t length);
+// put word[ 0 .. length - 1 ] into result[ numResult ], and increment numResult;
+// a full array "result" is replaced by one of twice the capacity
+void appendWord(string*& result, int& numResult, int& capacity, const char* word, size_t length);
 
 // output all words in the array "result" to the file Result.txt
 void saveWords(string* result, int numResult);
 
-int main()
+// usage: hw9-2 [maxDistance]
+//   maxDistance  suggest the words within 1 to 3 edits with spellCheck4 instead of
+//                spellCheck1, spellCheck2 and spellCheck3
+int main(int argc, char* argv[])
 {
+    int maxDistance = argc > 1 ? atoi(argv[1]) : 0;
+    if (argc > 1 && (maxDistance < 1 || maxDistance > 3))
+    {
+        cout << "maxDistance must be 1, 2 or 3" << endl;
+        return 1;
+    }
+
     srand(1);
 
     int numDicWords = 0;
     string* dictionary = new string[40000];
 
-    readDictionary(dictionary, numDicWords);
+    WordSet wordSet(40000);
+    DeletionIndex deletionIndex;
+    WordTrie wordTrie;
+    readDictionary(dictionary, numDicWords, wordSet, deletionIndex, wordTrie);
 
     string wordToCheck;
     int numResult = 0;
-    string* result = new string[3000];
+    int capacity = 3000;
+    string* result = new string[capacity];
     for (int i = 0; i < 10; i++)
     {
         wordToCheck = dictionary[rand() + numDicWords - 32768]; // skip short words
         wordToCheck.erase(rand() % wordToCheck.size(), 1);
 
-        if (legal(wordToCheck, dictionary, numDicWords))
+        if (legal(wordToCheck, wordSet))
             cout << wordToCheck << " is a legal english word.\n";
         else
         {
             cout << wordToCheck << endl;
-            result[numResult++] = wordToCheck;
+            appendWord(result, numResult, capacity, wordToCheck.data(), wordToCheck.size());
 
-            spellCheck1(wordToCheck, dictionary, numDicWords, result, numResult);
-            spellCheck2(wordToCheck, dictionary, numDicWords, result, numResult);
-            spellCheck3(wordToCheck, dictionary, numDicWords, result, numResult);
-            result[numResult++] = "";
+            if (maxDistance > 0)
+                spellCheck4(wordToCheck, wordTrie, maxDistance, result, numResult, capacity);
+            else
+            {
+                spellCheck1(wordToCheck, deletionIndex, result, numResult, capacity);
+                spellCheck2(wordToCheck, deletionIndex, result, numResult, capacity);
+                spellCheck3(wordToCheck, deletionIndex, result, numResult, capacity);
+            }
+            appendWord(result, numResult, capacity, "", 0);
         }
     }
 
@@ -74,15 +104,12 @@ int main()
     system("pause");
 }
 
-bool legal(string wordToCheck, string* dictionary, int numDicWords)
+bool legal(const string& wordToCheck, const WordSet& wordSet)
 {
-    for (int i = 0; i < numDicWords; i++)
-        if (dictionary[i] == wordToCheck)
-            return true;
-    return false;
+    return wordSet.contains(wordToCheck);
 }
 
-void readDictionary(string* dictionary, int& numDicWords)
+void readDictionary(string* dictionary, int& numDicWords, WordSet& wordSet, DeletionIndex& deletionIndex, WordTrie& wordTrie)
 {
     ifstream inFile("Dictionary.txt", ios::in);
 
@@ -93,142 +120,57 @@ void readDictionary(string* dictionary, int& numDicWords)
     }
 
     while (inFile >> dictionary[numDicWords])
+    {
+        wordSet.insert(dictionary[numDicWords]);
+        deletionIndex.insert(dictionary[numDicWords]);
+        wordTrie.insert(dictionary[numDicWords]);
         numDicWords++;
+    }
+
+    deletionIndex.build();
+    wordTrie.build();
 
     inFile.close();
 }
 
-void spellCheck1(string wordToCheck, string* dictionary,
-    int numDicWords, string* result, int& numResult)
+void spellCheck1(const string& wordToCheck, const DeletionIndex& deletionIndex, string*& result, int& numResult, int& capacity)
 {
-    size_t length = wordToCheck.size();
-    int numWords = 0;
-    string* words = 0;
-
-    findWords(words, numWords, dictionary, numDicWords, length);
-
-    string buffer1;
-    string buffer2;
-
-    buffer2 = wordToCheck;
-
-    for (int i = 0; i < numWords; i++)
-    {
-        buffer1 = words[i];
-
-        for (size_t j = 0; j < length; j++)
-        {
-            size_t counter = 0;
-
-            for (size_t n = 0; n < length; n++)
-            {
-                if (n == j)
-                    continue;
-                if (buffer1[n] == wordToCheck[n])
-                    counter++;
-            }
-            if (counter == length - 1)
-            {
-                result[numResult] = buffer1;
-                numResult++;
-            }
-        }
-    }
-
-    delete[] words;
+    substitutionWords(deletionIndex, wordToCheck.data(), wordToCheck.size(),
+        [&](const char* word, size_t length) { appendWord(result, numResult, capacity, word, length); });
 }
 
-void spellCheck2(string wordToCheck, string* dictionary, int numDicWords, string* result, int& numResult)
+void spellCheck2(const string& wordToCheck, const DeletionIndex& deletionIndex, string*& result, int& numResult, int& capacity)
 {
-    size_t length = wordToCheck.size() + 1;
-    int numWords = 0;
-    string* words = 0;
-
-    findWords(words, numWords, dictionary, numDicWords, length);
-
-    string buffer;
-    for (int i = 0; i < numWords; i++)
-    {
-        buffer = words[i];
-
-        for (size_t j = 0; j < length; j++)
-        {
-            size_t counter = 0;
-
-            for (size_t n = 0; n < length; n++)
-            {
-                if (n == j)
-                    continue;
-                if (n < j)
-                    if (buffer[n] == wordToCheck[n])
-                        counter++;
-                if(n > j)
-                    if(buffer[n] == wordToCheck[n - 1])
-                        counter++;
-            }
-            if (counter == length - 1)
-            {
-                result[numResult] = buffer;
-                numResult++;
-            }
-        }
-    }
-
-    delete[] words;
+    insertionWords(deletionIndex, wordToCheck.data(), wordToCheck.size(),
+        [&](const char* word, size_t length) { appendWord(result, numResult, capacity, word, length); });
 }
 
-void spellCheck3(string wordToCheck, string* dictionary, int numDicWords, string* result, int& numResult)
+void spellCheck3(const string& wordToCheck, const DeletionIndex& deletionIndex, string*& result, int& numResult, int& capacity)
 {
-    size_t length = wordToCheck.size() - 1;
-    int numWords = 0;
-    string* words = 0;
-
-    findWords(words, numWords, dictionary, numDicWords, length);
-
-    string buffer;
-    for (int i = 0; i < numWords; i++)
-    {
-        buffer = words[i];
-
-        for (size_t j = 0; j < length + 1; j++)
-        {
-            size_t counter = 0;
-
-            for (size_t n = 0; n < length + 1; n++)
-            {
-                if (n == j)
-                    continue;
-                if (n < j)
-                    if (buffer[n] == wordToCheck[n])
-                        counter++;
-                if (n > j)
-                    if (buffer[n - 1] == wordToCheck[n])
-                        counter++;
-            }
-            if (counter == length)
-            {
-                result[numResult] = buffer;
-                numResult++;
-            }
-        }
-    }
+    deletionWords(deletionIndex, wordToCheck.data(), wordToCheck.size(),
+        [&](const char* word, size_t length) { appendWord(result, numResult, capacity, word, length); });
+}
 
-    delete[] words;
+void spellCheck4(const string& wordToCheck, const WordTrie& wordTrie, int maxDistance, string*& result, int& numResult, int& capacity)
+{
+    nearWords(wordTrie, wordToCheck.data(), wordToCheck.size(), maxDistance,
+        [&](const char* word, size_t length, int) { appendWord(result, numResult, capacity, word, length); });
 }
 
-void findWords(string*& words, int& numWords, string* dictionary,
-    int numDicWords, size_t length)
+void appendWord(string*& result, int& numResult, int& capacity, const char* word, size_t length)
 {
-    for (int i = 0; i < numDicWords; i++)
-        if (dictionary[i].size() == length)
-            numWords++;
+    if (numResult == capacity)
+    {
+        string* buffer = new string[2 * capacity];
+        for (int i = 0; i < numResult; i++)
+            buffer[i].swap(result[i]);
 
-    words = new string[numWords];
+        delete[] result;
+        result = buffer;
+        capacity *= 2;
+    }
 
-    numWords = 0;
-    for (int i = 0; i < numDicWords; i++)
-        if (dictionary[i].size() == length)
-            words[numWords++] = dictionary[i];
+    result[numResult++].assign(word, length);
 }
 
 void saveWords(string* result, int numResult)
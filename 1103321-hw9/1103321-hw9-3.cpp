@@ -5,44 +5,64 @@ using namespace::std;
 #include <string>
 #include <vector>
 #include <ctime>
+#include <cstdlib>
 
-// input all words from the file Dictionary.txt, and put them to the vector "dictionary"
-void readDictionary(vector< string >& dictionary);
+#include "../dictionary/WordSet.h"
+#include "../dictionary/DeletionIndex.h"
+#include "../dictionary/WordTrie.h"
 
-// return true if and only if wordToCheck == dictionary[ i ] for some i
-bool legal(string wordToCheck, vector< string > dictionary);
+// input all words from the file Dictionary.txt, and put them to the vector "dictionary", to wordSet,
+// to deletionIndex and to wordTrie
+void readDictionary(vector< string >& dictionary, WordSet& wordSet, DeletionIndex& deletionIndex, WordTrie& wordTrie);
 
-// Find every word w in the vector "dictionary" which satisfies two conditions:
+// return true if and only if wordToCheck is in wordSet, which holds the words of the dictionary
+bool legal(const string& wordToCheck, const WordSet& wordSet);
+
+// Find every word w of the dictionary in deletionIndex which satisfies two conditions:
 // 1. the length of w is equal to the length of wordToCheck, and
 // 2. wordToCheck and w are different on exactly one character.
 // Put these words into the vector "result".
-void spellCheck1(string wordToCheck, vector< string > dictionary, vector< string >& result);
+void spellCheck1(const string& wordToCheck, const DeletionIndex& deletionIndex, vector< string >& result);
 
-// Find every word w in the vector "dictionary" which satisfies two conditions:
+// Find every word w of the dictionary in deletionIndex which satisfies two conditions:
 // 1. the length of w is one greater than the length of wordToCheck, and
 // 2. wordToCheck is equal to the substring obtained by deleting a character from w.
 // Put these words into the vector "result".
-void spellCheck2(string wordToCheck, vector< string > dictionary, vector< string >& result);
+void spellCheck2(const string& wordToCheck, const DeletionIndex& deletionIndex, vector< string >& result);
 
-// Find every word w in the vector "dictionary" which satisfies two conditions:
+// Find every word w of the dictionary in deletionIndex which satisfies two conditions:
 // 1. the length of w is one less than the length of wordToCheck, and
 // 2. w is equal to the substring obtained by deleting a character from wordToCheck.
 // Put these words into the vector "result".
-void spellCheck3(string wordToCheck, vector< string > dictionary, vector< string >& result);
+void spellCheck3(const string& wordToCheck, const DeletionIndex& deletionIndex, vector< string >& result);
 
-// find the words in the vector "dictionary" whose length is equal to the last parameter "length",
-// and puts these words into the vector "words"
-void findWords(vector< string >& words, vector< string > dictionary, size_t length);
+// Find every word w of the dictionary in wordTrie within maxDistance edits ( a character deleted,
+// inserted or replaced ) of wordToCheck, nearest first and in dictionary order among words as near.
+// Put these words into the vector "result".
+void spellCheck4(const string& wordToCheck, const WordTrie& wordTrie, int maxDistance, vector< string >& result);
 
 // output all words in the vector "result" to the file result
 void saveWords(vector< string > result);
 
-int main()
+// usage: hw9-3 [maxDistance]
+//   maxDistance  suggest the words within 1 to 3 edits with spellCheck4 instead of
+//                spellCheck1, spellCheck2 and spellCheck3
+int main(int argc, char* argv[])
 {
+    int maxDistance = argc > 1 ? atoi(argv[1]) : 0;
+    if (argc > 1 && (maxDistance < 1 || maxDistance > 3))
+    {
+        cout << "maxDistance must be 1, 2 or 3" << endl;
+        return 1;
+    }
+
     srand(1);
     vector< string > dictionary;
 
-    readDictionary(dictionary);
+    WordSet wordSet(40000);
+    DeletionIndex deletionIndex;
+    WordTrie wordTrie;
+    readDictionary(dictionary, wordSet, deletionIndex, wordTrie);
 
     string wordToCheck;
     vector< string > result;
@@ -51,16 +71,21 @@ int main()
         wordToCheck = dictionary[rand() + dictionary.size() - 32768]; // skip short words
         wordToCheck.erase(rand() % wordToCheck.size(), 1);
 
-        if (legal(wordToCheck, dictionary))
+        if (legal(wordToCheck, wordSet))
             cout << wordToCheck << " is a legal english word.\n";
         else
         {
             cout << wordToCheck << endl;
             result.push_back(wordToCheck);
 
-            spellCheck1(wordToCheck, dictionary, result);
-            spellCheck2(wordToCheck, dictionary, result);
-            spellCheck3(wordToCheck, dictionary, result);
+            if (maxDistance > 0)
+                spellCheck4(wordToCheck, wordTrie, maxDistance, result);
+            else
+            {
+                spellCheck1(wordToCheck, deletionIndex, result);
+                spellCheck2(wordToCheck, deletionIndex, result);
+                spellCheck3(wordToCheck, deletionIndex, result);
+            }
             result.push_back("");
         }
     }
@@ -70,7 +95,7 @@ int main()
     system("pause");
 }
 
-void readDictionary(vector< string >& dictionary)
+void readDictionary(vector< string >& dictionary, WordSet& wordSet, DeletionIndex& deletionIndex, WordTrie& wordTrie)
 {
     ifstream inFile("Dictionary.txt", ios::in);
 
@@ -83,125 +108,46 @@ void readDictionary(vector< string >& dictionary)
     string temp;
     
     while (inFile >> temp)
+    {
         dictionary.push_back(temp);
+        wordSet.insert(temp);
+        deletionIndex.insert(temp);
+        wordTrie.insert(temp);
+    }
+
+    deletionIndex.build();
+    wordTrie.build();
 
     inFile.close();
 }
 
-bool legal(string wordToCheck, vector< string > dictionary)
+bool legal(const string& wordToCheck, const WordSet& wordSet)
 {
-    for (size_t i = 0; i < dictionary.size(); i++)
-        if (dictionary[i] == wordToCheck)
-            return true;
-    return false;
+    return wordSet.contains(wordToCheck);
 }
 
-void spellCheck1(string wordToCheck, vector< string > dictionary, vector< string >& result)
+void spellCheck1(const string& wordToCheck, const DeletionIndex& deletionIndex, vector< string >& result)
 {
-    size_t length = wordToCheck.size();
-    vector< string > words;
-
-    findWords(words, dictionary, length);
-
-    string buffer1;
-    string buffer2;
-
-    buffer2 = wordToCheck;
-
-    for (size_t i = 0; i < words.size(); i++)
-    {
-        buffer1 = words[i];
-        for (size_t j = 0; j < length; j++)
-        {
-            int counter = 0;
-            for (size_t n = 0; n < length; n++)
-            {
-                if (n == j)
-                    continue;
-                if (buffer1[n] == buffer2[n])
-                    counter++;
-            }
-            if (counter == length - 1)
-            {
-                result.push_back(buffer1);
-            }
-        }
-    }
+    substitutionWords(deletionIndex, wordToCheck.data(), wordToCheck.size(),
+        [&](const char* word, size_t length) { result.emplace_back(word, length); });
 }
 
-void spellCheck2(string wordToCheck, vector< string > dictionary, vector< string >& result)
+void spellCheck2(const string& wordToCheck, const DeletionIndex& deletionIndex, vector< string >& result)
 {
-    size_t length = wordToCheck.size() + 1;
-    vector< string > words;
-
-    findWords(words, dictionary, length);
-
-    string buffer;
-    for (size_t i = 0; i < words.size(); i++)
-    {
-        buffer = words[i];
-        for (size_t j = 0; j < length; j++)
-        {
-            int counter = 0;
-            for (size_t n = 0; n < length; n++)
-            {
-                if (n == j)
-                    continue;
-                if (n < j)
-                    if (buffer[n] == wordToCheck[n])
-                        counter++;
-                if(n > j)
-                    if (buffer[n] == wordToCheck[n - 1])
-                        counter++;
-            }
-
-            if (counter == length - 1)
-            {
-                result.push_back(buffer);
-            }
-        }
-    }
+    insertionWords(deletionIndex, wordToCheck.data(), wordToCheck.size(),
+        [&](const char* word, size_t length) { result.emplace_back(word, length); });
 }
 
-void spellCheck3(string wordToCheck, vector< string > dictionary, vector< string >& result)
+void spellCheck3(const string& wordToCheck, const DeletionIndex& deletionIndex, vector< string >& result)
 {
-    size_t length = wordToCheck.size() - 1;
-    vector< string > words;
-
-    findWords(words, dictionary, length);
-
-    string buffer;
-    for (size_t i = 0; i < words.size(); i++)
-    {
-        buffer = words[i];
-        for (size_t j = 0; j < length + 1; j++)
-        {
-            int counter = 0;
-            for (size_t n = 0; n < length + 1; n++)
-            {
-                if (n == j)
-                    continue;
-                if (n < j)
-                    if (buffer[n] == wordToCheck[n])
-                        counter++;
-                if (n > j)
-                    if (buffer[n - 1] == wordToCheck[n])
-                        counter++;
-            }
-
-            if (counter == length)
-            {
-                result.push_back(buffer);
-            }
-        }
-    }
+    deletionWords(deletionIndex, wordToCheck.data(), wordToCheck.size(),
+        [&](const char* word, size_t length) { result.emplace_back(word, length); });
 }
 
-void findWords(vector< string >& words, vector< string > dictionary, size_t length)
+void spellCheck4(const string& wordToCheck, const WordTrie& wordTrie, int maxDistance, vector< string >& result)
 {
-    for (size_t i = 0; i < dictionary.size(); i++)
-        if (dictionary[i].size() == length)
-            words.push_back(dictionary[i]);
+    nearWords(wordTrie, wordToCheck.data(), wordToCheck.size(), maxDistance,
+        [&](const char* word, size_t length, int) { result.emplace_back(word, length); });
 }
 
 void saveWords(vector< string > result)
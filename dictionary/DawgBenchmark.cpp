@@ -0,0 +1,207 @@
+// Times starting a checker from a word list ( reading it and building a WordSet, as hw9 does )
+// against mapping the DAWG file compiled from it, on dictionaries of growing size, then times
+// looking words up in both and the words within two edits in the DAWG, and checks that the DAWG
+// agrees with the WordSet, with a WordTrie and with the list on the number of every word
+//
+// Half of the queries are words of the dictionary, and half are words with one letter deleted.
+// The word list and the DAWG file are written to DawgBenchmark.txt and DawgBenchmark.dawg in the
+// working directory, and removed afterwards.
+//
+// usage: DawgBenchmark [maxWords [dictionary]]
+//   maxWords    random dictionaries of 40000, 10^5, 10^6 and 10^7 words up to this size (10^6)
+//   dictionary  a word list timed before the random ones, such as Dictionary.txt
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <iomanip>
+using std::setw;
+using std::fixed;
+using std::setprecision;
+
+#include <string>
+using std::string;
+
+#include <vector>
+using std::vector;
+
+#include <algorithm>
+using std::sort;
+using std::unique;
+
+#include <random>
+using std::mt19937_64;
+
+#include <chrono>
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "DictionaryFile.h"
+#include "WordSet.h"
+#include "WordTrie.h"
+#include "DawgFile.h"
+
+// times every engine on words and prints a row of the table; returns the number of errors
+int timeDictionary(const string& name, const vector< string >& words);
+
+int main(int argc, char* argv[])
+{
+    long long maxWords = argc > 1 ? atoll(argv[1]) : 1000000;
+
+    cout << setw(12) << "dictionary" << setw(10) << "words" << setw(10) << "load s" << setw(10) << "load MB"
+        << setw(12) << "compile s" << setw(10) << "dawg MB" << setw(10) << "open us" << setw(10) << "set ns"
+        << setw(10) << "dawg ns" << setw(12) << "near2 us" << endl;
+
+    int numErrors = 0;
+    if (argc > 2)
+    {
+        vector< string > words;
+        if (!readWords(argv[2], words))
+        {
+            cerr << "File could not be opened" << endl;
+            return 1;
+        }
+
+        numErrors += timeDictionary(argv[2], words);
+    }
+
+    const long long sizes[] = { 40000, 100000, 1000000, 10000000 };
+    for (long long size : sizes)
+        if (size <= maxWords)
+            numErrors += timeDictionary("random", randomWords(static_cast< size_t >(size), 1));
+
+    cout << "\nThere are " << numErrors << " errors!\n";
+
+    return numErrors == 0 ? 0 : 1;
+}
+
+// times every engine on words and prints a row of the table; returns the number of errors
+int timeDictionary(const string& name, const vector< string >& words)
+{
+    const string textFile = "DawgBenchmark.txt";
+    const string dawgFile = "DawgBenchmark.dawg";
+    if (!writeWords(textFile, words))
+    {
+        cerr << "File could not be written" << endl;
+        return 1;
+    }
+
+    // starting from the word list: every word is parsed, stored and entered into a set
+    steady_clock::time_point start = steady_clock::now();
+    vector< string > loaded;
+    readWords(textFile, loaded);
+    WordSet wordSet(loaded.size());
+    for (size_t i = 0; i < loaded.size(); i++)
+        wordSet.insert(loaded[i]);
+    double loadSeconds = duration< double >(steady_clock::now() - start).count();
+
+    // the set, and the strings with the characters of those too long for their inline buffer
+    size_t loadBytes = wordSet.bytes() + loaded.capacity() * sizeof(string);
+    for (size_t i = 0; i < loaded.size(); i++)
+        if (loaded[i].capacity() > string().capacity())
+            loadBytes += loaded[i].capacity() + 1;
+
+    start = steady_clock::now();
+    if (!writeDawg(dawgFile, loaded))
+    {
+        cerr << "File could not be written" << endl;
+        return 1;
+    }
+    double compileSeconds = duration< double >(steady_clock::now() - start).count();
+
+    // starting from the DAWG: the file is mapped, and the first query reads what it needs
+    start = steady_clock::now();
+    MappedDawg dawg;
+    int numErrors = dawg.open(dawgFile) && dawg.contains(words[0]) ? 0 : 1;
+    double openSeconds = duration< double >(steady_clock::now() - start).count();
+
+    // the queries: words of the dictionary, and words with a letter deleted
+    mt19937_64 engine(2);
+    const int numQueries = 1 << 20;
+    vector< string > queries(numQueries);
+    for (int q = 0; q < numQueries; q++)
+    {
+        queries[q] = words[engine() % words.size()];
+        if (q % 2 == 1)
+            queries[q].erase(engine() % queries[q].size(), 1);
+    }
+
+    vector< char > inSet(numQueries);
+    start = steady_clock::now();
+    for (int q = 0; q < numQueries; q++)
+        inSet[q] = wordSet.contains(queries[q]);
+    double setSeconds = duration< double >(steady_clock::now() - start).count();
+
+    vector< char > inDawg(numQueries);
+    start = steady_clock::now();
+    for (int q = 0; q < numQueries; q++)
+        inDawg[q] = dawg.contains(queries[q]);
+    double dawgSeconds = duration< double >(steady_clock::now() - start).count();
+
+    for (int q = 0; q < numQueries; q++)
+        if (inSet[q] != inDawg[q])
+            numErrors++;
+
+    // the DAWG numbers the distinct words in alphabetical order
+    vector< string > sorted = words;
+    sort(sorted.begin(), sorted.end());
+    sorted.erase(unique(sorted.begin(), sorted.end()), sorted.end());
+    if (dawg.size() != sorted.size())
+        numErrors++;
+
+    vector< char > word(dawg.maxLength() + 1);
+    for (size_t i = 0; i < sorted.size() && i < dawg.size(); i++)
+        if (dawg.number(sorted[i].data(), sorted[i].size()) != i ||
+            string(word.data(), dawg.word(i, word.data())) != sorted[i])
+            numErrors++;
+
+    // the words within two edits, checked against a WordTrie
+    WordTrie trie;
+    for (size_t i = 0; i < sorted.size(); i++)
+        trie.insert(sorted[i]);
+    trie.build();
+
+    const int numNearQueries = 1 << 12;
+    vector< vector< string > > near(numNearQueries);
+    start = steady_clock::now();
+    for (int q = 0; q < numNearQueries; q++)
+        nearWords(dawg, queries[q].data(), queries[q].size(), 2, [&](const char* nearWord, size_t length, int)
+        {
+            near[q].emplace_back(nearWord, length);
+        });
+    double nearSeconds = duration< double >(steady_clock::now() - start).count();
+
+    vector< string > expected;
+    for (int q = 0; q < numNearQueries; q++)
+    {
+        expected.clear();
+        nearWords(trie, queries[q].data(), queries[q].size(), 2, [&](const char* nearWord, size_t length, int)
+        {
+            expected.emplace_back(nearWord, length);
+        });
+        if (near[q] != expected)
+            numErrors++;
+    }
+
+    size_t dawgBytes = dawg.bytes();
+    dawg.close();
+    remove(textFile.c_str());
+    remove(dawgFile.c_str());
+
+    cout << fixed << setprecision(2);
+    cout << setw(12) << name << setw(10) << words.size()
+        << setw(10) << loadSeconds << setprecision(1) << setw(10) << loadBytes / 1048576.0
+        << setprecision(2) << setw(12) << compileSeconds
+        << setprecision(1) << setw(10) << dawgBytes / 1048576.0
+        << setw(10) << openSeconds * 1e6
+        << setw(10) << setSeconds * 1e9 / numQueries
+        << setw(10) << dawgSeconds * 1e9 / numQueries
+        << setprecision(2) << setw(12) << nearSeconds * 1e6 / numNearQueries << endl;
+
+    return numErrors;
+}
@@ -0,0 +1,80 @@
+// Compiles a word list in the layout of Dictionary.txt into a DAWG file ( see DawgFile.h ) that
+// SpellChecker maps instead of reading the list
+//
+// The words may come in any order and repeat, and neither their number nor their length is
+// limited; the file holds each once, in alphabetical order.
+//
+// usage: DawgCompiler [options]
+//   --input f    the word list read (Dictionary.txt)
+//   --output f   the file written (Dictionary.dawg)
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <string>
+using std::string;
+
+#include <vector>
+using std::vector;
+
+#include <chrono>
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+#include <cstring>
+#include <utility>
+
+#include "DictionaryFile.h"
+#include "DawgFile.h"
+
+int main(int argc, char* argv[])
+{
+    string inputFile = "Dictionary.txt";
+    string outputFile = "Dictionary.dawg";
+
+    for (int i = 1; i < argc; i += 2)
+    {
+        if (i + 1 == argc)
+        {
+            cerr << "usage: DawgCompiler [--input file] [--output file]" << endl;
+            return 1;
+        }
+
+        if (strcmp(argv[i], "--input") == 0)
+            inputFile = argv[i + 1];
+        else if (strcmp(argv[i], "--output") == 0)
+            outputFile = argv[i + 1];
+        else
+        {
+            cerr << "usage: DawgCompiler [--input file] [--output file]" << endl;
+            return 1;
+        }
+    }
+
+    steady_clock::time_point start = steady_clock::now();
+    vector< string > words;
+    if (!readWords(inputFile, words))
+    {
+        cerr << "File could not be opened" << endl;
+        return 1;
+    }
+
+    if (!writeDawg(outputFile, std::move(words)))
+    {
+        cerr << "File could not be written" << endl;
+        return 1;
+    }
+
+    MappedDawg dawg;
+    if (!dawg.open(outputFile))
+    {
+        cerr << "File could not be mapped" << endl;
+        return 1;
+    }
+
+    cout << dawg.size() << " words, " << dawg.bytes() << " bytes written to " << outputFile << " in "
+        << duration< double >(steady_clock::now() - start).count() << " s" << endl;
+    return 0;
+}
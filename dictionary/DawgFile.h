@@ -0,0 +1,556 @@
+// DawgFile.h
+// A dictionary compiled into a minimized DAWG ( directed acyclic word graph ) in a flat binary
+// file, which a checker maps into memory and queries in place.
+//
+// A DAWG is a trie in which equal subtrees are stored once, so words that end alike ( "-ing",
+// "-tion" ) share their endings as a trie shares their beginnings. DawgBuilder takes the words in
+// alphabetical order and merges a subtree into an equal one met before as soon as no later word
+// can enter it ( the incremental construction of Daciuk, Mihov, Watson and Watson ), so it only
+// ever holds the minimized graph and the path of the last word.
+//
+// Layout: a 32-byte header ( 'D' 'A' 'W' 'G', uint32 version, uint32 numWords, uint32 numEdges,
+// uint32 rootEdge, uint32 maxLength, 8 bytes zero ) followed by numEdges edges of 12 bytes, of
+// which edge 0 is unused. The edges leaving a node lie side by side in alphabetical order, and a
+// node is referred to by the first of them, the root by rootEdge. An edge holds ( see DawgEdge )
+// the node it leads to, 0 for a node no edge leaves, whether a word ends there, and the number of
+// words whose path runs through it, from which the number of a word ( its position in alphabetical
+// order ) is counted on the way to it: the words of the earlier siblings of every edge taken, plus
+// one for every word ending on the path before it.
+//
+// DawgBuilder writes the edges leaving a node before any edge leading to it, so every target lies
+// below the edge that refers to it and the graph cannot hold a cycle.
+//
+// MappedDawg maps the file and reads the edges in place, so opening a dictionary costs one pass
+// over the edges to check them and no parsing whatever its size, and every process checking
+// against the same file shares one copy of it.
+
+#ifndef DAWG_FILE_H
+#define DAWG_FILE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "WordSet.h"
+#include "LengthIndex.h"
+#include "WordTrie.h"
+
+const uint32_t dawgVersion = 1;
+const size_t dawgHeaderBytes = 32;
+
+// an edge of a DAWG file
+struct DawgEdge
+{
+    enum Flags { lastEdge = 1, finalTarget = 2 };
+
+    uint32_t target;   // the first edge leaving the node the edge leads to, 0 if none does
+    uint32_t numWords; // the number of words whose path runs through the edge
+    char letter;
+    uint8_t flags;     // lastEdge if no sibling follows, finalTarget if a word ends where it leads
+    uint16_t reserved; // zero
+};
+
+static_assert(sizeof(DawgEdge) == 12, "a DawgEdge is 12 bytes in the file");
+
+class DawgBuilder
+{
+public:
+    DawgBuilder()
+        : edges(1, DawgEdge()), path(1)
+    {
+        resizeRegister(10);
+    }
+
+    // adds word[ 0 .. length - 1 ], which must not precede the word added before it in alphabetical
+    // order; returns false if it does. An empty word or a repeat of the word before is skipped.
+    bool insert(const char* word, size_t length)
+    {
+        size_t prefix = commonPrefix(word, lastWord.data(), std::min(length, lastWord.size()));
+        if (length == 0 || (prefix == length && length == lastWord.size()))
+            return true;
+
+        // word follows lastWord if lastWord is a prefix of it or it has the greater letter where they differ
+        if (prefix == length || (prefix < lastWord.size() &&
+            static_cast< unsigned char >(word[prefix]) < static_cast< unsigned char >(lastWord[prefix])))
+            return false;
+
+        // the nodes below the shared prefix can take no more words
+        minimize(prefix);
+        lastWord.assign(word, length);
+        for (size_t depth = prefix + 1; depth <= length; depth++)
+        {
+            if (path.size() <= depth)
+                path.resize(depth + 1);
+            path[depth].final = false;
+            path[depth].edges.clear();
+        }
+        pathLength = length;
+        path[length].final = true;
+        numWords++;
+        maxLength = std::max(maxLength, length);
+        return true;
+    }
+
+    bool insert(const std::string& word)
+    {
+        return insert(word.data(), word.size());
+    }
+
+    // writes the DAWG of the words inserted to fileName; returns false if the file cannot be
+    // written. No word can be inserted afterwards.
+    bool write(const std::string& fileName)
+    {
+        minimize(0);
+        uint32_t rootEdge = registerNode(path[0]);
+        path[0].edges.clear();
+
+        const char magic[4] = { 'D', 'A', 'W', 'G' };
+        uint32_t header[7] = { dawgVersion, static_cast< uint32_t >(numWords),
+            static_cast< uint32_t >(edges.size()), rootEdge, static_cast< uint32_t >(maxLength), 0, 0 };
+
+        std::ofstream outFile(fileName, std::ios::out | std::ios::binary);
+        outFile.write(magic, 4);
+        outFile.write(reinterpret_cast< const char* >(header), sizeof(header));
+        outFile.write(reinterpret_cast< const char* >(edges.data()), edges.size() * sizeof(DawgEdge));
+        return static_cast< bool >(outFile);
+    }
+
+    // returns the number of edges of the minimized graph so far
+    size_t size() const
+    {
+        return edges.size();
+    }
+
+private:
+    // a node on the path of the last word, not yet merged into the graph; its last edge is still
+    // missing while the node below it is on the path
+    struct PathNode
+    {
+        bool final = false;
+        std::vector< DawgEdge > edges;
+    };
+
+    // merges the nodes of the path below depth into the graph, deepest first
+    void minimize(size_t depth)
+    {
+        for (; pathLength > depth; pathLength--)
+        {
+            PathNode& node = path[pathLength];
+            DawgEdge edge = DawgEdge();
+            edge.letter = lastWord[pathLength - 1];
+            edge.flags = node.final ? DawgEdge::finalTarget : 0;
+            edge.numWords = node.final ? 1 : 0;
+            for (size_t i = 0; i < node.edges.size(); i++)
+                edge.numWords += node.edges[i].numWords;
+            edge.target = registerNode(node);
+
+            path[pathLength - 1].edges.push_back(edge);
+        }
+    }
+
+    // returns the first edge of a node of the graph equal to node, adding one if there is none
+    uint32_t registerNode(PathNode& node)
+    {
+        if (node.edges.empty())
+            return 0;
+
+        node.edges.back().flags |= DawgEdge::lastEdge;
+        size_t numBytes = node.edges.size() * sizeof(DawgEdge);
+        uint64_t hash = hashWord(reinterpret_cast< const char* >(node.edges.data()), numBytes);
+        size_t mask = table.size() - 1;
+        size_t i = static_cast< size_t >(hash) & mask;
+        // only the last edge of a node is flagged lastEdge, so equal bytes are an equal node
+        for (; table[i] != 0; i = (i + 1) & mask)
+            if (table[i] + node.edges.size() <= edges.size() && memcmp(&edges[table[i]], node.edges.data(), numBytes) == 0)
+                return table[i];
+
+        uint32_t first = static_cast< uint32_t >(edges.size());
+        edges.insert(edges.end(), node.edges.begin(), node.edges.end());
+        table[i] = first;
+        if (++numRegistered * 2 > table.size())
+            resizeRegister(bits + 1);
+        return first;
+    }
+
+    // returns the number of edges leaving the node whose first edge is first
+    size_t runLength(uint32_t first) const
+    {
+        size_t n = first;
+        while (!(edges[n].flags & DawgEdge::lastEdge))
+            n++;
+        return n - first + 1;
+    }
+
+    // makes the register 2^newBits slots and enters the nodes of the graph again
+    void resizeRegister(int newBits)
+    {
+        bits = newBits;
+        table.assign(static_cast< size_t >(1) << bits, 0);
+        size_t mask = table.size() - 1;
+        for (size_t first = 1; first < edges.size(); first += runLength(static_cast< uint32_t >(first)))
+        {
+            size_t numBytes = runLength(static_cast< uint32_t >(first)) * sizeof(DawgEdge);
+            size_t i = static_cast< size_t >(hashWord(reinterpret_cast< const char* >(&edges[first]), numBytes)) & mask;
+            while (table[i] != 0)
+                i = (i + 1) & mask;
+            table[i] = static_cast< uint32_t >(first);
+        }
+    }
+
+    std::vector< DawgEdge > edges;   // the edges of the graph, edge 0 unused, as they are written
+    std::vector< uint32_t > table;   // the register: the first edges of the nodes by their hash, 0 if empty
+    int bits = 0;                    // the register has 2^bits slots
+    size_t numRegistered = 0;        // the number of nodes in the register
+    std::vector< PathNode > path;    // path[ d ] is the node of the first d letters of lastWord
+    size_t pathLength = 0;           // the nodes path[ 1 .. pathLength ] are in use
+    std::string lastWord;
+    size_t numWords = 0;
+    size_t maxLength = 0;
+};
+
+// writes the DAWG of words, in any order and with repeats, to fileName; returns false if the file
+// cannot be written
+inline bool writeDawg(const std::string& fileName, std::vector< std::string > words)
+{
+    std::sort(words.begin(), words.end());
+
+    DawgBuilder builder;
+    for (size_t i = 0; i < words.size(); i++)
+        builder.insert(words[i]);
+
+    return builder.write(fileName);
+}
+
+class MappedDawg
+{
+public:
+    MappedDawg() = default;
+
+    MappedDawg(const MappedDawg&) = delete;
+    MappedDawg& operator=(const MappedDawg&) = delete;
+
+    ~MappedDawg()
+    {
+        close();
+    }
+
+    // maps fileName, a file written by DawgBuilder; returns false if it cannot be mapped, is not
+    // a DAWG file or its edges do not form one ( see validEdges )
+    bool open(const std::string& fileName)
+    {
+        close();
+
+#ifdef _WIN32
+        HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER fileSize;
+        HANDLE mapping = GetFileSizeEx(file, &fileSize) && fileSize.QuadPart >= static_cast< LONGLONG >(dawgHeaderBytes) ?
+            CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+        if (mapping != nullptr)
+        {
+            data = static_cast< const char* >(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            mappedBytes = data != nullptr ? static_cast< size_t >(fileSize.QuadPart) : 0;
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+#else
+        int file = ::open(fileName.c_str(), O_RDONLY);
+        if (file < 0)
+            return false;
+
+        struct stat status;
+        if (fstat(file, &status) == 0 && status.st_size >= static_cast< off_t >(dawgHeaderBytes))
+        {
+            void* view = mmap(nullptr, static_cast< size_t >(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+            if (view != MAP_FAILED)
+            {
+                data = static_cast< const char* >(view);
+                mappedBytes = static_cast< size_t >(status.st_size);
+            }
+        }
+        ::close(file);
+#endif
+
+        if (data == nullptr)
+            return false;
+
+        uint32_t header[5];
+        memcpy(header, data + 4, sizeof(header));
+        numWords = header[1];
+        numEdges = header[2];
+        rootEdge = header[3];
+        longestWord = header[4];
+        edges = reinterpret_cast< const DawgEdge* >(data + dawgHeaderBytes);
+
+        if (memcmp(data, "DAWG", 4) != 0 || header[0] != dawgVersion || numEdges == 0 ||
+            mappedBytes != dawgHeaderBytes + static_cast< size_t >(numEdges) * sizeof(DawgEdge) || rootEdge >= numEdges ||
+            !validEdges())
+        {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    // unmaps the file
+    void close()
+    {
+        if (data != nullptr)
+#ifdef _WIN32
+            UnmapViewOfFile(data);
+#else
+            munmap(const_cast< char* >(data), mappedBytes);
+#endif
+
+        data = nullptr;
+        edges = nullptr;
+        mappedBytes = 0;
+        numWords = numEdges = rootEdge = longestWord = 0;
+    }
+
+    // returns the number of words
+    size_t size() const
+    {
+        return numWords;
+    }
+
+    // returns the length of the longest word
+    size_t maxLength() const
+    {
+        return longestWord;
+    }
+
+    // returns the number of bytes mapped
+    size_t bytes() const
+    {
+        return mappedBytes;
+    }
+
+    // returns the number of word[ 0 .. length - 1 ] in alphabetical order, or size() if it is not
+    // in the dictionary
+    size_t number(const char* word, size_t length) const
+    {
+        size_t count = 0;
+        uint32_t node = rootEdge;
+        for (size_t i = 0; i < length; i++)
+        {
+            if (node == 0)
+                return numWords;
+
+            // the words through the earlier edges come before word
+            const DawgEdge* edge = edges + node;
+            while (edge->letter != word[i])
+            {
+                if ((edge->flags & DawgEdge::lastEdge) ||
+                    static_cast< unsigned char >(edge->letter) > static_cast< unsigned char >(word[i]))
+                    return numWords;
+                count += edge->numWords;
+                edge++;
+            }
+
+            if (i + 1 == length)
+                return (edge->flags & DawgEdge::finalTarget) ? count : numWords;
+
+            // and so does the word ending here
+            count += (edge->flags & DawgEdge::finalTarget) ? 1 : 0;
+            node = edge->target;
+        }
+
+        return numWords;
+    }
+
+    // returns true if and only if word[ 0 .. length - 1 ] is in the dictionary
+    bool contains(const char* word, size_t length) const
+    {
+        return number(word, length) != numWords;
+    }
+
+    bool contains(const std::string& word) const
+    {
+        return contains(word.data(), word.size());
+    }
+
+    // puts word number, provided that number < size(), into word[ 0 .. maxLength() - 1 ] and
+    // returns its length
+    size_t word(size_t number, char* word) const
+    {
+        size_t length = 0;
+        const DawgEdge* edge = edges + rootEdge;
+        for (;;)
+        {
+            while (number >= edge->numWords)
+            {
+                number -= edge->numWords;
+                edge++;
+            }
+
+            word[length++] = edge->letter;
+            if (edge->flags & DawgEdge::finalTarget)
+            {
+                if (number == 0)
+                    return length;
+                number--;
+            }
+
+            edge = edges + edge->target;
+        }
+    }
+
+    // calls visit( number, distance ) for every word within maxDistance edits of
+    // wordToCheck[ 0 .. length - 1 ], in alphabetical order, as WordTrie::walk does
+    template< typename Visit >
+    void walk(const char* wordToCheck, size_t length, int maxDistance, Visit visit) const
+    {
+        // rows[ d * ( length + 1 ) + j ] as in WordTrie::walk
+        static thread_local std::vector< int > rows;
+        static thread_local std::vector< Step > stack;
+        size_t width = length + 1;
+        if (rows.size() < 2 * width)
+            rows.resize(2 * width);
+        firstBandRow(rows.data(), length, maxDistance);
+
+        stack.clear();
+        if (rootEdge != 0)
+            pushEdges(stack, rootEdge, 1, 0);
+        while (!stack.empty())
+        {
+            Step step = stack.back();
+            stack.pop_back();
+
+            const DawgEdge& edge = edges[step.edge];
+            int* row = &rows[step.depth * width];
+            if (nextBandRow(row - width, row, wordToCheck, length, step.depth, edge.letter, maxDistance) > maxDistance)
+                continue;
+
+            bool final = (edge.flags & DawgEdge::finalTarget) != 0;
+            if (final && step.depth + maxDistance >= length && row[length] <= maxDistance)
+                visit(step.number, row[length]);
+
+            if (edge.target != 0)
+            {
+                if (rows.size() < (step.depth + 2) * width)
+                    rows.resize((step.depth + 2) * width);
+                pushEdges(stack, edge.target, step.depth + 1, step.number + (final ? 1 : 0));
+            }
+        }
+    }
+
+private:
+    // returns true if the edges form a graph number, word and walk can follow without leaving it:
+    // every node is a run of siblings ending in a lastEdge, every target is the first edge of a
+    // node written before the edge, the words counted through every edge add up, and no word is
+    // longer than maxLength()
+    bool validEdges() const
+    {
+        // words[ first ] and height[ first ] are the number of words below the node whose first
+        // edge is first and the length of the longest of them; height 0 marks no node
+        std::vector< uint32_t > words(numEdges, 0);
+        std::vector< uint32_t > height(numEdges, 0);
+        for (uint32_t first = 1, e = 1; e < numEdges; e++)
+        {
+            const DawgEdge& edge = edges[e];
+            bool final = (edge.flags & DawgEdge::finalTarget) != 0;
+            if ((edge.flags & ~(DawgEdge::lastEdge | DawgEdge::finalTarget)) != 0 || edge.reserved != 0 ||
+                (edge.target != 0 && (edge.target >= first || height[edge.target] == 0)) ||
+                edge.numWords != (final ? 1u : 0u) + words[edge.target])
+                return false;
+
+            uint64_t runWords = static_cast< uint64_t >(words[first]) + edge.numWords;
+            if (runWords > numWords)
+                return false;
+            words[first] = static_cast< uint32_t >(runWords);
+            height[first] = std::max(height[first], height[edge.target] + 1);
+
+            if (edge.flags & DawgEdge::lastEdge)
+                first = e + 1;
+            else if (e + 1 == numEdges)
+                return false;
+        }
+
+        if (rootEdge == 0)
+            return numWords == 0;
+        return height[rootEdge] != 0 && words[rootEdge] == numWords && height[rootEdge] <= longestWord;
+    }
+
+    // an edge for walk to follow, the depth of the node it leads to and the number of the first
+    // word through it
+    struct Step
+    {
+        uint32_t edge;
+        uint32_t depth;
+        size_t number;
+    };
+
+    // pushes the edges leaving the node whose first edge is first onto stack, last first, so they
+    // are taken in alphabetical order; the words through them are numbered from number
+    void pushEdges(std::vector< Step >& stack, uint32_t first, uint32_t depth, size_t number) const
+    {
+        size_t end = first;
+        size_t numWordsBelow = 0;
+        for (;; end++)
+        {
+            numWordsBelow += edges[end].numWords;
+            if (edges[end].flags & DawgEdge::lastEdge)
+                break;
+        }
+
+        for (size_t e = end + 1; e > first; e--)
+        {
+            numWordsBelow -= edges[e - 1].numWords;
+            stack.push_back(Step{ static_cast< uint32_t >(e - 1), depth, number + numWordsBelow });
+        }
+    }
+
+    const char* data = nullptr;      // the mapped file
+    const DawgEdge* edges = nullptr; // the edges of the file
+    size_t mappedBytes = 0;
+    uint32_t numWords = 0;
+    uint32_t numEdges = 0;
+    uint32_t rootEdge = 0;
+    uint32_t longestWord = 0;
+};
+
+// calls emit( word, length, distance ) for every word of dawg within maxDistance edits of
+// wordToCheck, in ascending order of distance and then in alphabetical order
+template< typename Emit >
+void nearWords(const MappedDawg& dawg, const char* wordToCheck, size_t length, int maxDistance, Emit emit)
+{
+    // found holds distance * 2^32 + word number
+    static thread_local std::vector< uint64_t > found;
+    static thread_local std::vector< char > word;
+    found.clear();
+    dawg.walk(wordToCheck, length, maxDistance, [&](size_t number, int distance)
+    {
+        found.push_back(static_cast< uint64_t >(distance) << 32 | number);
+    });
+
+    std::sort(found.begin(), found.end());
+    word.resize(dawg.maxLength() + 1);
+    for (size_t i = 0; i < found.size(); i++)
+    {
+        size_t wordLength = dawg.word(static_cast< uint32_t >(found[i]), word.data());
+        emit(word.data(), wordLength, static_cast< int >(found[i] >> 32));
+    }
+}
+
+#endif
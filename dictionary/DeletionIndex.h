@@ -0,0 +1,588 @@
+// DeletionIndex.h
+// Words near a word found through the strings left by deleting letters ( symmetric deletion ).
+//
+// Two words are within edit distance d of each other only if deleting at most d letters from each
+// leaves the same string. The index lists every word under the strings left by deleting at most
+// maxDistance of its letters ( the word itself included ), so the words near a query are among those
+// listed under the strings left by deleting letters from the query, and finding them takes one hash
+// lookup for each such string instead of a pass over the dictionary.
+//
+// Strings are not stored, only 32 bits of their hashes: the words listed under a hash are
+// candidates, and every candidate is compared with the query before it is reported, so strings of
+// equal hash cost a comparison and nothing more. A slot of the table is 8 bytes, the tag of a hash
+// and either the one word listed under it ( most strings come from one word ) or where its list
+// starts; a word is a 24-byte record holding a word of up to 23 letters itself. All the lookups of
+// a query are started before the first is used, so their cache misses overlap.
+//
+// substitutionWords, insertionWords and deletionWords report the words spellCheck1, spellCheck2 and
+// spellCheck3 of hw9 report, in the same order and as many times, as their LengthIndex namesakes.
+
+#ifndef DELETION_INDEX_H
+#define DELETION_INDEX_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "WordSet.h"
+#include "LengthIndex.h"
+
+// asks the processor to load the cache line of address
+inline void prefetchLine(const void* address)
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(address);
+#else
+    (void)address;
+#endif
+}
+
+// returns the edit distance ( insertions, deletions and substitutions ) between first[ 0 .. firstLength - 1 ]
+// and second[ 0 .. secondLength - 1 ] if it is at most limit, and limit + 1 otherwise
+inline int editDistance(const char* first, size_t firstLength, const char* second, size_t secondLength, int limit)
+{
+    if ((firstLength > secondLength ? firstLength - secondLength : secondLength - firstLength) > static_cast< size_t >(limit))
+        return limit + 1;
+
+    // row[ j ] is the distance between the first i characters of first and the first j of second
+    int stackRow[64];
+    std::vector< int > heapRow;
+    int* row = stackRow;
+    if (secondLength >= 64)
+    {
+        heapRow.resize(secondLength + 1);
+        row = heapRow.data();
+    }
+
+    for (size_t j = 0; j <= secondLength; j++)
+        row[j] = static_cast< int >(j);
+
+    for (size_t i = 1; i <= firstLength; i++)
+    {
+        int diagonal = row[0];
+        row[0] = static_cast< int >(i);
+        int rowMinimum = row[0];
+        for (size_t j = 1; j <= secondLength; j++)
+        {
+            int above = row[j];
+            row[j] = std::min(std::min(above, row[j - 1]) + 1, diagonal + (first[i - 1] != second[j - 1]));
+            diagonal = above;
+            rowMinimum = std::min(rowMinimum, row[j]);
+        }
+
+        if (rowMinimum > limit)
+            return limit + 1;
+    }
+
+    return std::min(row[secondLength], limit + 1);
+}
+
+// calls visit( variant, length - 1 ) for every distinct string left by deleting one character of
+// word[ 0 .. length - 1 ]; deleting any letter of a run of equal letters leaves the same string
+template< typename Visit >
+void forEachDeletion(const char* word, size_t length, Visit visit)
+{
+    if (length == 0)
+        return;
+
+    char stackBuffer[64];
+    std::string heapBuffer;
+    char* variant = stackBuffer;
+    if (length > sizeof(stackBuffer))
+    {
+        heapBuffer.resize(length);
+        variant = &heapBuffer[0];
+    }
+
+    // variant is word without word[ p ]; moving to the next p changes one character
+    memcpy(variant, word + 1, length - 1);
+    for (size_t p = 0; p < length; p++)
+    {
+        if (p > 0)
+            variant[p - 1] = word[p - 1];
+        if (p == 0 || word[p] != word[p - 1])
+            visit(static_cast< const char* >(variant), length - 1);
+    }
+}
+
+// the base and the final mix of deletionHash
+const uint64_t deletionHashBase = 0x100000001B3ULL;
+
+inline uint64_t mixDeletionHash(uint64_t sum, size_t length)
+{
+    uint64_t hash = sum + length * 0x9E3779B97F4A7C15ULL;
+    hash ^= hash >> 31;
+    hash *= 0xD6E8FEB86659FD93ULL;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+// returns the hash of word[ 0 .. length - 1 ] used by DeletionIndex: the sum of ( word[ i ] + 1 ) *
+// deletionHashBase^( length - 1 - i ), mixed, so the hashes of all strings left by deleting one
+// letter take O( length ) together ( forEachDeletionHash ) where hashing each takes O( length^2 )
+inline uint64_t deletionHash(const char* word, size_t length)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < length; i++)
+        sum = sum * deletionHashBase + static_cast< unsigned char >(word[i]) + 1;
+    return mixDeletionHash(sum, length);
+}
+
+// calls visit( hash ) with deletionHash of every distinct string left by deleting one character of
+// word[ 0 .. length - 1 ], in the order of forEachDeletion
+template< typename Visit >
+void forEachDeletionHash(const char* word, size_t length, Visit visit)
+{
+    if (length == 0)
+        return;
+
+    // suffix[ j ] is the sum of word[ j .. length - 1 ], power[ k ] = deletionHashBase^k
+    uint64_t stackSuffix[65];
+    uint64_t stackPower[65];
+    std::vector< uint64_t > heapSuffix;
+    std::vector< uint64_t > heapPower;
+    uint64_t* suffix = stackSuffix;
+    uint64_t* power = stackPower;
+    if (length >= 65)
+    {
+        heapSuffix.resize(length + 1);
+        heapPower.resize(length + 1);
+        suffix = heapSuffix.data();
+        power = heapPower.data();
+    }
+
+    suffix[length] = 0;
+    power[0] = 1;
+    for (size_t j = length; j > 0; j--)
+    {
+        suffix[j - 1] = suffix[j] + (static_cast< unsigned char >(word[j - 1]) + 1) * power[length - j];
+        power[length - j + 1] = power[length - j] * deletionHashBase;
+    }
+
+    // prefix is the sum of word[ 0 .. p - 1 ]
+    uint64_t prefix = 0;
+    for (size_t p = 0; p < length; p++)
+    {
+        if (p == 0 || word[p] != word[p - 1])
+            visit(mixDeletionHash(prefix * power[length - 1 - p] + suffix[p + 1], length - 1));
+        prefix = prefix * deletionHashBase + static_cast< unsigned char >(word[p]) + 1;
+    }
+}
+
+class DeletionIndex
+{
+public:
+    // words near a query are found up to maxDistance edits ( 1 or 2 ) away
+    explicit DeletionIndex(int maxDistance = 1)
+        : maxDistance(maxDistance < 1 ? 1 : maxDistance > 2 ? 2 : maxDistance)
+    {
+    }
+
+    // adds word[ 0 .. length - 1 ] as the next word of the dictionary; build must be called after
+    // the last word is inserted and before the first query
+    void insert(const char* word, size_t length)
+    {
+        uint32_t number = static_cast< uint32_t >(records.size());
+        records.push_back(Record());
+        Record& record = records.back();
+        if (length <= inlineLength)
+        {
+            record.length = static_cast< uint8_t >(length);
+            memcpy(record.chars, word, length);
+        }
+        else
+        {
+            uint64_t offset = pool.size();
+            uint64_t pooledLength = length;
+            pool.resize(pool.size() + sizeof(pooledLength) + length);
+            memcpy(&pool[offset], &pooledLength, sizeof(pooledLength));
+            memcpy(&pool[offset + sizeof(pooledLength)], word, length);
+
+            record.length = pooledWord;
+            memcpy(record.chars, &offset, sizeof(offset));
+        }
+
+        entries.push_back(Entry{ deletionHash(word, length), number });
+        forEachDeletionHash(word, length, [&](uint64_t hash) { entries.push_back(Entry{ hash, number }); });
+        if (maxDistance == 2)
+            forEachDeletion(word, length, [&](const char* variant, size_t variantLength)
+            {
+                forEachDeletionHash(variant, variantLength, [&](uint64_t hash) { entries.push_back(Entry{ hash, number }); });
+            });
+    }
+
+    void insert(const std::string& word)
+    {
+        insert(word.data(), word.size());
+    }
+
+    // indexes the words inserted so far
+    void build()
+    {
+        static std::atomic< unsigned long long > numBuilds(0);
+        thisBuild = ++numBuilds;
+
+        std::sort(entries.begin(), entries.end(), [](const Entry& first, const Entry& second)
+        {
+            return first.hash != second.hash ? first.hash < second.hash : first.number < second.number;
+        });
+
+        size_t numHashes = 0;
+        for (size_t i = 0; i < entries.size(); i++)
+            numHashes += i == 0 || entries[i].hash != entries[i - 1].hash;
+
+        // at most three quarters of the slots are used
+        int bits = 4;
+        while (bits < 32 && (static_cast< size_t >(3) << bits) < 4 * numHashes)
+            bits++;
+        shift = 64 - bits;
+        slots.assign(static_cast< size_t >(1) << bits, Slot());
+
+        // a slot holds the top 32 + bits bits of a hash ( its place and its tag ), and the words of
+        // all hashes that agree on those are one list
+        size_t mask = slots.size() - 1;
+        lists.clear();
+        std::vector< uint32_t > list;
+        for (size_t i = 0; i < entries.size(); )
+        {
+            uint64_t prefix = entries[i].hash >> (shift - 32);
+            list.clear();
+            for (; i < entries.size() && entries[i].hash >> (shift - 32) == prefix; i++)
+                list.push_back(entries[i].number);
+            if (!std::is_sorted(list.begin(), list.end()))
+                std::sort(list.begin(), list.end());
+            list.erase(std::unique(list.begin(), list.end()), list.end());
+
+            // a lookup of this hash stops at the first slot of its tag, so a list whose tag is met on the
+            // way joins the list found there ( its other words fail the comparison with the query )
+            size_t j = static_cast< size_t >(prefix >> 32);
+            while (slots[j].value != emptySlot && slots[j].tag != static_cast< uint32_t >(prefix))
+                j = (j + 1) & mask;
+            if (slots[j].value != emptySlot)
+            {
+                size_t count;
+                uint32_t single;
+                const uint32_t* numbers = candidates(slots[j], count, single);
+                list.insert(list.end(), numbers, numbers + count);
+                std::sort(list.begin(), list.end());
+                list.erase(std::unique(list.begin(), list.end()), list.end());
+            }
+
+            slots[j].tag = static_cast< uint32_t >(prefix);
+            if (list.size() == 1)
+                slots[j].value = list[0] | singleWord;
+            else
+            {
+                slots[j].value = static_cast< uint32_t >(lists.size());
+                lists.push_back(static_cast< uint32_t >(list.size()));
+                lists.insert(lists.end(), list.begin(), list.end());
+            }
+        }
+
+        std::vector< Entry >().swap(entries);
+    }
+
+    // returns a number that differs for every build of every index
+    unsigned long long buildNumber() const
+    {
+        return thisBuild;
+    }
+
+    // returns the number of words
+    size_t size() const
+    {
+        return records.size();
+    }
+
+    // returns word number of the dictionary and sets length to its length
+    const char* word(uint32_t number, size_t& length) const
+    {
+        const Record& record = records[number];
+        if (record.length != pooledWord)
+        {
+            length = record.length;
+            return record.chars;
+        }
+
+        uint64_t offset;
+        memcpy(&offset, record.chars, sizeof(offset));
+        uint64_t pooledLength;
+        memcpy(&pooledLength, &pool[offset], sizeof(pooledLength));
+        length = static_cast< size_t >(pooledLength);
+        return &pool[offset + sizeof(pooledLength)];
+    }
+
+    // starts loading word number
+    void prefetchWord(uint32_t number) const
+    {
+        prefetchLine(&records[number]);
+    }
+
+    // returns the largest distance of a query
+    int distance() const
+    {
+        return maxDistance;
+    }
+
+    // starts loading the slot of hash, for candidates( hash, ... ) a little later
+    void prefetchSlot(uint64_t hash) const
+    {
+        prefetchLine(&slots[hash >> shift]);
+    }
+
+    // returns the words listed under hash, in ascending order, and sets count to their number;
+    // single is scratch space for a list of one word
+    const uint32_t* candidates(uint64_t hash, size_t& count, uint32_t& single) const
+    {
+        uint32_t tag = static_cast< uint32_t >(hash >> (shift - 32));
+        size_t mask = slots.size() - 1;
+        for (size_t j = hash >> shift; slots[j].value != emptySlot; j = (j + 1) & mask)
+            if (slots[j].tag == tag)
+                return candidates(slots[j], count, single);
+
+        count = 0;
+        return nullptr;
+    }
+
+    // returns the number of bytes of the words, the lists and the table
+    size_t bytes() const
+    {
+        return records.size() * sizeof(Record) + pool.size() + lists.size() * sizeof(uint32_t) + slots.size() * sizeof(Slot);
+    }
+
+private:
+    static const size_t inlineLength = 23;             // words of at most this many letters are kept in their records
+    static const uint8_t pooledWord = 255;             // the length of a record whose word is in the pool
+    static const uint32_t emptySlot = 0xFFFFFFFF;      // the value of a slot without a hash
+    static const uint32_t singleWord = 0x80000000;     // the flag of a value that is a word, not a list
+
+    struct Entry
+    {
+        uint64_t hash;   // the hash of a string left by deleting letters
+        uint32_t number; // the word it is left from
+    };
+
+    struct Record
+    {
+        uint8_t length = 0;        // the length of an inline word, or pooledWord
+        char chars[inlineLength];  // an inline word, or the offset of a pooled word
+    };
+
+    struct Slot
+    {
+        uint32_t tag = 0;            // 32 bits of the hash below those that place it
+        uint32_t value = emptySlot;  // singleWord | word, or where the list ( count, words ) starts in lists
+    };
+
+    // returns the words of slot, and sets count to their number
+    const uint32_t* candidates(const Slot& slot, size_t& count, uint32_t& single) const
+    {
+        if (slot.value & singleWord)
+        {
+            single = slot.value & ~singleWord;
+            count = 1;
+            return &single;
+        }
+
+        count = lists[slot.value];
+        return &lists[slot.value + 1];
+    }
+
+    int maxDistance;
+    std::vector< Record > records; // the words in dictionary order
+    std::vector< char > pool;      // the words longer than inlineLength, each after its 8-byte length
+    std::vector< Entry > entries;  // ( hash, word ) pairs until build
+    std::vector< uint32_t > lists;
+    std::vector< Slot > slots;
+    int shift = 60;                // the slot of a hash is its top 64 - shift bits
+    unsigned long long thisBuild = 0; // the number of the last build
+};
+
+// the words listed under the strings left by deleting one letter of the last query on a thread;
+// spellCheck1 and spellCheck3 of hw9 ask for the same query in turn, and the second reuses them
+struct DeletionQuery
+{
+    unsigned long long build = 0;    // DeletionIndex::buildNumber of the index asked
+    std::string word;                // the query
+    std::vector< uint32_t > numbers; // the words, in ascending order and each once
+    std::vector< uint32_t > found;   // those of the length asked for
+};
+
+// returns the words of wordWithLength letters listed under the strings left by deleting one letter
+// of wordToCheck[ 0 .. length - 1 ], in ascending order and each once; the vector is reused by later
+// queries on the same thread
+inline std::vector< uint32_t >& deletionCandidates(const DeletionIndex& index, const char* wordToCheck, size_t length,
+    size_t wordLength)
+{
+    static thread_local DeletionQuery query;
+    if (query.build != index.buildNumber() || query.word.size() != length || query.word.compare(0, length, wordToCheck, length) != 0)
+    {
+        query.build = index.buildNumber();
+        query.word.assign(wordToCheck, length);
+
+        // all lookups are started before the first is used
+        static thread_local std::vector< uint64_t > hashes;
+        hashes.clear();
+        forEachDeletionHash(wordToCheck, length, [&](uint64_t hash)
+        {
+            hashes.push_back(hash);
+            index.prefetchSlot(hash);
+        });
+
+        query.numbers.clear();
+        for (size_t h = 0; h < hashes.size(); h++)
+        {
+            size_t count;
+            uint32_t single;
+            const uint32_t* numbers = index.candidates(hashes[h], count, single);
+            for (size_t i = 0; i < count; i++)
+            {
+                query.numbers.push_back(numbers[i]);
+                index.prefetchWord(numbers[i]);
+            }
+        }
+
+        std::sort(query.numbers.begin(), query.numbers.end());
+        query.numbers.erase(std::unique(query.numbers.begin(), query.numbers.end()), query.numbers.end());
+    }
+
+    query.found.clear();
+    for (size_t i = 0; i < query.numbers.size(); i++)
+    {
+        size_t numberLength;
+        index.word(query.numbers[i], numberLength);
+        if (numberLength == wordLength)
+            query.found.push_back(query.numbers[i]);
+    }
+
+    return query.found;
+}
+
+// calls emit( word, length ) for every word of index as long as wordToCheck that differs from it
+// in exactly one character, as spellCheck1 does
+template< typename Emit >
+void substitutionWords(const DeletionIndex& index, const char* wordToCheck, size_t length, Emit emit)
+{
+    // such a word and wordToCheck leave the same string when the differing character is deleted
+    std::vector< uint32_t >& found = deletionCandidates(index, wordToCheck, length, length);
+    for (size_t i = 0; i < found.size(); i++)
+    {
+        size_t wordLength;
+        const char* word = index.word(found[i], wordLength);
+        size_t numDifferences = 0;
+        for (size_t n = 0; n < length && numDifferences < 2; n++)
+            numDifferences += word[n] != wordToCheck[n];
+
+        // spellCheck1 reports wordToCheck itself once for every position
+        if (numDifferences == 1)
+            emit(word, length);
+        else if (numDifferences == 0)
+            for (size_t n = 0; n < length; n++)
+                emit(word, length);
+    }
+}
+
+// calls emit( word, length + 1 ) for every word of index that leaves wordToCheck when one of its
+// characters is deleted, once for every such character, as spellCheck2 does
+template< typename Emit >
+void insertionWords(const DeletionIndex& index, const char* wordToCheck, size_t length, Emit emit)
+{
+    size_t count;
+    uint32_t single;
+    const uint32_t* numbers = index.candidates(deletionHash(wordToCheck, length), count, single);
+    for (size_t i = 0; i < count; i++)
+        index.prefetchWord(numbers[i]);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t wordLength;
+        const char* word = index.word(numbers[i], wordLength);
+        if (wordLength == length + 1)
+            for (size_t j = deletionPositions(word, wordToCheck, length); j > 0; j--)
+                emit(word, wordLength);
+    }
+}
+
+// calls emit( word, length - 1 ) for every word of index left when one character of wordToCheck
+// is deleted, once for every such character, as spellCheck3 does
+template< typename Emit >
+void deletionWords(const DeletionIndex& index, const char* wordToCheck, size_t length, Emit emit)
+{
+    if (length == 0)
+        return;
+
+    std::vector< uint32_t >& found = deletionCandidates(index, wordToCheck, length, length - 1);
+    for (size_t i = 0; i < found.size(); i++)
+    {
+        size_t wordLength;
+        const char* word = index.word(found[i], wordLength);
+        for (size_t j = deletionPositions(wordToCheck, word, wordLength); j > 0; j--)
+            emit(word, wordLength);
+    }
+}
+
+// calls emit( word, length, distance ) for every word of index within maxDistance edits of
+// wordToCheck ( at most index.distance() ), in ascending order of distance and then in dictionary order
+template< typename Emit >
+void nearWords(const DeletionIndex& index, const char* wordToCheck, size_t length, int maxDistance, Emit emit)
+{
+    maxDistance = std::min(maxDistance, index.distance());
+
+    static thread_local std::vector< uint64_t > hashes;
+    hashes.clear();
+    hashes.push_back(deletionHash(wordToCheck, length));
+    forEachDeletionHash(wordToCheck, length, [&](uint64_t hash) { hashes.push_back(hash); });
+    if (maxDistance == 2)
+        forEachDeletion(wordToCheck, length, [&](const char* variant, size_t variantLength)
+        {
+            forEachDeletionHash(variant, variantLength, [&](uint64_t hash) { hashes.push_back(hash); });
+        });
+
+    // deleting p then q leaves what deleting q then p leaves
+    std::sort(hashes.begin(), hashes.end());
+    hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+    for (size_t h = 0; h < hashes.size(); h++)
+        index.prefetchSlot(hashes[h]);
+
+    static thread_local std::vector< uint32_t > candidates;
+    candidates.clear();
+    for (size_t h = 0; h < hashes.size(); h++)
+    {
+        size_t count;
+        uint32_t single;
+        const uint32_t* numbers = index.candidates(hashes[h], count, single);
+        for (size_t i = 0; i < count; i++)
+        {
+            candidates.push_back(numbers[i]);
+            index.prefetchWord(numbers[i]);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    // found holds distance * 2^32 + word number
+    static thread_local std::vector< uint64_t > found;
+    found.clear();
+    for (size_t i = 0; i < candidates.size(); i++)
+    {
+        size_t wordLength;
+        const char* word = index.word(candidates[i], wordLength);
+        int distance = editDistance(wordToCheck, length, word, wordLength, maxDistance);
+        if (distance <= maxDistance)
+            found.push_back(static_cast< uint64_t >(distance) << 32 | candidates[i]);
+    }
+
+    std::sort(found.begin(), found.end());
+    for (size_t i = 0; i < found.size(); i++)
+    {
+        size_t wordLength;
+        const char* word = index.word(static_cast< uint32_t >(found[i]), wordLength);
+        emit(word, wordLength, static_cast< int >(found[i] >> 32));
+    }
+}
+
+#endif
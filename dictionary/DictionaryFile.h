@@ -0,0 +1,84 @@
+// DictionaryFile.h
+// Word lists in the layout of Dictionary.txt ( one word per line ) and random dictionaries.
+//
+// A random word has the length distribution of an English word list ( most words have 6 to 10
+// letters, none more than maxRandomLength ) and letters drawn by their frequency in English
+// text, so that words share prefixes and differ in one letter about as often as real ones.
+
+#ifndef DICTIONARY_FILE_H
+#define DICTIONARY_FILE_H
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "WordSet.h"
+
+// random words have at most this many letters, as the words of the hw9 dictionary
+const int maxRandomLength = 20;
+
+// reads the words of fileName into words; returns false if the file cannot be opened
+inline bool readWords(const std::string& fileName, std::vector< std::string >& words)
+{
+    std::ifstream inFile(fileName, std::ios::in);
+    if (!inFile)
+        return false;
+
+    std::string word;
+    while (inFile >> word)
+        words.push_back(word);
+
+    return true;
+}
+
+// writes words to fileName, one per line; returns false if the file cannot be written
+inline bool writeWords(const std::string& fileName, const std::vector< std::string >& words)
+{
+    std::ofstream outFile(fileName, std::ios::out);
+    for (size_t i = 0; i < words.size(); i++)
+        outFile << words[i] << '\n';
+
+    return static_cast< bool >(outFile);
+}
+
+// returns a random word
+template< typename Engine >
+std::string randomWord(Engine& engine)
+{
+    // the number of words of every length in thousands, and of every letter in a text of 1000
+    static const double lengthWeights[maxRandomLength + 1] =
+        { 0, 0.1, 1, 5, 12, 20, 27, 30, 30, 27, 22, 16, 11, 7, 4, 2.5, 1.5, 0.8, 0.4, 0.2, 0.1 };
+    static const double letterWeights[26] =
+        { 82, 15, 28, 43, 127, 22, 20, 61, 70, 2, 8, 40, 24, 67, 75, 19, 1, 60, 63, 91, 28, 10, 24, 2, 20, 1 };
+
+    static std::discrete_distribution< int > length(lengthWeights, lengthWeights + maxRandomLength + 1);
+    static std::discrete_distribution< int > letter(letterWeights, letterWeights + 26);
+
+    std::string word(length(engine), 'a');
+    for (size_t i = 0; i < word.size(); i++)
+        word[i] = static_cast< char >('a' + letter(engine));
+
+    return word;
+}
+
+// returns numWords distinct random words in ascending order
+inline std::vector< std::string > randomWords(size_t numWords, unsigned long long seed)
+{
+    std::mt19937_64 engine(seed);
+    WordSet seen(numWords);
+    std::vector< std::string > words;
+    words.reserve(numWords);
+    while (words.size() < numWords)
+    {
+        std::string word = randomWord(engine);
+        if (seen.insert(word))
+            words.push_back(word);
+    }
+
+    std::sort(words.begin(), words.end());
+    return words;
+}
+
+#endif
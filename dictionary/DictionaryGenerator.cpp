@@ -0,0 +1,60 @@
+// Writes a random dictionary in the layout of Dictionary.txt read by hw9
+//
+// usage: DictionaryGenerator [options]
+//   --words n    the number of distinct words (40000)
+//   --seed n     the seed of the random number generator (1)
+//   --output f   the file written (Dictionary.txt)
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <string>
+using std::string;
+
+#include <vector>
+using std::vector;
+
+#include <cstdlib>
+#include <cstring>
+
+#include "DictionaryFile.h"
+
+int main(int argc, char* argv[])
+{
+    long long numWords = 40000;
+    unsigned long long seed = 1;
+    string outputFile = "Dictionary.txt";
+
+    for (int i = 1; i < argc; i += 2)
+    {
+        if (i + 1 == argc)
+        {
+            cerr << "usage: DictionaryGenerator [--words n] [--seed n] [--output file]" << endl;
+            return 1;
+        }
+
+        if (strcmp(argv[i], "--words") == 0 && atoll(argv[i + 1]) >= 1)
+            numWords = atoll(argv[i + 1]);
+        else if (strcmp(argv[i], "--seed") == 0)
+            seed = strtoull(argv[i + 1], nullptr, 10);
+        else if (strcmp(argv[i], "--output") == 0)
+            outputFile = argv[i + 1];
+        else
+        {
+            cerr << "usage: DictionaryGenerator [--words n] [--seed n] [--output file]" << endl;
+            return 1;
+        }
+    }
+
+    vector< string > words = randomWords(static_cast< size_t >(numWords), seed);
+    if (!writeWords(outputFile, words))
+    {
+        cerr << "File could not be written" << endl;
+        return 1;
+    }
+
+    cout << words.size() << " words written to " << outputFile << endl;
+    return 0;
+}
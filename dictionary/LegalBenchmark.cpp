@@ -0,0 +1,183 @@
+// Times legal() of hw9-1, hw9-2 and hw9-3 against a WordSet on dictionaries of growing size
+//
+// Half of the queries are words of the dictionary, and half are words with one letter deleted,
+// as hw9 makes them. The linear scans answer far fewer queries than the set, since one query
+// takes them a pass over the whole dictionary ( and hw9-3 copies the dictionary first ).
+//
+// usage: LegalBenchmark [maxWords [dictionary]]
+//   maxWords    random dictionaries of 40000, 10^5, 10^6 and 10^7 words up to this size (10^7)
+//   dictionary  a word list timed before the random ones, such as Dictionary.txt
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <iomanip>
+using std::setw;
+using std::fixed;
+using std::setprecision;
+
+#include <string>
+using std::string;
+
+#include <vector>
+using std::vector;
+
+#include <random>
+using std::mt19937_64;
+
+#include <chrono>
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+#include <cstdlib>
+#include <cstring>
+
+#include "DictionaryFile.h"
+#include "WordSet.h"
+
+// legal() of hw9-1: the dictionary is an array of char[ 21 ]
+bool legalArray(char* wordToCheck, char(*dictionary)[21], int numDicWords);
+
+// legal() of hw9-2: the dictionary is an array of strings
+bool legalStrings(string wordToCheck, string* dictionary, int numDicWords);
+
+// legal() of hw9-3: the dictionary is a vector of strings passed by value
+bool legalVector(string wordToCheck, vector< string > dictionary);
+
+// times every engine on words and prints a row of the table; returns the number of errors
+int timeDictionary(const string& name, const vector< string >& words);
+
+int main(int argc, char* argv[])
+{
+    long long maxWords = argc > 1 ? atoll(argv[1]) : 10000000;
+
+    cout << setw(12) << "dictionary" << setw(12) << "words" << setw(14) << "hw9-1 ns" << setw(14) << "hw9-2 ns"
+        << setw(14) << "hw9-3 ns" << setw(12) << "set ns" << setw(12) << "build s" << setw(10) << "set MB" << endl;
+
+    int numErrors = 0;
+    if (argc > 2)
+    {
+        vector< string > words;
+        if (!readWords(argv[2], words))
+        {
+            cerr << "File could not be opened" << endl;
+            return 1;
+        }
+
+        numErrors += timeDictionary(argv[2], words);
+    }
+
+    const long long sizes[] = { 40000, 100000, 1000000, 10000000 };
+    for (long long size : sizes)
+        if (size <= maxWords)
+            numErrors += timeDictionary("random", randomWords(static_cast< size_t >(size), 1));
+
+    cout << "\nThere are " << numErrors << " errors!\n";
+
+    return numErrors == 0 ? 0 : 1;
+}
+
+bool legalArray(char* wordToCheck, char(*dictionary)[21], int numDicWords)
+{
+    for (int i = 0; i < numDicWords; i++)
+        if (strcmp(dictionary[i], wordToCheck) == 0)
+            return true;
+    return false;
+}
+
+bool legalStrings(string wordToCheck, string* dictionary, int numDicWords)
+{
+    for (int i = 0; i < numDicWords; i++)
+        if (dictionary[i] == wordToCheck)
+            return true;
+    return false;
+}
+
+bool legalVector(string wordToCheck, vector< string > dictionary)
+{
+    for (size_t i = 0; i < dictionary.size(); i++)
+        if (dictionary[i] == wordToCheck)
+            return true;
+    return false;
+}
+
+// times every engine on words and prints a row of the table; returns the number of errors
+int timeDictionary(const string& name, const vector< string >& words)
+{
+    int numDicWords = static_cast< int >(words.size());
+
+    // the queries: every other one has a letter deleted
+    mt19937_64 engine(2);
+    const int numQueries = 1 << 20;
+    vector< string > queries(numQueries);
+    for (int q = 0; q < numQueries; q++)
+    {
+        queries[q] = words[engine() % words.size()];
+        if (q % 2 == 1)
+            queries[q].erase(engine() % queries[q].size(), 1);
+    }
+
+    // a scan answers only as many queries as take about 2 * 10^8 word comparisons
+    int numScanQueries = static_cast< int >(std::min< long long >(numQueries, std::max< long long >(2, 200000000LL / numDicWords)));
+    int numCopyQueries = std::max(2, numScanQueries / 20);
+
+    char(*dictionary)[21] = new char[numDicWords][21];
+    for (int i = 0; i < numDicWords; i++)
+    {
+        strncpy(dictionary[i], words[i].c_str(), 20);
+        dictionary[i][20] = '\0';
+    }
+
+    steady_clock::time_point start = steady_clock::now();
+    WordSet wordSet(words.size());
+    for (int i = 0; i < numDicWords; i++)
+        wordSet.insert(words[i]);
+    double buildSeconds = duration< double >(steady_clock::now() - start).count();
+
+    // expected[ q ] is the answer of the set, checked against every scan
+    vector< bool > expected(numQueries);
+    int numErrors = 0;
+
+    start = steady_clock::now();
+    for (int q = 0; q < numQueries; q++)
+        expected[q] = wordSet.contains(queries[q]);
+    double setSeconds = duration< double >(steady_clock::now() - start).count();
+
+    start = steady_clock::now();
+    for (int q = 0; q < numScanQueries; q++)
+    {
+        char wordToCheck[21];
+        strncpy(wordToCheck, queries[q].c_str(), 20);
+        wordToCheck[20] = '\0';
+        if (legalArray(wordToCheck, dictionary, numDicWords) != expected[q])
+            numErrors++;
+    }
+    double arraySeconds = duration< double >(steady_clock::now() - start).count();
+
+    start = steady_clock::now();
+    for (int q = 0; q < numScanQueries; q++)
+        if (legalStrings(queries[q], const_cast< string* >(words.data()), numDicWords) != expected[q])
+            numErrors++;
+    double stringSeconds = duration< double >(steady_clock::now() - start).count();
+
+    start = steady_clock::now();
+    for (int q = 0; q < numCopyQueries; q++)
+        if (legalVector(queries[q], words) != expected[q])
+            numErrors++;
+    double vectorSeconds = duration< double >(steady_clock::now() - start).count();
+
+    delete[] dictionary;
+
+    cout << fixed << setprecision(1);
+    cout << setw(12) << name << setw(12) << numDicWords
+        << setw(14) << arraySeconds * 1e9 / numScanQueries
+        << setw(14) << stringSeconds * 1e9 / numScanQueries
+        << setw(14) << vectorSeconds * 1e9 / numCopyQueries
+        << setw(12) << setSeconds * 1e9 / numQueries
+        << setprecision(3) << setw(12) << buildSeconds
+        << setprecision(1) << setw(10) << wordSet.bytes() / 1048576.0 << endl;
+
+    return numErrors;
+}
@@ -0,0 +1,143 @@
+// LengthIndex.h
+// The words of a dictionary grouped by length, and the words one edit away from a word.
+//
+// The words of one length are stored back to back without terminators, in the order they were
+// inserted, so a bucket is one array of fixed stride: word i of length L starts at character
+// i * L. The index is built once when the dictionary is read, and a query walks the bucket it
+// needs in place instead of scanning the dictionary and copying the words of that length.
+//
+// substitutionWords, insertionWords and deletionWords report the words spellCheck1, spellCheck2
+// and spellCheck3 of hw9 report, in the same order and as many times: spellCheck2 and spellCheck3
+// try every position of the edit, so a word reachable at several positions ( "book" from "bok" )
+// is reported once for each. A word is compared in one pass from the front and one from the back
+// instead of once for every position.
+
+#ifndef LENGTH_INDEX_H
+#define LENGTH_INDEX_H
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+class LengthIndex
+{
+public:
+    // adds word[ 0 .. length - 1 ] after the words of the same length
+    void insert(const char* word, size_t length)
+    {
+        if (buckets.size() <= length)
+            buckets.resize(length + 1);
+
+        buckets[length].insert(buckets[length].end(), word, word + length);
+    }
+
+    void insert(const std::string& word)
+    {
+        insert(word.data(), word.size());
+    }
+
+    // returns the number of words of length
+    size_t count(size_t length) const
+    {
+        return length == 0 || length >= buckets.size() ? 0 : buckets[length].size() / length;
+    }
+
+    // returns the words of length; word i starts at words( length ) + i * length
+    const char* words(size_t length) const
+    {
+        return length < buckets.size() ? buckets[length].data() : nullptr;
+    }
+
+    // returns the number of bytes of the words
+    size_t bytes() const
+    {
+        size_t numBytes = 0;
+        for (size_t length = 0; length < buckets.size(); length++)
+            numBytes += buckets[length].size();
+        return numBytes;
+    }
+
+private:
+    std::vector< std::vector< char > > buckets; // buckets[ length ] holds the words of length
+};
+
+// returns the number of leading characters shared by first and second, at most length
+inline size_t commonPrefix(const char* first, const char* second, size_t length)
+{
+    size_t n = 0;
+    while (n < length && first[n] == second[n])
+        n++;
+    return n;
+}
+
+// returns the number of trailing characters shared by first[ 0 .. firstLength - 1 ] and
+// second[ 0 .. secondLength - 1 ], at most limit
+inline size_t commonSuffix(const char* first, size_t firstLength, const char* second, size_t secondLength, size_t limit)
+{
+    size_t n = 0;
+    while (n < limit && first[firstLength - 1 - n] == second[secondLength - 1 - n])
+        n++;
+    return n;
+}
+
+// returns the number of positions j such that deleting longer[ j ] leaves shorter,
+// where longer has length + 1 characters and shorter has length
+inline size_t deletionPositions(const char* longer, const char* shorter, size_t length)
+{
+    // deleting longer[ j ] leaves shorter if and only if the first j characters agree
+    // and the last length - j characters agree
+    size_t prefix = commonPrefix(longer, shorter, length);
+    size_t suffix = commonSuffix(longer, length + 1, shorter, length, length);
+    return prefix + suffix < length ? 0 : prefix + suffix - length + 1;
+}
+
+// calls emit( word, length ) for every word of index as long as wordToCheck that differs from it
+// in exactly one character, as spellCheck1 does
+template< typename Emit >
+void substitutionWords(const LengthIndex& index, const char* wordToCheck, size_t length, Emit emit)
+{
+    size_t numWords = index.count(length);
+    const char* word = index.words(length);
+    for (size_t i = 0; i < numWords; i++, word += length)
+    {
+        size_t numDifferences = 0;
+        for (size_t n = 0; n < length && numDifferences < 2; n++)
+            numDifferences += word[n] != wordToCheck[n];
+
+        // spellCheck1 reports wordToCheck itself once for every position
+        if (numDifferences == 1)
+            emit(word, length);
+        else if (numDifferences == 0)
+            for (size_t n = 0; n < length; n++)
+                emit(word, length);
+    }
+}
+
+// calls emit( word, length + 1 ) for every word of index that leaves wordToCheck when one of its
+// characters is deleted, once for every such character, as spellCheck2 does
+template< typename Emit >
+void insertionWords(const LengthIndex& index, const char* wordToCheck, size_t length, Emit emit)
+{
+    size_t numWords = index.count(length + 1);
+    const char* word = index.words(length + 1);
+    for (size_t i = 0; i < numWords; i++, word += length + 1)
+        for (size_t j = deletionPositions(word, wordToCheck, length); j > 0; j--)
+            emit(word, length + 1);
+}
+
+// calls emit( word, length - 1 ) for every word of index left when one character of wordToCheck
+// is deleted, once for every such character, as spellCheck3 does
+template< typename Emit >
+void deletionWords(const LengthIndex& index, const char* wordToCheck, size_t length, Emit emit)
+{
+    if (length == 0)
+        return;
+
+    size_t numWords = index.count(length - 1);
+    const char* word = index.words(length - 1);
+    for (size_t i = 0; i < numWords; i++, word += length - 1)
+        for (size_t j = deletionPositions(wordToCheck, word, length - 1); j > 0; j--)
+            emit(word, length - 1);
+}
+
+#endif
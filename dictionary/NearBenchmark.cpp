@@ -0,0 +1,199 @@
+// Times the words within k = 1, 2, 3 edits of a query ( nearWords ) from a WordTrie, from a
+// DeletionIndex of distance 2 ( k <= 2 ) and from a scan of the dictionary, on dictionaries of
+// growing size, and checks that all of them report the same words in the same order
+//
+// The queries are words of the dictionary with one to three letters deleted, replaced or inserted.
+// The scan answers fewer of them, since one query takes it a pass over the dictionary.
+//
+// usage: NearBenchmark [maxWords [dictionary]]
+//   maxWords    random dictionaries of 40000, 10^5 and 10^6 words up to this size (10^6)
+//   dictionary  a word list timed before the random ones, such as Dictionary.txt
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <iomanip>
+using std::setw;
+using std::fixed;
+using std::setprecision;
+
+#include <string>
+using std::string;
+
+#include <vector>
+using std::vector;
+
+#include <random>
+using std::mt19937_64;
+
+#include <chrono>
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+#include <cstdlib>
+
+#include "DictionaryFile.h"
+#include "DeletionIndex.h"
+#include "WordTrie.h"
+
+// a word within some edits of a query
+struct NearWord
+{
+    int distance;
+    const char* word;
+    size_t length;
+
+    bool operator==(const NearWord& other) const
+    {
+        return distance == other.distance && length == other.length && memcmp(word, other.word, length) == 0;
+    }
+};
+
+// the words within maxDistance edits of wordToCheck, by a scan of dictionary, in ascending order of
+// distance and then in dictionary order
+void scanNearWords(const string& wordToCheck, const vector< string >& dictionary, int maxDistance, vector< NearWord >& result);
+
+// times every engine on words and prints a row of the table for every k; returns the number of errors
+int timeDictionary(const string& name, const vector< string >& words);
+
+int main(int argc, char* argv[])
+{
+    long long maxWords = argc > 1 ? atoll(argv[1]) : 1000000;
+
+    cout << setw(12) << "dictionary" << setw(10) << "words" << setw(4) << "k" << setw(12) << "trie us"
+        << setw(14) << "deletion us" << setw(12) << "scan us" << setw(10) << "found" << setw(10) << "build s"
+        << setw(8) << "MB" << endl;
+
+    int numErrors = 0;
+    if (argc > 2)
+    {
+        vector< string > words;
+        if (!readWords(argv[2], words))
+        {
+            cerr << "File could not be opened" << endl;
+            return 1;
+        }
+
+        numErrors += timeDictionary(argv[2], words);
+    }
+
+    const long long sizes[] = { 40000, 100000, 1000000 };
+    for (long long size : sizes)
+        if (size <= maxWords)
+            numErrors += timeDictionary("random", randomWords(static_cast< size_t >(size), 1));
+
+    cout << "\nThere are " << numErrors << " errors!\n";
+
+    return numErrors == 0 ? 0 : 1;
+}
+
+void scanNearWords(const string& wordToCheck, const vector< string >& dictionary, int maxDistance, vector< NearWord >& result)
+{
+    for (int distance = 0; distance <= maxDistance; distance++)
+        for (size_t i = 0; i < dictionary.size(); i++)
+            if (editDistance(wordToCheck.data(), wordToCheck.size(), dictionary[i].data(), dictionary[i].size(), maxDistance) == distance)
+                result.push_back(NearWord{ distance, dictionary[i].data(), dictionary[i].size() });
+}
+
+// times every engine on words and prints a row of the table for every k; returns the number of errors
+int timeDictionary(const string& name, const vector< string >& words)
+{
+    // the queries: one to three letters deleted, replaced or inserted
+    mt19937_64 engine(2);
+    const int numQueries = 1 << 14;
+    vector< string > queries(numQueries);
+    for (int q = 0; q < numQueries; q++)
+    {
+        queries[q] = words[engine() % words.size()];
+        for (int numEdits = 1 + engine() % 3; numEdits > 0; numEdits--)
+        {
+            size_t position = engine() % (queries[q].size() + 1);
+            char letter = static_cast< char >('a' + engine() % 26);
+            int edit = engine() % 3;
+            if (edit == 0 && position < queries[q].size())
+                queries[q].erase(position, 1);
+            else if (edit == 1 && position < queries[q].size())
+                queries[q][position] = letter;
+            else
+                queries[q].insert(position, 1, letter);
+        }
+    }
+
+    // the scan answers only as many queries as take about 10^8 word comparisons
+    int numScanQueries = static_cast< int >(std::min< long long >(numQueries,
+        std::max< long long >(2, 100000000LL / static_cast< long long >(words.size()))));
+
+    steady_clock::time_point start = steady_clock::now();
+    WordTrie trie;
+    for (size_t i = 0; i < words.size(); i++)
+        trie.insert(words[i]);
+    trie.build();
+    double trieBuildSeconds = duration< double >(steady_clock::now() - start).count();
+
+    DeletionIndex deletionIndex(2);
+    for (size_t i = 0; i < words.size(); i++)
+        deletionIndex.insert(words[i]);
+    deletionIndex.build();
+
+    int numErrors = 0;
+    vector< vector< NearWord > > expected(numQueries);
+    vector< NearWord > result;
+    for (int k = 1; k <= 3; k++)
+    {
+        size_t numFound = 0;
+        start = steady_clock::now();
+        for (int q = 0; q < numQueries; q++)
+        {
+            expected[q].clear();
+            nearWords(trie, queries[q].data(), queries[q].size(), k, [&](const char* word, size_t length, int distance)
+            {
+                expected[q].push_back(NearWord{ distance, word, length });
+            });
+            numFound += expected[q].size();
+        }
+        double trieSeconds = duration< double >(steady_clock::now() - start).count();
+
+        double deletionSeconds = 0;
+        if (k <= deletionIndex.distance())
+        {
+            start = steady_clock::now();
+            for (int q = 0; q < numQueries; q++)
+            {
+                result.clear();
+                nearWords(deletionIndex, queries[q].data(), queries[q].size(), k, [&](const char* word, size_t length, int distance)
+                {
+                    result.push_back(NearWord{ distance, word, length });
+                });
+                if (result != expected[q])
+                    numErrors++;
+            }
+            deletionSeconds = duration< double >(steady_clock::now() - start).count();
+        }
+
+        start = steady_clock::now();
+        for (int q = 0; q < numScanQueries; q++)
+        {
+            result.clear();
+            scanNearWords(queries[q], words, k, result);
+            if (result != expected[q])
+                numErrors++;
+        }
+        double scanSeconds = duration< double >(steady_clock::now() - start).count();
+
+        cout << fixed << setprecision(2);
+        cout << setw(12) << name << setw(10) << words.size() << setw(4) << k
+            << setw(12) << trieSeconds * 1e6 / numQueries;
+        if (k <= deletionIndex.distance())
+            cout << setw(14) << deletionSeconds * 1e6 / numQueries;
+        else
+            cout << setw(14) << "-";
+        cout << setprecision(1) << setw(12) << scanSeconds * 1e6 / numScanQueries
+            << setw(10) << static_cast< double >(numFound) / numQueries
+            << setprecision(2) << setw(10) << trieBuildSeconds
+            << setprecision(1) << setw(8) << trie.bytes() / 1048576.0 << endl;
+    }
+
+    return numErrors;
+}
@@ -0,0 +1,294 @@
+// Times the suggestions of hw9 ( spellCheck1, spellCheck2 and spellCheck3 in a row ) on
+// dictionaries of growing size and checks that every engine makes the same suggestions
+//
+// The queries are words of the dictionary with one letter deleted, replaced or inserted. The hw9
+// engine answers fewer of them, since one query takes it three passes over the dictionary. The
+// near2 columns time the words within two edits ( nearWords of a DeletionIndex of distance 2 ),
+// checked against a scan of the dictionary on as many queries as the hw9 engine answers.
+//
+// usage: SpellBenchmark [maxWords [dictionary]]
+//   maxWords    random dictionaries of 40000, 10^5 and 10^6 words up to this size (10^6)
+//   dictionary  a word list timed before the random ones, such as Dictionary.txt
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <iomanip>
+using std::setw;
+using std::fixed;
+using std::setprecision;
+
+#include <string>
+using std::string;
+
+#include <vector>
+using std::vector;
+
+#include <random>
+using std::mt19937_64;
+
+#include <chrono>
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+#include <cstdlib>
+
+#include "DictionaryFile.h"
+#include "LengthIndex.h"
+#include "DeletionIndex.h"
+
+// a word within some edits of a query
+struct NearWord
+{
+    int distance;
+    string word;
+
+    bool operator==(const NearWord& other) const
+    {
+        return distance == other.distance && word == other.word;
+    }
+};
+
+// the suggestions of hw9-2: spellCheck1, spellCheck2 and spellCheck3 with findWords
+void legacySuggestions(const string& wordToCheck, const vector< string >& dictionary, vector< string >& result);
+
+// the same suggestions from a LengthIndex
+void indexSuggestions(const string& wordToCheck, const LengthIndex& lengthIndex, vector< string >& result);
+
+// the same suggestions from a DeletionIndex
+void deletionSuggestions(const string& wordToCheck, const DeletionIndex& deletionIndex, vector< string >& result);
+
+// the words within maxDistance edits of wordToCheck, by a scan of dictionary, in ascending order of
+// distance and then in dictionary order
+void scanNearWords(const string& wordToCheck, const vector< string >& dictionary, int maxDistance, vector< NearWord >& result);
+
+// times every engine on words and prints a row of the table; returns the number of errors
+int timeDictionary(const string& name, const vector< string >& words);
+
+int main(int argc, char* argv[])
+{
+    long long maxWords = argc > 1 ? atoll(argv[1]) : 1000000;
+
+    cout << setw(12) << "dictionary" << setw(10) << "words" << setw(12) << "hw9 us" << setw(12) << "index us"
+        << setw(14) << "deletion ns" << setw(10) << "build s" << setw(8) << "MB" << setw(12) << "near2 us"
+        << setw(10) << "build s" << setw(8) << "MB" << setw(10) << "results" << endl;
+
+    int numErrors = 0;
+    if (argc > 2)
+    {
+        vector< string > words;
+        if (!readWords(argv[2], words))
+        {
+            cerr << "File could not be opened" << endl;
+            return 1;
+        }
+
+        numErrors += timeDictionary(argv[2], words);
+    }
+
+    const long long sizes[] = { 40000, 100000, 1000000 };
+    for (long long size : sizes)
+        if (size <= maxWords)
+            numErrors += timeDictionary("random", randomWords(static_cast< size_t >(size), 1));
+
+    cout << "\nThere are " << numErrors << " errors!\n";
+
+    return numErrors == 0 ? 0 : 1;
+}
+
+// find the words in dictionary whose length is length, and put them into words
+void findWords(string*& words, int& numWords, const string* dictionary, int numDicWords, size_t length)
+{
+    for (int i = 0; i < numDicWords; i++)
+        if (dictionary[i].size() == length)
+            numWords++;
+
+    words = new string[numWords];
+
+    numWords = 0;
+    for (int i = 0; i < numDicWords; i++)
+        if (dictionary[i].size() == length)
+            words[numWords++] = dictionary[i];
+}
+
+void legacySuggestions(const string& wordToCheck, const vector< string >& dictionary, vector< string >& result)
+{
+    int numDicWords = static_cast< int >(dictionary.size());
+    for (int check = 1; check <= 3; check++)
+    {
+        // spellCheck1 looks at words as long as wordToCheck, spellCheck2 at longer ones and spellCheck3 at shorter ones
+        size_t length = check == 1 ? wordToCheck.size() : check == 2 ? wordToCheck.size() + 1 : wordToCheck.size() - 1;
+        int numWords = 0;
+        string* words = 0;
+        findWords(words, numWords, dictionary.data(), numDicWords, length);
+
+        for (int i = 0; i < numWords; i++)
+        {
+            string buffer = words[i];
+            size_t numPositions = check == 3 ? length + 1 : length;
+            for (size_t j = 0; j < numPositions; j++)
+            {
+                size_t counter = 0;
+                for (size_t n = 0; n < numPositions; n++)
+                {
+                    if (n == j)
+                        continue;
+                    if (check == 1 || n < j)
+                        counter += buffer[n] == wordToCheck[n];
+                    else if (check == 2)
+                        counter += buffer[n] == wordToCheck[n - 1];
+                    else
+                        counter += buffer[n - 1] == wordToCheck[n];
+                }
+
+                if (counter == numPositions - 1)
+                    result.push_back(buffer);
+            }
+        }
+
+        delete[] words;
+    }
+}
+
+void indexSuggestions(const string& wordToCheck, const LengthIndex& lengthIndex, vector< string >& result)
+{
+    auto append = [&](const char* word, size_t length) { result.emplace_back(word, length); };
+    substitutionWords(lengthIndex, wordToCheck.data(), wordToCheck.size(), append);
+    insertionWords(lengthIndex, wordToCheck.data(), wordToCheck.size(), append);
+    deletionWords(lengthIndex, wordToCheck.data(), wordToCheck.size(), append);
+}
+
+void deletionSuggestions(const string& wordToCheck, const DeletionIndex& deletionIndex, vector< string >& result)
+{
+    auto append = [&](const char* word, size_t length) { result.emplace_back(word, length); };
+    substitutionWords(deletionIndex, wordToCheck.data(), wordToCheck.size(), append);
+    insertionWords(deletionIndex, wordToCheck.data(), wordToCheck.size(), append);
+    deletionWords(deletionIndex, wordToCheck.data(), wordToCheck.size(), append);
+}
+
+void scanNearWords(const string& wordToCheck, const vector< string >& dictionary, int maxDistance, vector< NearWord >& result)
+{
+    for (int distance = 0; distance <= maxDistance; distance++)
+        for (size_t i = 0; i < dictionary.size(); i++)
+            if (editDistance(wordToCheck.data(), wordToCheck.size(), dictionary[i].data(), dictionary[i].size(), maxDistance) == distance)
+                result.push_back(NearWord{ distance, dictionary[i] });
+}
+
+// times every engine on words and prints a row of the table; returns the number of errors
+int timeDictionary(const string& name, const vector< string >& words)
+{
+    // the queries: a letter deleted, replaced or inserted in turn
+    mt19937_64 engine(2);
+    const int numQueries = 1 << 16;
+    vector< string > queries(numQueries);
+    for (int q = 0; q < numQueries; q++)
+    {
+        queries[q] = words[engine() % words.size()];
+        size_t position = engine() % (queries[q].size() + 1);
+        char letter = static_cast< char >('a' + engine() % 26);
+        if (q % 3 == 0 && position < queries[q].size())
+            queries[q].erase(position, 1);
+        else if (q % 3 == 1 && position < queries[q].size())
+            queries[q][position] = letter;
+        else
+            queries[q].insert(position, 1, letter);
+    }
+
+    // the hw9 engine answers only as many queries as take about 2 * 10^8 word lengths
+    int numLegacyQueries = static_cast< int >(std::min< long long >(numQueries,
+        std::max< long long >(2, 200000000LL / static_cast< long long >(words.size()))));
+
+    LengthIndex lengthIndex;
+    for (size_t i = 0; i < words.size(); i++)
+        lengthIndex.insert(words[i]);
+
+    vector< vector< string > > expected(numQueries);
+    steady_clock::time_point start = steady_clock::now();
+    for (int q = 0; q < numQueries; q++)
+        indexSuggestions(queries[q], lengthIndex, expected[q]);
+    double indexSeconds = duration< double >(steady_clock::now() - start).count();
+
+    int numErrors = 0;
+    vector< string > result;
+    start = steady_clock::now();
+    for (int q = 0; q < numLegacyQueries; q++)
+    {
+        result.clear();
+        legacySuggestions(queries[q], words, result);
+        if (result != expected[q])
+            numErrors++;
+    }
+    double legacySeconds = duration< double >(steady_clock::now() - start).count();
+
+    start = steady_clock::now();
+    DeletionIndex deletionIndex;
+    for (size_t i = 0; i < words.size(); i++)
+        deletionIndex.insert(words[i]);
+    deletionIndex.build();
+    double deletionBuildSeconds = duration< double >(steady_clock::now() - start).count();
+
+    start = steady_clock::now();
+    for (int q = 0; q < numQueries; q++)
+    {
+        result.clear();
+        deletionSuggestions(queries[q], deletionIndex, result);
+        if (result != expected[q])
+            numErrors++;
+    }
+    double deletionSeconds = duration< double >(steady_clock::now() - start).count();
+
+    // the words within two edits
+    start = steady_clock::now();
+    DeletionIndex nearIndex(2);
+    for (size_t i = 0; i < words.size(); i++)
+        nearIndex.insert(words[i]);
+    nearIndex.build();
+    double nearBuildSeconds = duration< double >(steady_clock::now() - start).count();
+
+    vector< NearWord > near;
+    start = steady_clock::now();
+    for (int q = 0; q < numQueries; q++)
+    {
+        near.clear();
+        nearWords(nearIndex, queries[q].data(), queries[q].size(), 2, [&](const char* word, size_t length, int distance)
+        {
+            near.push_back(NearWord{ distance, string(word, length) });
+        });
+    }
+    double nearSeconds = duration< double >(steady_clock::now() - start).count();
+
+    vector< NearWord > scanned;
+    for (int q = 0; q < numLegacyQueries; q++)
+    {
+        near.clear();
+        nearWords(nearIndex, queries[q].data(), queries[q].size(), 2, [&](const char* word, size_t length, int distance)
+        {
+            near.push_back(NearWord{ distance, string(word, length) });
+        });
+
+        scanned.clear();
+        scanNearWords(queries[q], words, 2, scanned);
+        if (near != scanned)
+            numErrors++;
+    }
+
+    size_t numResults = 0;
+    for (int q = 0; q < numQueries; q++)
+        numResults += expected[q].size();
+
+    cout << fixed << setprecision(1);
+    cout << setw(12) << name << setw(10) << words.size()
+        << setw(12) << legacySeconds * 1e6 / numLegacyQueries
+        << setprecision(2) << setw(12) << indexSeconds * 1e6 / numQueries
+        << setprecision(1) << setw(14) << deletionSeconds * 1e9 / numQueries
+        << setprecision(2) << setw(10) << deletionBuildSeconds
+        << setprecision(1) << setw(8) << deletionIndex.bytes() / 1048576.0
+        << setprecision(2) << setw(12) << nearSeconds * 1e6 / numQueries
+        << setw(10) << nearBuildSeconds
+        << setprecision(1) << setw(8) << nearIndex.bytes() / 1048576.0
+        << setw(10) << numResults << endl;
+
+    return numErrors;
+}
@@ -0,0 +1,84 @@
+// Checks words against a dictionary compiled by DawgCompiler, which it maps instead of reading
+//
+// Every word given, or every word of the standard input when none is, is reported legal as hw9
+// reports it, or followed by the words of the dictionary within the given number of edits, one per
+// line with its distance, nearest first. Opening the dictionary costs the same however many words
+// it holds, since they are read in place from the mapped file.
+//
+// usage: SpellChecker [options] [word ...]
+//   --dictionary f   the DAWG file mapped (Dictionary.dawg)
+//   --distance k     the most edits of a suggestion, 1 to 3 (1)
+
+#include <iostream>
+using std::cin;
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <string>
+using std::string;
+
+#include <vector>
+using std::vector;
+
+#include <cstdlib>
+#include <cstring>
+
+#include "DawgFile.h"
+
+// reports whether wordToCheck is in dawg, and if not the words within maxDistance edits of it
+void checkWord(const string& wordToCheck, const MappedDawg& dawg, int maxDistance);
+
+int main(int argc, char* argv[])
+{
+    string dictionaryFile = "Dictionary.dawg";
+    int maxDistance = 1;
+
+    int argument = 1;
+    for (; argument + 1 < argc && strncmp(argv[argument], "--", 2) == 0; argument += 2)
+    {
+        if (strcmp(argv[argument], "--dictionary") == 0)
+            dictionaryFile = argv[argument + 1];
+        else if (strcmp(argv[argument], "--distance") == 0 && atoi(argv[argument + 1]) >= 1 && atoi(argv[argument + 1]) <= 3)
+            maxDistance = atoi(argv[argument + 1]);
+        else
+        {
+            cerr << "usage: SpellChecker [--dictionary file] [--distance 1|2|3] [word ...]" << endl;
+            return 1;
+        }
+    }
+
+    MappedDawg dawg;
+    if (!dawg.open(dictionaryFile))
+    {
+        cerr << "File could not be opened" << endl;
+        return 1;
+    }
+
+    if (argument < argc)
+        for (; argument < argc; argument++)
+            checkWord(argv[argument], dawg, maxDistance);
+    else
+    {
+        string wordToCheck;
+        while (cin >> wordToCheck)
+            checkWord(wordToCheck, dawg, maxDistance);
+    }
+
+    return 0;
+}
+
+void checkWord(const string& wordToCheck, const MappedDawg& dawg, int maxDistance)
+{
+    if (dawg.contains(wordToCheck))
+    {
+        cout << wordToCheck << " is a legal english word.\n";
+        return;
+    }
+
+    cout << wordToCheck << endl;
+    nearWords(dawg, wordToCheck.data(), wordToCheck.size(), maxDistance, [](const char* word, size_t length, int distance)
+    {
+        cout << "    " << string(word, length) << ' ' << distance << '\n';
+    });
+}
@@ -0,0 +1,222 @@
+// WordSet.h
+// A set of words in one flat open-addressing table.
+//
+// Every slot is 32 bytes: the 32-bit hash of its word, the length of the word and, for a word
+// of at most inlineWordLength characters, the characters themselves. Looking up a short word
+// therefore reads one slot: a slot whose hash or length differs is passed over without touching
+// any characters, and a match compares the characters in the slot. A longer word is kept in a
+// pool of characters, and its slot holds where. The number of slots is a power of two, at most
+// half of them are used, and collisions are resolved by linear probing, so a lookup usually
+// ends at the first slot it reads.
+
+#ifndef WORD_SET_H
+#define WORD_SET_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// returns a 64-bit hash of the characters word[ 0 .. length - 1 ], reading 8 of them at a time
+inline uint64_t hashWord(const char* word, size_t length)
+{
+    uint64_t hash = length * 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < length; i += 8)
+    {
+        uint64_t chunk = 0;
+        memcpy(&chunk, word + i, length - i < 8 ? length - i : 8);
+        hash = (hash ^ chunk) * 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 32;
+    }
+
+    hash ^= hash >> 29;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+// words of at most this many characters are stored in their slots
+const size_t inlineWordLength = 27;
+
+class WordSet
+{
+public:
+    // makes room for expectedWords words; more are reached by growing
+    explicit WordSet(size_t expectedWords = 0)
+    {
+        int bits = 4;
+        while (bits < 62 && (static_cast< size_t >(1) << bits) < 2 * expectedWords)
+            bits++;
+
+        resize(bits);
+    }
+
+    // adds word[ 0 .. length - 1 ]; returns false if it was in the set already
+    bool insert(const char* word, size_t length)
+    {
+        uint64_t hash = hashWord(word, length);
+        size_t i = find(word, length, hash);
+        if (slots[i].length != emptySlot)
+            return false;
+
+        place(i, word, length, hash);
+        if (++numWords * 2 > slots.size())
+            grow();
+
+        return true;
+    }
+
+    bool insert(const std::string& word)
+    {
+        return insert(word.data(), word.size());
+    }
+
+    // returns true if and only if word[ 0 .. length - 1 ] is in the set
+    bool contains(const char* word, size_t length) const
+    {
+        return slots[find(word, length, hashWord(word, length))].length != emptySlot;
+    }
+
+    bool contains(const char* word) const
+    {
+        return contains(word, strlen(word));
+    }
+
+    bool contains(const std::string& word) const
+    {
+        return contains(word.data(), word.size());
+    }
+
+    // returns the number of words in the set
+    size_t size() const
+    {
+        return numWords;
+    }
+
+    // returns the number of bytes of the table and the pool
+    size_t bytes() const
+    {
+        return slots.size() * sizeof(Slot) + pool.size();
+    }
+
+private:
+    static const uint8_t emptySlot = 254;  // the length of a slot without a word
+    static const uint8_t pooledWord = 255; // the length of a slot whose word is in the pool
+
+    struct Slot
+    {
+        uint32_t hash;                     // the low 32 bits of the hash of the word
+        uint8_t length;                    // the length of an inline word, or emptySlot or pooledWord
+        char chars[inlineWordLength];      // an inline word, or the offset of a pooled word
+    };
+
+    static_assert(sizeof(Slot) == 32, "a slot fills half a cache line");
+    static_assert(inlineWordLength < emptySlot, "no inline word has the length of an empty slot");
+
+    void resize(int bits)
+    {
+        shift = 64 - bits;
+        numWords = 0;
+
+        // the empty word has length 0, so an empty slot is marked by a length no word has
+        Slot empty = Slot();
+        empty.length = emptySlot;
+        slots.assign(static_cast< size_t >(1) << bits, empty);
+    }
+
+    // returns the slot of word[ 0 .. length - 1 ], or the empty slot where it would be placed
+    size_t find(const char* word, size_t length, uint64_t hash) const
+    {
+        size_t mask = slots.size() - 1;
+        uint32_t tag = static_cast< uint32_t >(hash);
+        for (size_t i = hash >> shift; ; i = (i + 1) & mask)
+        {
+            const Slot& slot = slots[i];
+            if (slot.length == emptySlot)
+                return i;
+
+            if (slot.hash == tag && sameWord(slot, word, length))
+                return i;
+        }
+    }
+
+    // returns true if and only if slot holds word[ 0 .. length - 1 ]
+    bool sameWord(const Slot& slot, const char* word, size_t length) const
+    {
+        if (length <= inlineWordLength)
+            return slot.length == length && memcmp(slot.chars, word, length) == 0;
+
+        if (slot.length != pooledWord)
+            return false;
+
+        // a pooled word is its length ( 8 bytes ) followed by its characters
+        uint64_t offset;
+        memcpy(&offset, slot.chars, sizeof(offset));
+        uint64_t pooledLength;
+        memcpy(&pooledLength, &pool[offset], sizeof(pooledLength));
+        return pooledLength == length && memcmp(&pool[offset + sizeof(pooledLength)], word, length) == 0;
+    }
+
+    // stores word[ 0 .. length - 1 ] in the empty slot i
+    void place(size_t i, const char* word, size_t length, uint64_t hash)
+    {
+        Slot& slot = slots[i];
+        slot.hash = static_cast< uint32_t >(hash);
+        if (length <= inlineWordLength)
+        {
+            slot.length = static_cast< uint8_t >(length);
+            memcpy(slot.chars, word, length);
+            return;
+        }
+
+        uint64_t offset = pool.size();
+        uint64_t pooledLength = length;
+        pool.resize(pool.size() + sizeof(pooledLength) + length);
+        memcpy(&pool[offset], &pooledLength, sizeof(pooledLength));
+        memcpy(&pool[offset + sizeof(pooledLength)], word, length);
+
+        slot.length = pooledWord;
+        memcpy(slot.chars, &offset, sizeof(offset));
+    }
+
+    // doubles the number of slots; pooled words stay where they are
+    void grow()
+    {
+        std::vector< Slot > old;
+        old.swap(slots);
+
+        size_t numOld = numWords;
+        resize(64 - shift + 1);
+        size_t mask = slots.size() - 1;
+        for (size_t i = 0; i < old.size(); i++)
+            if (old[i].length != emptySlot)
+            {
+                size_t j = (static_cast< uint64_t >(rehash(old[i])) >> shift) & mask;
+                while (slots[j].length != emptySlot)
+                    j = (j + 1) & mask;
+                slots[j] = old[i];
+            }
+
+        numWords = numOld;
+    }
+
+    // returns the hash of the word in slot
+    uint64_t rehash(const Slot& slot) const
+    {
+        if (slot.length != pooledWord)
+            return hashWord(slot.chars, slot.length);
+
+        uint64_t offset;
+        memcpy(&offset, slot.chars, sizeof(offset));
+        uint64_t pooledLength;
+        memcpy(&pooledLength, &pool[offset], sizeof(pooledLength));
+        return hashWord(&pool[offset + sizeof(pooledLength)], pooledLength);
+    }
+
+    std::vector< Slot > slots;
+    std::vector< char > pool; // the words longer than inlineWordLength
+    int shift = 60;           // the slot of a hash is its top 64 - shift bits
+    size_t numWords = 0;
+};
+
+#endif
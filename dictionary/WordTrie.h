@@ -0,0 +1,245 @@
+// WordTrie.h
+// The words within k edits of a word, found by walking a trie of the dictionary.
+//
+// The walk carries one row of the edit distance table per letter of the path: the row of a node
+// holds the distance between the path to it and every prefix of the query, and follows from the
+// row of its parent in O( k ), since only the 2k + 1 entries of the band around the diagonal can be
+// k or less. A subtree is skipped as soon as every entry of its row exceeds k, since the entries
+// never shrink further down ( the row works as a Levenshtein automaton run over the trie ), so only
+// the prefixes within k edits of some prefix of the query are visited however large the dictionary
+// is. Unlike DeletionIndex, the trie costs a node per prefix of the dictionary whatever k is, and
+// answers any k.
+//
+// The nodes are one array in breadth-first order, the children of a node side by side in
+// alphabetical order, so a walk reads the children of a node from one place.
+
+#ifndef WORD_TRIE_H
+#define WORD_TRIE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+// fills row[ 0 .. length ], the row of the root: the distance between the empty word and every
+// prefix of wordToCheck, capped at maxDistance + 1
+inline void firstBandRow(int* row, size_t length, int maxDistance)
+{
+    for (size_t j = 0; j <= length; j++)
+        row[j] = std::min(static_cast< int >(j), maxDistance + 1);
+}
+
+// fills row, the row of a node of depth > 0 whose last letter is letter, from parent, the row of
+// its parent: only the band | depth - j | <= maxDistance is computed ( the distance is at least
+// | depth - j | ), and the cells beside it are set to maxDistance + 1. Returns the least entry of
+// the band, more than maxDistance when no descendant of the node is within maxDistance edits;
+// row[ length ] is computed exactly when depth + maxDistance >= length.
+inline int nextBandRow(const int* parent, int* row, const char* wordToCheck, size_t length, size_t depth,
+    char letter, int maxDistance)
+{
+    size_t band = static_cast< size_t >(maxDistance);
+    int outside = maxDistance + 1;
+    size_t first = depth > band ? depth - band : 0;
+    size_t last = std::min(length, depth + band);
+    if (first > last)
+        return outside;
+
+    if (first == 0)
+        row[0] = static_cast< int >(depth);
+    else
+        row[first - 1] = outside;
+
+    int rowMinimum = first == 0 ? row[0] : outside;
+    for (size_t j = std::max< size_t >(first, 1); j <= last; j++)
+    {
+        row[j] = std::min(std::min(parent[j], row[j - 1]) + 1, parent[j - 1] + (wordToCheck[j - 1] != letter));
+        rowMinimum = std::min(rowMinimum, row[j]);
+    }
+    if (last < length)
+        row[last + 1] = outside;
+
+    return rowMinimum;
+}
+
+class WordTrie
+{
+public:
+    // adds word[ 0 .. length - 1 ] as the next word of the dictionary; build must be called after
+    // the last word is inserted and before the first query
+    void insert(const char* word, size_t length)
+    {
+        chars.insert(chars.end(), word, word + length);
+        offsets.push_back(chars.size());
+    }
+
+    void insert(const std::string& word)
+    {
+        insert(word.data(), word.size());
+    }
+
+    // builds the trie of the words inserted so far; a word inserted twice ends at one node,
+    // which keeps the first
+    void build()
+    {
+        std::vector< uint32_t > sorted(size());
+        for (size_t i = 0; i < sorted.size(); i++)
+            sorted[i] = static_cast< uint32_t >(i);
+        std::stable_sort(sorted.begin(), sorted.end(), [&](uint32_t first, uint32_t second)
+        {
+            size_t firstLength;
+            size_t secondLength;
+            const char* firstWord = word(first, firstLength);
+            const char* secondWord = word(second, secondLength);
+            int order = memcmp(firstWord, secondWord, std::min(firstLength, secondLength));
+            return order != 0 ? order < 0 : firstLength < secondLength;
+        });
+
+        // pending[ n ] is the range of sorted whose words run through node n, whose path is their
+        // first pending[ n ].depth letters; the nodes are made in breadth-first order
+        struct Range
+        {
+            size_t begin;
+            size_t end;
+            size_t depth;
+        };
+
+        nodes.assign(1, Node());
+        std::vector< Range > pending(1, Range{ 0, sorted.size(), 0 });
+        for (size_t n = 0; n < nodes.size(); n++)
+        {
+            Range range = pending[n];
+            size_t i = range.begin;
+
+            // the words that end here sort before the longer ones
+            size_t length;
+            for (; i < range.end; i++)
+            {
+                word(sorted[i], length);
+                if (length != range.depth)
+                    break;
+                if (nodes[n].word == noWord)
+                    nodes[n].word = sorted[i];
+            }
+
+            nodes[n].firstChild = static_cast< uint32_t >(nodes.size());
+            while (i < range.end)
+            {
+                char letter = word(sorted[i], length)[range.depth];
+                size_t end = i + 1;
+                while (end < range.end && word(sorted[end], length)[range.depth] == letter)
+                    end++;
+
+                Node child;
+                child.letter = letter;
+                nodes.push_back(child);
+                pending.push_back(Range{ i, end, range.depth + 1 });
+                nodes[n].numChildren++;
+                i = end;
+            }
+        }
+    }
+
+    // returns the number of words
+    size_t size() const
+    {
+        return offsets.size() - 1;
+    }
+
+    // returns word number of the dictionary and sets length to its length
+    const char* word(uint32_t number, size_t& length) const
+    {
+        length = offsets[number + 1] - offsets[number];
+        return chars.data() + offsets[number];
+    }
+
+    // returns the number of bytes of the words and the nodes
+    size_t bytes() const
+    {
+        return chars.size() + offsets.size() * sizeof(size_t) + nodes.size() * sizeof(Node);
+    }
+
+    // calls visit( number, distance ) for every word within maxDistance edits of wordToCheck[ 0 .. length - 1 ],
+    // in alphabetical order
+    template< typename Visit >
+    void walk(const char* wordToCheck, size_t length, int maxDistance, Visit visit) const
+    {
+        // rows[ d * ( length + 1 ) + j ] is the distance between the path to the node of depth d
+        // being visited and wordToCheck[ 0 .. j - 1 ], within the band of nextBandRow
+        static thread_local std::vector< int > rows;
+        static thread_local std::vector< std::pair< uint32_t, uint32_t > > stack; // ( node, depth )
+        size_t width = length + 1;
+        if (rows.size() < width)
+            rows.resize(width);
+        firstBandRow(rows.data(), length, maxDistance);
+
+        stack.clear();
+        stack.push_back(std::make_pair(0u, 0u));
+        while (!stack.empty())
+        {
+            uint32_t n = stack.back().first;
+            size_t depth = stack.back().second;
+            stack.pop_back();
+
+            const Node& node = nodes[n];
+            if (depth > 0)
+            {
+                int* row = &rows[depth * width];
+                if (nextBandRow(row - width, row, wordToCheck, length, depth, node.letter, maxDistance) > maxDistance)
+                    continue;
+
+                if (node.word != noWord && depth + maxDistance >= length && row[length] <= maxDistance)
+                    visit(node.word, row[length]);
+            }
+            else if (node.word != noWord && length <= static_cast< size_t >(maxDistance))
+                visit(node.word, static_cast< int >(length));
+
+            if (node.numChildren > 0 && rows.size() < (depth + 2) * width)
+                rows.resize((depth + 2) * width);
+
+            // the children are pushed last first, so they are visited in alphabetical order
+            for (uint32_t c = node.numChildren; c > 0; c--)
+                stack.push_back(std::make_pair(node.firstChild + c - 1, static_cast< uint32_t >(depth + 1)));
+        }
+    }
+
+private:
+    static const uint32_t noWord = 0xFFFFFFFF; // the word of a node that ends none
+
+    struct Node
+    {
+        uint32_t firstChild = 0;  // the children are nodes[ firstChild .. firstChild + numChildren - 1 ]
+        uint32_t word = noWord;   // the word that ends here
+        uint16_t numChildren = 0;
+        char letter = 0;          // the last letter of the path to the node
+    };
+
+    std::vector< char > chars;                                // the words back to back
+    std::vector< size_t > offsets = std::vector< size_t >(1); // word i is chars[ offsets[ i ] .. offsets[ i + 1 ] - 1 ]
+    std::vector< Node > nodes;                                // nodes[ 0 ] is the root
+};
+
+// calls emit( word, length, distance ) for every word of trie within maxDistance edits of
+// wordToCheck, in ascending order of distance and then in dictionary order
+template< typename Emit >
+void nearWords(const WordTrie& trie, const char* wordToCheck, size_t length, int maxDistance, Emit emit)
+{
+    // found holds distance * 2^32 + word number
+    static thread_local std::vector< uint64_t > found;
+    found.clear();
+    trie.walk(wordToCheck, length, maxDistance, [&](uint32_t number, int distance)
+    {
+        found.push_back(static_cast< uint64_t >(distance) << 32 | number);
+    });
+
+    std::sort(found.begin(), found.end());
+    for (size_t i = 0; i < found.size(); i++)
+    {
+        size_t wordLength;
+        const char* word = trie.word(static_cast< uint32_t >(found[i]), wordLength);
+        emit(word, wordLength, static_cast< int >(found[i] >> 32));
+    }
+}
+
+#endif
@@ -0,0 +1,227 @@
+// Compares merges for the addition of term arrays on random and skewed operands
+//
+// The operands are generated: "random" interleaves the exponents of both operands at random,
+// "runs" takes them from each operand in runs of 64, and "skewed" adds an operand of 1 / 16
+// the size. A quarter of the exponents of the smaller operand also occur in the larger one, and
+// half of those terms cancel.
+//
+// usage: AdditionBenchmark [terms [repetitions]]
+//   terms        the number of terms of the larger operand (1000000)
+//   repetitions  the number of times every sum is computed (20)
+//
+// "auto" is mergeAddition, which adds skewed operands by copying runs. The bitonic merge is built
+// only when the compiler targets AVX2:
+//   g++ -std=c++17 -O2 -mavx2 -o AdditionBenchmark polynomial/AdditionBenchmark.cpp
+
+#include <iostream>
+using std::cout;
+using std::endl;
+
+#include <iomanip>
+using std::setw;
+using std::fixed;
+using std::setprecision;
+
+#include <vector>
+using std::vector;
+
+#include <random>
+using std::mt19937_64;
+using std::uniform_int_distribution;
+
+#include <chrono>
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+#include <cstdlib>
+
+#include "MergeAddition.h"
+
+struct Term
+{
+    int coef = 0;  // the coefficient of a term
+    int expon = 0; // the exponent of a term
+};
+
+// sum = augend + addend, choosing every term by branches on the exponents
+// ( the method of hw8 before the branchless merge ); returns the number of terms of sum
+int branchyAddition(const Term* augend, int augendSize, const Term* addend, int addendSize, Term* sum);
+
+// sum = augend + addend by the branchless scalar merge
+int branchlessAddition(const Term* augend, int augendSize, const Term* addend, int addendSize, Term* sum);
+
+#ifdef __AVX2__
+// sum = augend + addend by the bitonic merge and the vector compaction
+int bitonicAddition(const Term* augend, int augendSize, const Term* addend, int addendSize, Term* sum);
+#endif
+
+// makes operands of numTerms and numTerms / sizeRatio terms whose exponents come from each
+// operand in runs of runLength on average ( 1 for a random interleaving )
+void makeOperands(mt19937_64& engine, int numTerms, int sizeRatio, int runLength,
+    vector< Term >& augend, vector< Term >& addend);
+
+typedef int (*Engine)(const Term*, int, const Term*, int, Term*);
+
+int main(int argc, char* argv[])
+{
+    int numTerms = argc > 1 ? atoi(argv[1]) : 1000000;
+    int repetitions = argc > 2 ? atoi(argv[2]) : 20;
+
+    const int numCases = 3;
+    const char* caseNames[numCases] = { "random", "runs", "skewed" };
+    const int sizeRatios[numCases] = { 1, 1, 16 };
+    const int runLengths[numCases] = { 1, 64, 1 };
+
+#ifdef __AVX2__
+    const int numEngines = 4;
+    const char* engineNames[numEngines] = { "branchy", "branchless", "bitonic", "auto" };
+    Engine engines[numEngines] = { branchyAddition, branchlessAddition, bitonicAddition, mergeAddition< Term > };
+#else
+    const int numEngines = 3;
+    const char* engineNames[numEngines] = { "branchy", "branchless", "auto" };
+    Engine engines[numEngines] = { branchyAddition, branchlessAddition, mergeAddition< Term > };
+#endif
+
+    mt19937_64 engine(1);
+
+    cout << numTerms << " terms, " << repetitions << " repetitions\n\n";
+    cout << fixed << setprecision(4);
+    cout << setw(8) << "case" << setw(12) << "merge" << setw(14) << "seconds" << setw(12) << "ns / term" << endl;
+
+    int numErrors = 0;
+    for (int c = 0; c < numCases; c++)
+    {
+        vector< Term > augend;
+        vector< Term > addend;
+        makeOperands(engine, numTerms, sizeRatios[c], runLengths[c], augend, addend);
+
+        int numInputTerms = static_cast< int >(augend.size() + addend.size());
+        vector< Term > expected(numInputTerms);
+        vector< Term > sum(numInputTerms);
+        int expectedSize = 0;
+
+        for (int e = 0; e < numEngines; e++)
+        {
+            int size = 0;
+            steady_clock::time_point start = steady_clock::now();
+            for (int r = 0; r < repetitions; r++)
+                size = engines[e](augend.data(), static_cast< int >(augend.size()),
+                    addend.data(), static_cast< int >(addend.size()), e == 0 ? expected.data() : sum.data());
+            double seconds = duration< double >(steady_clock::now() - start).count();
+
+            cout << setw(8) << caseNames[c] << setw(12) << engineNames[e] << setw(14) << seconds
+                << setw(12) << seconds * 1e9 / (static_cast< double >(numInputTerms) * repetitions) << endl;
+
+            if (e == 0)
+                expectedSize = size;
+            else
+            {
+                bool same = size == expectedSize;
+                for (int i = 0; same && i < size; i++)
+                    same = sum[i].coef == expected[i].coef && sum[i].expon == expected[i].expon;
+                if (!same)
+                    numErrors++;
+            }
+        }
+    }
+
+    cout << "\nThere are " << numErrors << " errors!\n";
+
+    return numErrors == 0 ? 0 : 1;
+}
+
+// sum = augend + addend, choosing every term by branches on the exponents
+int branchyAddition(const Term* augend, int augendSize, const Term* addend, int addendSize, Term* sum)
+{
+    int i = 0;
+    int j = 0;
+    int k = 0;
+    while (i < augendSize && j < addendSize)
+    {
+        if (augend[i].expon > addend[j].expon)
+            sum[k++] = augend[i++];
+        else if (augend[i].expon < addend[j].expon)
+            sum[k++] = addend[j++];
+        else
+        {
+            int coef = augend[i].coef + addend[j].coef;
+            if (coef != 0)
+            {
+                sum[k].coef = coef;
+                sum[k].expon = augend[i].expon;
+                k++;
+            }
+            i++;
+            j++;
+        }
+    }
+
+    for (; i < augendSize; i++)
+        sum[k++] = augend[i];
+    for (; j < addendSize; j++)
+        sum[k++] = addend[j];
+
+    return k;
+}
+
+// sum = augend + addend by the branchless scalar merge
+int branchlessAddition(const Term* augend, int augendSize, const Term* addend, int addendSize, Term* sum)
+{
+    branchlessMerge(augend, augendSize, addend, addendSize, sum);
+    return combineTerms(sum, augendSize + addendSize);
+}
+
+#ifdef __AVX2__
+// sum = augend + addend by the bitonic merge and the vector compaction
+int bitonicAddition(const Term* augend, int augendSize, const Term* addend, int addendSize, Term* sum)
+{
+    bitonicMergeTerms(augend, augendSize, addend, addendSize, sum);
+    return combinePackedTerms(sum, augendSize + addendSize);
+}
+#endif
+
+// makes operands of numTerms and numTerms / sizeRatio terms whose exponents come from each
+// operand in runs of runLength on average
+void makeOperands(mt19937_64& engine, int numTerms, int sizeRatio, int runLength,
+    vector< Term >& augend, vector< Term >& addend)
+{
+    int numAddendTerms = numTerms / sizeRatio;
+    uniform_int_distribution< int > coefficient(1, 9);
+    uniform_int_distribution< int > percent(0, 99);
+
+    // exponents are handed out from the top; an exponent goes to the operand of the current run,
+    // and with probability 1 / 4 also to the other one when that is the smaller operand
+    augend.clear();
+    addend.clear();
+    bool toAugend = true;
+    int expon = 2 * (numTerms + numAddendTerms);
+    while (static_cast< int >(augend.size()) < numTerms || static_cast< int >(addend.size()) < numAddendTerms)
+    {
+        // a run ends with probability 1 / runLength; the larger operand gets sizeRatio times as
+        // many runs
+        if (uniform_int_distribution< int >(1, runLength)(engine) == 1)
+            toAugend = uniform_int_distribution< int >(0, sizeRatio)(engine) != 0;
+
+        Term term;
+        term.coef = coefficient(engine);
+        term.expon = expon--;
+
+        bool augendFull = static_cast< int >(augend.size()) == numTerms;
+        bool addendFull = static_cast< int >(addend.size()) == numAddendTerms;
+        if ((toAugend && !augendFull) || addendFull)
+        {
+            augend.push_back(term);
+        }
+        else
+        {
+            addend.push_back(term);
+            if (!augendFull && percent(engine) < 25)
+            {
+                // half of the shared terms cancel
+                if (percent(engine) < 50)
+                    term.coef = -term.coef;
+                augend.push_back(term);
+            }
+        }
+    }
+}
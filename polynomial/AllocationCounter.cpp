@@ -0,0 +1,73 @@
+// AllocationCounter.cpp
+// Every form of operator new counts the allocation and takes the memory from malloc, and every
+// form of operator delete gives it back to free ( see AllocationCounter.h ).
+
+#include <new>
+#include <cstdlib>
+
+#include "AllocationCounter.h"
+
+long long numAllocations = 0;
+long long numBytesAllocated = 0;
+
+// counts an allocation of size bytes and returns it, or nullptr if there is no memory
+static void* countedAllocation(size_t size) noexcept
+{
+    numAllocations++;
+    numBytesAllocated += size;
+    return malloc(size > 0 ? size : 1);
+}
+
+void* operator new(size_t size)
+{
+    if (void* pointer = countedAllocation(size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    if (void* pointer = countedAllocation(size))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAllocation(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAllocation(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept
+{
+    free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+    free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+    free(pointer);
+}
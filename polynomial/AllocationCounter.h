@@ -0,0 +1,16 @@
+// AllocationCounter.h
+// The number and size of all allocations made through operator new.
+//
+// AllocationCounter.cpp replaces every form of the global operator new and operator delete, and a
+// program that counts its allocations links it in. The operators live in a translation unit of
+// their own so that the compiler never inlines them into a new or delete expression: seen through,
+// a delete expression that ends in free would look like it frees memory that operator new allocated.
+
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+// the number of calls to operator new and the bytes they asked for, since the program started
+extern long long numAllocations;
+extern long long numBytesAllocated;
+
+#endif
@@ -0,0 +1,219 @@
+// Arena.h
+// A bump allocator for the temporaries of one test case ( or one worker thread ).
+//
+// Memory is handed out from large blocks by advancing a pointer and is given back all at once
+// by reset(), so the many small term arrays built while dividing, multiplying and adding cost
+// no calls to the general-purpose allocator once the blocks have grown to the size of a case.
+// Objects in an arena are never destroyed one by one, so only types without destructors
+// ( such as Term ) may be stored in it. An arena is not shared between threads.
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+class Arena
+{
+public:
+    explicit Arena(size_t blockSize = 64 * 1024)
+        : minBlockSize(blockSize)
+    {
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena()
+    {
+        while (blocks != nullptr)
+        {
+            Block* next = blocks->next;
+            ::operator delete(blocks);
+            blocks = next;
+        }
+    }
+
+    // returns bytes bytes of storage aligned to alignment ( a power of two at most that of max_align_t )
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        size_t start = (used + alignment - 1) & ~(alignment - 1);
+        if (blocks == nullptr || start + bytes > blocks->size)
+        {
+            addBlock(bytes);
+            start = 0;
+        }
+
+        used = start + bytes;
+        return blocks->data() + start;
+    }
+
+    // gives back the storage at pointer if it is the latest allocation; otherwise it is kept until reset()
+    void deallocate(void* pointer, size_t bytes)
+    {
+        if (blocks != nullptr && static_cast< char* >(pointer) + bytes == blocks->data() + used)
+            used -= bytes;
+    }
+
+    // grows the latest allocation in place from oldBytes to newBytes if it is the latest one
+    // and the block has room; returns false otherwise
+    bool extend(void* pointer, size_t oldBytes, size_t newBytes)
+    {
+        char* begin = static_cast< char* >(pointer);
+        if (blocks == nullptr || begin + oldBytes != blocks->data() + used ||
+            begin + newBytes > blocks->data() + blocks->size)
+            return false;
+
+        used += newBytes - oldBytes;
+        return true;
+    }
+
+    // frees everything allocated since the last reset; only the largest block is kept for reuse
+    void reset()
+    {
+        if (blocks == nullptr)
+            return;
+
+        Block* largest = blocks;
+        for (Block* block = blocks->next; block != nullptr; block = block->next)
+            if (block->size > largest->size)
+                largest = block;
+
+        while (blocks != nullptr)
+        {
+            Block* next = blocks->next;
+            if (blocks != largest)
+                ::operator delete(blocks);
+            blocks = next;
+        }
+
+        largest->next = nullptr;
+        blocks = largest;
+        used = 0;
+    }
+
+    // returns the number of blocks obtained from the general-purpose allocator so far
+    long long numBlockAllocations() const
+    {
+        return numBlocksAllocated;
+    }
+
+private:
+    struct alignas(std::max_align_t) Block
+    {
+        Block* next;
+        size_t size; // the number of bytes following the header
+
+        char* data()
+        {
+            return reinterpret_cast< char* >(this + 1);
+        }
+    };
+
+    // starts a new block that holds at least bytes bytes; blocks at least double in size
+    void addBlock(size_t bytes)
+    {
+        size_t size = blocks == nullptr ? minBlockSize : 2 * blocks->size;
+        if (size < bytes)
+            size = bytes;
+
+        Block* block = static_cast< Block* >(::operator new(sizeof(Block) + size));
+        block->next = blocks;
+        block->size = size;
+        blocks = block;
+        used = 0;
+        numBlocksAllocated++;
+    }
+
+    size_t minBlockSize;
+    Block* blocks = nullptr; // the current block first
+    size_t used = 0;         // the number of bytes used in the current block
+    long long numBlocksAllocated = 0;
+};
+
+// returns an array of size value-initialized objects of type T in arena
+template< typename T >
+T* arenaArray(Arena& arena, int size)
+{
+    static_assert(std::is_trivially_destructible< T >::value, "arena objects are never destroyed");
+
+    T* array = static_cast< T* >(arena.allocate(size * sizeof(T), alignof(T)));
+    for (int i = 0; i < size; i++)
+        new (array + i) T();
+    return array;
+}
+
+// appends a term to an array in arena, doubling its capacity when it is full;
+// the array grows in place while it is the latest allocation of the arena
+template< typename TermType, typename Coef, typename Expon >
+void appendTerm(Arena& arena, TermType*& terms, int& size, int& capacity, const Coef& coef, const Expon& expon)
+{
+    if (size == capacity)
+    {
+        int newCapacity = capacity < 4 ? 4 : 2 * capacity;
+        if (terms == nullptr ||
+            !arena.extend(terms, capacity * sizeof(TermType), newCapacity * sizeof(TermType)))
+        {
+            TermType* newTerms = arenaArray< TermType >(arena, newCapacity);
+            for (int i = 0; i < size; i++)
+                newTerms[i] = terms[i];
+            terms = newTerms;
+        }
+        capacity = newCapacity;
+    }
+
+    terms[size].coef = coef;
+    terms[size].expon = expon;
+    size++;
+}
+
+// a standard allocator drawing from an arena, for containers such as vector< Term, ArenaAllocator< Term > >
+template< typename T >
+class ArenaAllocator
+{
+public:
+    typedef T value_type;
+
+    explicit ArenaAllocator(Arena& arena)
+        : arena(&arena)
+    {
+    }
+
+    template< typename U >
+    ArenaAllocator(const ArenaAllocator< U >& allocator2)
+        : arena(allocator2.arena)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        static_assert(std::is_trivially_destructible< T >::value, "arena objects are never destroyed");
+        return static_cast< T* >(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, size_t n)
+    {
+        arena->deallocate(pointer, n * sizeof(T));
+    }
+
+    template< typename U >
+    bool operator==(const ArenaAllocator< U >& allocator2) const
+    {
+        return arena == allocator2.arena;
+    }
+
+    template< typename U >
+    bool operator!=(const ArenaAllocator< U >& allocator2) const
+    {
+        return arena != allocator2.arena;
+    }
+
+private:
+    template< typename U >
+    friend class ArenaAllocator;
+
+    Arena* arena;
+};
+
+#endif
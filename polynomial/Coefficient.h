@@ -0,0 +1,676 @@
+// Coefficient.h
+// Integer coefficients that never overflow.
+//
+// A Coefficient is one 64-bit word. When its lowest bit is 1 the word holds a small integer
+// in the other 63 bits ( values in [ -2^62, 2^62 ) ); otherwise it is the address of a
+// BigInteger on the heap. Arithmetic on two small values costs a few instructions more than
+// on int; only a result that leaves the small range allocates, and a big result that fits
+// again is brought back inline, so a value has exactly one representation and equality
+// never compares a small value with a big one.
+//
+// Division truncates toward zero and the remainder has the sign of the dividend,
+// as for the built-in integer types, so the kernels behave the same with int and Coefficient.
+// The sparse kernels take the coefficient type from the term, so a term whose coef is a
+// Coefficient is all they need.
+
+#ifndef COEFFICIENT_H
+#define COEFFICIENT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// a signed integer of any size: a sign and the magnitude in base 2^32, least significant limb first
+class BigInteger
+{
+public:
+    BigInteger() = default;
+
+    explicit BigInteger(long long value)
+        : negative(value < 0)
+    {
+        // the magnitude of LLONG_MIN does not fit in a long long, but it does in an unsigned one
+        unsigned long long magnitude = negative ? 0ULL - static_cast< unsigned long long >(value)
+            : static_cast< unsigned long long >(value);
+        for (; magnitude != 0; magnitude >>= 32)
+            limbs.push_back(static_cast< uint32_t >(magnitude));
+    }
+
+    bool isZero() const
+    {
+        return limbs.empty();
+    }
+
+    // stores the value in value and returns true if it lies in [ minimum, maximum ]
+    bool fits(long long minimum, long long maximum, long long& value) const
+    {
+        if (limbs.size() > 2)
+            return false;
+
+        unsigned long long magnitude = 0;
+        for (size_t i = limbs.size(); i-- > 0; )
+            magnitude = (magnitude << 32) | limbs[i];
+
+        if (negative)
+        {
+            if (magnitude > 0ULL - static_cast< unsigned long long >(minimum))
+                return false;
+            value = static_cast< long long >(0ULL - magnitude);
+        }
+        else
+        {
+            if (magnitude > static_cast< unsigned long long >(maximum))
+                return false;
+            value = static_cast< long long >(magnitude);
+        }
+
+        return true;
+    }
+
+    friend BigInteger operator-(BigInteger value)
+    {
+        if (!value.isZero())
+            value.negative = !value.negative;
+        return value;
+    }
+
+    friend BigInteger operator+(const BigInteger& augend, const BigInteger& addend)
+    {
+        BigInteger sum;
+        if (augend.negative == addend.negative)
+        {
+            sum.limbs = addMagnitudes(augend.limbs, addend.limbs);
+            sum.negative = augend.negative;
+        }
+        else if (compareMagnitudes(augend.limbs, addend.limbs) >= 0)
+        {
+            sum.limbs = subtractMagnitudes(augend.limbs, addend.limbs);
+            sum.negative = augend.negative;
+        }
+        else
+        {
+            sum.limbs = subtractMagnitudes(addend.limbs, augend.limbs);
+            sum.negative = addend.negative;
+        }
+
+        sum.normalize();
+        return sum;
+    }
+
+    friend BigInteger operator-(const BigInteger& minuend, const BigInteger& subtrahend)
+    {
+        return minuend + -subtrahend;
+    }
+
+    friend BigInteger operator*(const BigInteger& multiplicand, const BigInteger& multiplier)
+    {
+        BigInteger product;
+        product.limbs = multiplyMagnitudes(multiplicand.limbs, multiplier.limbs);
+        product.negative = multiplicand.negative != multiplier.negative;
+        product.normalize();
+        return product;
+    }
+
+    // quotient = dividend / divisor truncated toward zero; remainder = dividend - quotient * divisor,
+    // provided that divisor != 0
+    static void divide(const BigInteger& dividend, const BigInteger& divisor,
+        BigInteger& quotient, BigInteger& remainder)
+    {
+        divideMagnitudes(dividend.limbs, divisor.limbs, quotient.limbs, remainder.limbs);
+        quotient.negative = dividend.negative != divisor.negative;
+        remainder.negative = dividend.negative;
+        quotient.normalize();
+        remainder.normalize();
+    }
+
+    // returns a negative number, zero or a positive number as value1 <, == or > value2
+    static int compare(const BigInteger& value1, const BigInteger& value2)
+    {
+        if (value1.negative != value2.negative)
+            return value1.negative ? -1 : 1;
+
+        int order = compareMagnitudes(value1.limbs, value2.limbs);
+        return value1.negative ? -order : order;
+    }
+
+    // returns the decimal representation of the value
+    std::string toString() const
+    {
+        if (isZero())
+            return "0";
+
+        // nine decimal digits at a time, least significant group first
+        std::vector< uint32_t > magnitude = limbs;
+        std::vector< uint32_t > groups;
+        while (!magnitude.empty())
+        {
+            unsigned long long remainder = 0;
+            for (size_t i = magnitude.size(); i-- > 0; )
+            {
+                unsigned long long current = (remainder << 32) | magnitude[i];
+                magnitude[i] = static_cast< uint32_t >(current / 1000000000);
+                remainder = current % 1000000000;
+            }
+            while (!magnitude.empty() && magnitude.back() == 0)
+                magnitude.pop_back();
+            groups.push_back(static_cast< uint32_t >(remainder));
+        }
+
+        std::string digits = negative ? "-" : "";
+        digits += std::to_string(groups.back());
+        for (size_t i = groups.size() - 1; i-- > 0; )
+        {
+            std::string group = std::to_string(groups[i]);
+            digits += std::string(9 - group.size(), '0') + group;
+        }
+
+        return digits;
+    }
+
+private:
+    typedef std::vector< uint32_t > Limbs;
+
+    // removes leading zero limbs; zero is never negative
+    void normalize()
+    {
+        while (!limbs.empty() && limbs.back() == 0)
+            limbs.pop_back();
+        if (limbs.empty())
+            negative = false;
+    }
+
+    static int compareMagnitudes(const Limbs& a, const Limbs& b)
+    {
+        if (a.size() != b.size())
+            return a.size() < b.size() ? -1 : 1;
+
+        for (size_t i = a.size(); i-- > 0; )
+            if (a[i] != b[i])
+                return a[i] < b[i] ? -1 : 1;
+
+        return 0;
+    }
+
+    static Limbs addMagnitudes(const Limbs& a, const Limbs& b)
+    {
+        const Limbs& longer = a.size() >= b.size() ? a : b;
+        const Limbs& shorter = a.size() >= b.size() ? b : a;
+
+        Limbs sum(longer.size() + 1);
+        unsigned long long carry = 0;
+        for (size_t i = 0; i < longer.size(); i++)
+        {
+            carry += longer[i];
+            if (i < shorter.size())
+                carry += shorter[i];
+            sum[i] = static_cast< uint32_t >(carry);
+            carry >>= 32;
+        }
+        sum[longer.size()] = static_cast< uint32_t >(carry);
+
+        return sum;
+    }
+
+    // a - b, provided that a >= b
+    static Limbs subtractMagnitudes(const Limbs& a, const Limbs& b)
+    {
+        Limbs difference(a.size());
+        long long borrow = 0;
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            long long current = static_cast< long long >(a[i]) - borrow - (i < b.size() ? b[i] : 0);
+            borrow = current < 0 ? 1 : 0;
+            difference[i] = static_cast< uint32_t >(current + (borrow << 32));
+        }
+
+        return difference;
+    }
+
+    static Limbs multiplyMagnitudes(const Limbs& a, const Limbs& b)
+    {
+        if (a.empty() || b.empty())
+            return Limbs();
+
+        Limbs product(a.size() + b.size());
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            unsigned long long carry = 0;
+            for (size_t j = 0; j < b.size(); j++)
+            {
+                carry += static_cast< unsigned long long >(a[i]) * b[j] + product[i + j];
+                product[i + j] = static_cast< uint32_t >(carry);
+                carry >>= 32;
+            }
+            product[i + b.size()] = static_cast< uint32_t >(carry);
+        }
+
+        return product;
+    }
+
+    // quotient = a / b; remainder = a % b, provided that b != 0;
+    // one-limb divisors ( by far the most common ) take the short path,
+    // longer ones Knuth's algorithm D ( The Art of Computer Programming, 4.3.1 )
+    static void divideMagnitudes(const Limbs& a, const Limbs& b, Limbs& quotient, Limbs& remainder)
+    {
+        if (compareMagnitudes(a, b) < 0)
+        {
+            quotient.clear();
+            remainder = a;
+            return;
+        }
+
+        quotient.assign(a.size() - b.size() + 1, 0);
+
+        if (b.size() == 1)
+        {
+            unsigned long long current = 0;
+            for (size_t i = a.size(); i-- > 0; )
+            {
+                current = (current << 32) | a[i];
+                quotient[i] = static_cast< uint32_t >(current / b[0]);
+                current %= b[0];
+            }
+            remainder.assign(1, static_cast< uint32_t >(current));
+            return;
+        }
+
+        // shift both operands left until the top bit of the divisor is set,
+        // so that every estimated quotient digit is at most 2 too large
+        int shift = 0;
+        while ((b.back() << shift & 0x80000000u) == 0)
+            shift++;
+        Limbs v = shiftLeft(b, shift);
+        Limbs u = shiftLeft(a, shift);
+        u.resize(a.size() + 1);
+
+        const size_t n = v.size();
+        const unsigned long long base = 1ULL << 32;
+        for (size_t j = a.size() - n + 1; j-- > 0; )
+        {
+            // estimate the quotient digit from the top two limbs
+            unsigned long long numerator = (static_cast< unsigned long long >(u[j + n]) << 32) | u[j + n - 1];
+            unsigned long long digit = numerator / v[n - 1];
+            unsigned long long rest = numerator % v[n - 1];
+            while (digit >= base || digit * v[n - 2] > ((rest << 32) | u[j + n - 2]))
+            {
+                digit--;
+                rest += v[n - 1];
+                if (rest >= base)
+                    break;
+            }
+
+            // u[ j .. j + n ] -= digit * v
+            unsigned long long carry = 0;
+            long long borrow = 0;
+            for (size_t i = 0; i < n; i++)
+            {
+                unsigned long long product = digit * v[i] + carry;
+                carry = product >> 32;
+                long long current = static_cast< long long >(u[i + j]) - borrow - static_cast< long long >(product & 0xFFFFFFFF);
+                u[i + j] = static_cast< uint32_t >(current);
+                borrow = current < 0 ? 1 : 0;
+            }
+            long long top = static_cast< long long >(u[j + n]) - borrow - static_cast< long long >(carry);
+            u[j + n] = static_cast< uint32_t >(top);
+
+            // the estimate was one too large: add v back
+            if (top < 0)
+            {
+                digit--;
+                carry = 0;
+                for (size_t i = 0; i < n; i++)
+                {
+                    carry += static_cast< unsigned long long >(u[i + j]) + v[i];
+                    u[i + j] = static_cast< uint32_t >(carry);
+                    carry >>= 32;
+                }
+                u[j + n] = static_cast< uint32_t >(u[j + n] + carry);
+            }
+
+            quotient[j] = static_cast< uint32_t >(digit);
+        }
+
+        u.resize(n);
+        remainder = shiftRight(u, shift);
+    }
+
+    // returns limbs * 2^shift, provided that 0 <= shift < 32
+    static Limbs shiftLeft(const Limbs& limbs, int shift)
+    {
+        Limbs shifted(limbs.size());
+        uint32_t carry = 0;
+        for (size_t i = 0; i < limbs.size(); i++)
+        {
+            shifted[i] = limbs[i] << shift | carry;
+            carry = shift == 0 ? 0 : limbs[i] >> (32 - shift);
+        }
+        if (carry != 0)
+            shifted.push_back(carry);
+
+        return shifted;
+    }
+
+    // returns limbs / 2^shift, provided that 0 <= shift < 32
+    static Limbs shiftRight(const Limbs& limbs, int shift)
+    {
+        Limbs shifted(limbs.size());
+        for (size_t i = 0; i < limbs.size(); i++)
+        {
+            shifted[i] = limbs[i] >> shift;
+            if (shift != 0 && i + 1 < limbs.size())
+                shifted[i] |= limbs[i + 1] << (32 - shift);
+        }
+
+        return shifted;
+    }
+
+    bool negative = false;
+    Limbs limbs;
+};
+
+// an integer stored inline while it is small and as a BigInteger otherwise
+class Coefficient
+{
+public:
+    static const long long smallMax = (1LL << 62) - 1;
+    static const long long smallMin = -(1LL << 62);
+
+    Coefficient()
+        : bits(1)
+    {
+    }
+
+    Coefficient(int value)
+        : bits(tag(value))
+    {
+    }
+
+    Coefficient(long long value)
+        : bits(tag(value))
+    {
+        if (value < smallMin || value > smallMax)
+            setBig(BigInteger(value));
+    }
+
+    Coefficient(const Coefficient& coefficient2)
+        : bits(coefficient2.bits)
+    {
+        if (!coefficient2.isSmall())
+            setBig(coefficient2.big());
+    }
+
+    Coefficient(Coefficient&& coefficient2) noexcept
+        : bits(coefficient2.bits)
+    {
+        coefficient2.bits = 1;
+    }
+
+    ~Coefficient()
+    {
+        if (!isSmall())
+            delete &big();
+    }
+
+    Coefficient& operator=(const Coefficient& coefficient2)
+    {
+        if (isSmall() && coefficient2.isSmall())
+            bits = coefficient2.bits;
+        else if (this != &coefficient2)
+        {
+            if (coefficient2.isSmall())
+            {
+                release();
+                bits = coefficient2.bits;
+            }
+            else if (isSmall())
+                setBig(coefficient2.big());
+            else
+                big() = coefficient2.big();
+        }
+
+        return *this;
+    }
+
+    Coefficient& operator=(Coefficient&& coefficient2) noexcept
+    {
+        std::swap(bits, coefficient2.bits);
+        return *this;
+    }
+
+    // returns true if and only if the value is stored inline
+    bool isSmall() const
+    {
+        return (bits & 1) != 0;
+    }
+
+    // stores the value in value and returns true if it fits in a long long
+    bool toLongLong(long long& value) const
+    {
+        if (isSmall())
+        {
+            value = small();
+            return true;
+        }
+
+        return big().fits(std::numeric_limits< long long >::min(), std::numeric_limits< long long >::max(), value);
+    }
+
+    // returns the value as a BigInteger
+    BigInteger toBigInteger() const
+    {
+        return isSmall() ? BigInteger(small()) : big();
+    }
+
+    std::string toString() const
+    {
+        return isSmall() ? std::to_string(small()) : big().toString();
+    }
+
+    friend Coefficient operator-(const Coefficient& value)
+    {
+        if (value.isSmall() && value.small() != smallMin)
+            return fromSmall(-value.small());
+        return Coefficient(-value.toBigInteger());
+    }
+
+    friend Coefficient operator+(const Coefficient& augend, const Coefficient& addend)
+    {
+        // two small values cannot overflow a long long
+        if (augend.isSmall() && addend.isSmall())
+            return Coefficient(augend.small() + addend.small());
+        return add(augend, addend);
+    }
+
+    friend Coefficient operator-(const Coefficient& minuend, const Coefficient& subtrahend)
+    {
+        if (minuend.isSmall() && subtrahend.isSmall())
+            return Coefficient(minuend.small() - subtrahend.small());
+        return add(minuend, -subtrahend);
+    }
+
+    friend Coefficient operator*(const Coefficient& multiplicand, const Coefficient& multiplier)
+    {
+        if (multiplicand.isSmall() && multiplier.isSmall())
+        {
+            long long a = multiplicand.small();
+            long long b = multiplier.small();
+
+            // factors below 2^31 in magnitude have a product below 2^62
+            const long long half = 1LL << 31;
+            if (a > -half && a < half && b > -half && b < half)
+                return fromSmall(a * b);
+        }
+
+        return multiply(multiplicand, multiplier);
+    }
+
+    friend Coefficient operator/(const Coefficient& dividend, const Coefficient& divisor)
+    {
+        // only smallMin / -1 leaves the small range
+        if (dividend.isSmall() && divisor.isSmall())
+            return Coefficient(dividend.small() / divisor.small());
+        return divide(dividend, divisor, false);
+    }
+
+    friend Coefficient operator%(const Coefficient& dividend, const Coefficient& divisor)
+    {
+        if (dividend.isSmall() && divisor.isSmall())
+            return fromSmall(dividend.small() % divisor.small());
+        return divide(dividend, divisor, true);
+    }
+
+    Coefficient& operator+=(const Coefficient& addend)
+    {
+        if (isSmall() && addend.isSmall())
+        {
+            long long sum = small() + addend.small();
+            if (sum >= smallMin && sum <= smallMax)
+            {
+                bits = tag(sum);
+                return *this;
+            }
+        }
+
+        return *this = add(*this, addend);
+    }
+
+    Coefficient& operator-=(const Coefficient& subtrahend)
+    {
+        if (isSmall() && subtrahend.isSmall())
+        {
+            long long difference = small() - subtrahend.small();
+            if (difference >= smallMin && difference <= smallMax)
+            {
+                bits = tag(difference);
+                return *this;
+            }
+        }
+
+        return *this = add(*this, -subtrahend);
+    }
+
+    Coefficient& operator*=(const Coefficient& multiplier)
+    {
+        return *this = *this * multiplier;
+    }
+
+    Coefficient& operator/=(const Coefficient& divisor)
+    {
+        return *this = *this / divisor;
+    }
+
+    // every value has one representation, so equal values have equal bits or are both big
+    friend bool operator==(const Coefficient& value1, const Coefficient& value2)
+    {
+        if (value1.isSmall() || value2.isSmall())
+            return value1.bits == value2.bits;
+        return BigInteger::compare(value1.big(), value2.big()) == 0;
+    }
+
+    friend bool operator!=(const Coefficient& value1, const Coefficient& value2)
+    {
+        return !(value1 == value2);
+    }
+
+    friend bool operator<(const Coefficient& value1, const Coefficient& value2)
+    {
+        if (value1.isSmall() && value2.isSmall())
+            return value1.small() < value2.small();
+        return BigInteger::compare(value1.toBigInteger(), value2.toBigInteger()) < 0;
+    }
+
+    friend bool operator>(const Coefficient& value1, const Coefficient& value2) { return value2 < value1; }
+    friend bool operator<=(const Coefficient& value1, const Coefficient& value2) { return !(value2 < value1); }
+    friend bool operator>=(const Coefficient& value1, const Coefficient& value2) { return !(value1 < value2); }
+
+    friend std::ostream& operator<<(std::ostream& output, const Coefficient& value)
+    {
+        return output << value.toString();
+    }
+
+private:
+    explicit Coefficient(BigInteger&& value)
+    {
+        long long small = 0;
+        if (value.fits(smallMin, smallMax, small))
+            bits = tag(small);
+        else
+            setBig(std::move(value));
+    }
+
+    // the slow paths, kept out of line so that the small paths stay short enough to inline
+    static Coefficient add(const Coefficient& augend, const Coefficient& addend);
+    static Coefficient multiply(const Coefficient& multiplicand, const Coefficient& multiplier);
+    static Coefficient divide(const Coefficient& dividend, const Coefficient& divisor, bool wantRemainder);
+
+    static uint64_t tag(long long value)
+    {
+        return (static_cast< uint64_t >(value) << 1) | 1;
+    }
+
+    static Coefficient fromSmall(long long value)
+    {
+        Coefficient coefficient;
+        coefficient.bits = tag(value);
+        return coefficient;
+    }
+
+    // the arithmetic shift restores the sign
+    long long small() const
+    {
+        return static_cast< long long >(bits) >> 1;
+    }
+
+    BigInteger& big() const
+    {
+        return *reinterpret_cast< BigInteger* >(static_cast< uintptr_t >(bits));
+    }
+
+    void setBig(BigInteger value)
+    {
+        bits = static_cast< uint64_t >(reinterpret_cast< uintptr_t >(new BigInteger(std::move(value))));
+    }
+
+    void release()
+    {
+        if (!isSmall())
+            delete &big();
+        bits = 1;
+    }
+
+    uint64_t bits; // a tagged small integer or the address of a BigInteger
+};
+
+inline Coefficient Coefficient::add(const Coefficient& augend, const Coefficient& addend)
+{
+    return Coefficient(augend.toBigInteger() + addend.toBigInteger());
+}
+
+inline Coefficient Coefficient::multiply(const Coefficient& multiplicand, const Coefficient& multiplier)
+{
+#ifdef __SIZEOF_INT128__
+    // two small factors often still have a small product
+    if (multiplicand.isSmall() && multiplier.isSmall())
+    {
+        __int128 product = static_cast< __int128 >(multiplicand.small()) * multiplier.small();
+        if (product >= smallMin && product <= smallMax)
+            return fromSmall(static_cast< long long >(product));
+    }
+#endif
+
+    return Coefficient(multiplicand.toBigInteger() * multiplier.toBigInteger());
+}
+
+inline Coefficient Coefficient::divide(const Coefficient& dividend, const Coefficient& divisor, bool wantRemainder)
+{
+    BigInteger quotient;
+    BigInteger remainder;
+    BigInteger::divide(dividend.toBigInteger(), divisor.toBigInteger(), quotient, remainder);
+    return Coefficient(std::move(wantRemainder ? remainder : quotient));
+}
+
+#endif
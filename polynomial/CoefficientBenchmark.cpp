@@ -0,0 +1,282 @@
+// Times the sparse kernels with int, long long and Coefficient coefficients
+//
+// For every pair of the workload it divides dividend by divisor, multiplies divisor by the
+// quotient and adds the remainder, once per coefficient type, and checks that the sum is the
+// dividend. Then it raises every divisor to the powers 2 .. power, where int coefficients
+// overflow ( silently; the int kernels wrap around in practice ): the Coefficient powers are
+// checked by dividing each one by the divisor, and the int powers are compared with them.
+//
+// usage: CoefficientBenchmark file [repetitions [power]]
+//   file         a workload in the legacy or the scalable layout ( see PolynomialGenerator.cpp )
+//   repetitions  the number of times every pair is processed (1)
+//   power        the largest power of every divisor (6)
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <iomanip>
+using std::setw;
+using std::fixed;
+using std::setprecision;
+
+#include <vector>
+using std::vector;
+
+#include <chrono>
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+#include <cstdlib>
+
+#include "PolynomialFile.h"
+#include "Coefficient.h"
+#include "SparseAddition.h"
+#include "SparseMultiplication.h"
+#include "HeapDivision.h"
+
+template< typename Coef >
+struct BasicTerm
+{
+    Coef coef = Coef(); // the coefficient of a term
+    int expon = 0;      // the exponent of a term
+};
+
+// the time spent in every operation
+struct Timing
+{
+    double division = 0.0;
+    double multiplication = 0.0;
+    double addition = 0.0;
+};
+
+// returns a copy of polynomial with coefficients of type Coef
+template< typename Coef >
+vector< BasicTerm< Coef > > convert(const vector< BasicTerm< int > >& polynomial);
+
+// returns a function that appends the terms it is called with to polynomial
+template< typename Coef >
+auto append(vector< BasicTerm< Coef > >& polynomial);
+
+// returns true if and only if polynomial1 == polynomial2, whatever their coefficient types
+template< typename Coef1, typename Coef2 >
+bool equal(const vector< BasicTerm< Coef1 > >& polynomial1, const vector< BasicTerm< Coef2 > >& polynomial2);
+
+// divides, multiplies back and adds every pair repetitions times with coefficients of type Coef;
+// returns the number of sums that differ from their dividends
+template< typename Coef >
+int timeKernels(const vector< vector< BasicTerm< int > > >& dividends,
+    const vector< vector< BasicTerm< int > > >& divisors, int repetitions, Timing& timing);
+
+// raises every divisor to the powers 2 .. power with int and with Coefficient coefficients;
+// returns the number of Coefficient powers whose division by the divisor is not exact
+int timePowers(const vector< vector< BasicTerm< int > > >& divisors, int power,
+    double& intTime, double& coefficientTime, int& numOverflows);
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "usage: CoefficientBenchmark file [repetitions [power]]" << endl;
+        return 1;
+    }
+
+    int repetitions = argc > 2 ? atoi(argv[2]) : 1;
+    int power = argc > 3 ? atoi(argv[3]) : 6;
+
+    vector< vector< BasicTerm< int > > > dividends;
+    vector< vector< BasicTerm< int > > > divisors;
+    if (!readWorkload(argv[1], dividends, divisors))
+    {
+        cerr << "File could not be opened" << endl;
+        return 1;
+    }
+
+    long long numTerms = 0;
+    for (size_t i = 0; i < dividends.size(); i++)
+        numTerms += dividends[i].size();
+
+    cout << dividends.size() << " pairs, " << numTerms << " dividend terms\n\n";
+
+    Timing intTiming;
+    Timing longTiming;
+    Timing coefficientTiming;
+    int numErrors = timeKernels< int >(dividends, divisors, repetitions, intTiming);
+    numErrors += timeKernels< long long >(dividends, divisors, repetitions, longTiming);
+    numErrors += timeKernels< Coefficient >(dividends, divisors, repetitions, coefficientTiming);
+
+    cout << fixed << setprecision(4);
+    cout << setw(16) << "operation" << setw(12) << "int" << setw(12) << "long long"
+        << setw(12) << "Coefficient" << setw(8) << "ratio" << endl;
+
+    auto report = [](const char* operation, double intTime, double longTime, double coefficientTime)
+    {
+        cout << setw(16) << operation << setw(12) << intTime << setw(12) << longTime
+            << setw(12) << coefficientTime << setw(8) << setprecision(2)
+            << (intTime > 0.0 ? coefficientTime / intTime : 0.0) << setprecision(4) << endl;
+    };
+
+    report("division", intTiming.division, longTiming.division, coefficientTiming.division);
+    report("multiplication", intTiming.multiplication, longTiming.multiplication, coefficientTiming.multiplication);
+    report("addition", intTiming.addition, longTiming.addition, coefficientTiming.addition);
+
+    if (power >= 2)
+    {
+        double intTime = 0.0;
+        double coefficientTime = 0.0;
+        int numOverflows = 0;
+        numErrors += timePowers(divisors, power, intTime, coefficientTime, numOverflows);
+
+        cout << "\nPowers 2 .. " << power << " of every divisor\n";
+        cout << setw(16) << "int" << setw(12) << intTime << endl;
+        cout << setw(16) << "Coefficient" << setw(12) << coefficientTime << endl;
+        cout << numOverflows << " of " << divisors.size() * (power - 1) << " int powers overflowed\n";
+    }
+
+    cout << "\nThere are " << numErrors << " errors!\n";
+
+    return numErrors == 0 ? 0 : 1;
+}
+
+// returns a copy of polynomial with coefficients of type Coef
+template< typename Coef >
+vector< BasicTerm< Coef > > convert(const vector< BasicTerm< int > >& polynomial)
+{
+    vector< BasicTerm< Coef > > converted(polynomial.size());
+    for (size_t i = 0; i < polynomial.size(); i++)
+    {
+        converted[i].coef = polynomial[i].coef;
+        converted[i].expon = polynomial[i].expon;
+    }
+
+    return converted;
+}
+
+// returns a function that appends the terms it is called with to polynomial
+template< typename Coef >
+auto append(vector< BasicTerm< Coef > >& polynomial)
+{
+    return [&polynomial](const Coef& coef, int expon)
+    {
+        BasicTerm< Coef > term;
+        term.coef = coef;
+        term.expon = expon;
+        polynomial.push_back(term);
+    };
+}
+
+// returns true if and only if polynomial1 == polynomial2, whatever their coefficient types
+template< typename Coef1, typename Coef2 >
+bool equal(const vector< BasicTerm< Coef1 > >& polynomial1, const vector< BasicTerm< Coef2 > >& polynomial2)
+{
+    if (polynomial1.size() != polynomial2.size())
+        return false;
+
+    for (size_t i = 0; i < polynomial1.size(); i++)
+        if (Coefficient(polynomial1[i].coef) != Coefficient(polynomial2[i].coef) ||
+            polynomial1[i].expon != polynomial2[i].expon)
+            return false;
+
+    return true;
+}
+
+// divides, multiplies back and adds every pair repetitions times with coefficients of type Coef;
+// returns the number of sums that differ from their dividends
+template< typename Coef >
+int timeKernels(const vector< vector< BasicTerm< int > > >& dividends,
+    const vector< vector< BasicTerm< int > > >& divisors, int repetitions, Timing& timing)
+{
+    typedef vector< BasicTerm< Coef > > Polynomial;
+
+    vector< Polynomial > convertedDividends(dividends.size());
+    vector< Polynomial > convertedDivisors(divisors.size());
+    for (size_t i = 0; i < dividends.size(); i++)
+    {
+        convertedDividends[i] = convert< Coef >(dividends[i]);
+        convertedDivisors[i] = convert< Coef >(divisors[i]);
+    }
+
+    int numErrors = 0;
+    Polynomial quotient;
+    Polynomial remainder;
+    Polynomial product;
+    Polynomial sum;
+
+    for (int r = 0; r < repetitions; r++)
+        for (size_t i = 0; i < dividends.size(); i++)
+        {
+            quotient.clear();
+            remainder.clear();
+            product.clear();
+            sum.clear();
+
+            steady_clock::time_point start = steady_clock::now();
+            heapDivision(termLayout(convertedDividends[i]), termLayout(convertedDivisors[i]),
+                append(quotient), append(remainder));
+            steady_clock::time_point divided = steady_clock::now();
+            sparseMultiplication(termLayout(convertedDivisors[i]), termLayout(quotient), append(product));
+            steady_clock::time_point multiplied = steady_clock::now();
+            sparseAddition(termLayout(product), termLayout(remainder), append(sum));
+            steady_clock::time_point added = steady_clock::now();
+
+            timing.division += duration< double >(divided - start).count();
+            timing.multiplication += duration< double >(multiplied - divided).count();
+            timing.addition += duration< double >(added - multiplied).count();
+
+            if (r == 0 && !equal(sum, dividends[i]))
+                numErrors++;
+        }
+
+    return numErrors;
+}
+
+// raises every divisor to the powers 2 .. power with int and with Coefficient coefficients;
+// returns the number of Coefficient powers whose division by the divisor is not exact
+int timePowers(const vector< vector< BasicTerm< int > > >& divisors, int power,
+    double& intTime, double& coefficientTime, int& numOverflows)
+{
+    int numErrors = 0;
+
+    for (size_t i = 0; i < divisors.size(); i++)
+    {
+        // intPowers[ k ] = divisor^( k + 1 ), computed with int coefficients
+        vector< vector< BasicTerm< int > > > intPowers(1, divisors[i]);
+        steady_clock::time_point start = steady_clock::now();
+        for (int k = 1; k < power; k++)
+        {
+            intPowers.push_back(vector< BasicTerm< int > >());
+            sparseMultiplication(termLayout(intPowers[k - 1]), termLayout(divisors[i]), append(intPowers[k]));
+        }
+        steady_clock::time_point intDone = steady_clock::now();
+
+        vector< BasicTerm< Coefficient > > divisor = convert< Coefficient >(divisors[i]);
+        vector< vector< BasicTerm< Coefficient > > > powers(1, divisor);
+        for (int k = 1; k < power; k++)
+        {
+            powers.push_back(vector< BasicTerm< Coefficient > >());
+            sparseMultiplication(termLayout(powers[k - 1]), termLayout(divisor), append(powers[k]));
+        }
+        steady_clock::time_point coefficientDone = steady_clock::now();
+
+        intTime += duration< double >(intDone - start).count();
+        coefficientTime += duration< double >(coefficientDone - intDone).count();
+
+        // divisor^( k + 1 ) / divisor must be divisor^k exactly
+        vector< BasicTerm< Coefficient > > quotient;
+        vector< BasicTerm< Coefficient > > remainder;
+        for (int k = 1; k < power; k++)
+        {
+            quotient.clear();
+            remainder.clear();
+            heapDivision(termLayout(powers[k]), termLayout(divisor), append(quotient), append(remainder));
+            if (!remainder.empty() || !equal(quotient, powers[k - 1]))
+                numErrors++;
+
+            if (!equal(intPowers[k], powers[k]))
+                numOverflows++;
+        }
+    }
+
+    return numErrors;
+}
@@ -0,0 +1,230 @@
+// Compares sparse division engines on the dividend / divisor pairs of a workload
+//
+// usage: DivisionBenchmark file [repetitions]
+//   file         a workload in the legacy or the scalable layout ( see PolynomialGenerator.cpp )
+//   repetitions  the number of times every division is performed (1)
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <iomanip>
+using std::setw;
+using std::fixed;
+using std::setprecision;
+
+#include <vector>
+using std::vector;
+
+#include <chrono>
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+#include <cstdlib>
+
+#include "PolynomialFile.h"
+#include "HeapDivision.h"
+#include "TreeDivision.h"
+
+struct Term
+{
+    int coef = 0;  // the coefficient of a term
+    int expon = 0; // the exponent of a term
+};
+
+// quotient = dividend / divisor; remainder = dividend % divisor,
+// subtracting divisor * monomial from the whole remainder for every quotient term
+// ( the method of hw7 and hw8 before the heap engine )
+void subtractionDivision(const vector< Term >& dividend, const vector< Term >& divisor,
+    vector< Term >& quotient, vector< Term >& remainder);
+
+// quotient = dividend / divisor; remainder = dividend % divisor by the heap engine
+void heapQuotient(const vector< Term >& dividend, const vector< Term >& divisor,
+    vector< Term >& quotient, vector< Term >& remainder);
+
+// quotient = dividend / divisor; remainder = dividend % divisor on a remainder kept in a TermTree
+void treeQuotient(const vector< Term >& dividend, const vector< Term >& divisor,
+    vector< Term >& quotient, vector< Term >& remainder);
+
+// returns true if and only if polynomial1 == polynomial2
+bool equal(const vector< Term >& polynomial1, const vector< Term >& polynomial2);
+
+// returns the number of seconds taken by performing every division repetitions times
+double timeEngine(void (*engine)(const vector< Term >&, const vector< Term >&, vector< Term >&, vector< Term >&),
+    const vector< vector< Term > >& dividends, const vector< vector< Term > >& divisors, int repetitions,
+    vector< vector< Term > >& quotients, vector< vector< Term > >& remainders);
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "usage: DivisionBenchmark file [repetitions]" << endl;
+        return 1;
+    }
+
+    int repetitions = argc > 2 ? atoi(argv[2]) : 1;
+
+    vector< vector< Term > > dividends;
+    vector< vector< Term > > divisors;
+    if (!readWorkload(argv[1], dividends, divisors))
+    {
+        cerr << "File could not be opened" << endl;
+        return 1;
+    }
+
+    long long numTerms = 0;
+    for (size_t i = 0; i < dividends.size(); i++)
+        numTerms += dividends[i].size();
+
+    cout << dividends.size() << " pairs, " << numTerms << " dividend terms\n\n";
+
+    vector< vector< Term > > quotients1, remainders1;
+    vector< vector< Term > > quotients2, remainders2;
+    vector< vector< Term > > quotients3, remainders3;
+
+    double subtractionTime = timeEngine(subtractionDivision, dividends, divisors, repetitions, quotients1, remainders1);
+    double heapTime = timeEngine(heapQuotient, dividends, divisors, repetitions, quotients2, remainders2);
+    double treeTime = timeEngine(treeQuotient, dividends, divisors, repetitions, quotients3, remainders3);
+
+    int numErrors = 0;
+    for (size_t i = 0; i < dividends.size(); i++)
+    {
+        if (!equal(quotients1[i], quotients2[i]) || !equal(remainders1[i], remainders2[i]))
+            numErrors++;
+        if (!equal(quotients1[i], quotients3[i]) || !equal(remainders1[i], remainders3[i]))
+            numErrors++;
+    }
+
+    cout << fixed << setprecision(4);
+    cout << setw(12) << "engine" << setw(14) << "seconds" << endl;
+    cout << setw(12) << "subtraction" << setw(14) << subtractionTime << endl;
+    cout << setw(12) << "heap" << setw(14) << heapTime << endl;
+    cout << setw(12) << "tree" << setw(14) << treeTime << endl;
+    cout << "\nThere are " << numErrors << " errors!\n";
+
+    return numErrors == 0 ? 0 : 1;
+}
+
+// quotient = dividend / divisor; remainder = dividend % divisor,
+// subtracting divisor * monomial from the whole remainder for every quotient term
+void subtractionDivision(const vector< Term >& dividend, const vector< Term >& divisor,
+    vector< Term >& quotient, vector< Term >& remainder)
+{
+    quotient.clear();
+    remainder = dividend;
+
+    vector< Term > difference;
+    while (remainder.size() != 0 && remainder[0].expon >= divisor[0].expon)
+    {
+        Term monomial;
+        monomial.coef = remainder[0].coef / divisor[0].coef;
+        monomial.expon = remainder[0].expon - divisor[0].expon;
+        quotient.push_back(monomial);
+
+        // difference = remainder - divisor * monomial
+        difference.clear();
+        size_t i = 0;
+        size_t j = 0;
+        while (i < remainder.size() || j < divisor.size())
+        {
+            int expon = j < divisor.size() ? divisor[j].expon + monomial.expon : 0;
+            if (j == divisor.size() || (i < remainder.size() && remainder[i].expon > expon))
+                difference.push_back(remainder[i++]);
+            else if (i == remainder.size() || remainder[i].expon < expon)
+            {
+                Term term;
+                term.coef = -divisor[j++].coef * monomial.coef;
+                term.expon = expon;
+                difference.push_back(term);
+            }
+            else
+            {
+                Term term;
+                term.coef = remainder[i++].coef - divisor[j++].coef * monomial.coef;
+                term.expon = expon;
+                if (term.coef != 0)
+                    difference.push_back(term);
+            }
+        }
+
+        remainder.swap(difference);
+    }
+}
+
+// quotient = dividend / divisor; remainder = dividend % divisor by the heap engine
+void heapQuotient(const vector< Term >& dividend, const vector< Term >& divisor,
+    vector< Term >& quotient, vector< Term >& remainder)
+{
+    quotient.clear();
+    remainder.clear();
+
+    heapDivision(termLayout(dividend), termLayout(divisor),
+        [&](int coef, int expon)
+        {
+            Term term;
+            term.coef = coef;
+            term.expon = expon;
+            quotient.push_back(term);
+        },
+        [&](int coef, int expon)
+        {
+            Term term;
+            term.coef = coef;
+            term.expon = expon;
+            remainder.push_back(term);
+        });
+}
+
+// quotient = dividend / divisor; remainder = dividend % divisor on a remainder kept in a TermTree
+void treeQuotient(const vector< Term >& dividend, const vector< Term >& divisor,
+    vector< Term >& quotient, vector< Term >& remainder)
+{
+    quotient.clear();
+    remainder.clear();
+
+    treeDivision(termLayout(dividend), termLayout(divisor),
+        [&](int coef, int expon)
+        {
+            Term term;
+            term.coef = coef;
+            term.expon = expon;
+            quotient.push_back(term);
+        },
+        [&](int coef, int expon)
+        {
+            Term term;
+            term.coef = coef;
+            term.expon = expon;
+            remainder.push_back(term);
+        });
+}
+
+// returns true if and only if polynomial1 == polynomial2
+bool equal(const vector< Term >& polynomial1, const vector< Term >& polynomial2)
+{
+    if (polynomial1.size() != polynomial2.size())
+        return false;
+
+    for (size_t i = 0; i < polynomial1.size(); i++)
+        if (polynomial1[i].coef != polynomial2[i].coef || polynomial1[i].expon != polynomial2[i].expon)
+            return false;
+
+    return true;
+}
+
+// returns the number of seconds taken by performing every division repetitions times
+double timeEngine(void (*engine)(const vector< Term >&, const vector< Term >&, vector< Term >&, vector< Term >&),
+    const vector< vector< Term > >& dividends, const vector< vector< Term > >& divisors, int repetitions,
+    vector< vector< Term > >& quotients, vector< vector< Term > >& remainders)
+{
+    quotients.assign(dividends.size(), vector< Term >());
+    remainders.assign(dividends.size(), vector< Term >());
+
+    steady_clock::time_point start = steady_clock::now();
+    for (int r = 0; r < repetitions; r++)
+        for (size_t i = 0; i < dividends.size(); i++)
+            engine(dividends[i], divisors[i], quotients[i], remainders[i]);
+
+    return duration< double >(steady_clock::now() - start).count();
+}
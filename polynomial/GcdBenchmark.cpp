@@ -0,0 +1,148 @@
+// Computes polynomial gcds with a known common factor from the pairs of a workload
+//
+// For pair i it takes a = divisor[ i ] * dividend[ i ] and b = divisor[ i ] * dividend[ i + 1 ],
+// computes g = gcd( a, b ) by the modular method and checks that g divides a and b, that the
+// primitive part of divisor[ i ] divides g, and that the cofactors a / g and b / g are coprime.
+//
+// usage: GcdBenchmark file [repetitions]
+//   file         a workload in the legacy or the scalable layout ( see PolynomialGenerator.cpp )
+//   repetitions  the number of times every gcd is computed (1)
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <iomanip>
+using std::setw;
+using std::fixed;
+using std::setprecision;
+
+#include <vector>
+using std::vector;
+
+#include <chrono>
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+#include <cstdlib>
+
+#include "PolynomialFile.h"
+#include "PolynomialGcd.h"
+#include "SparseMultiplication.h"
+
+// the products of the workload exceed int, so the coefficients are Coefficients from the start
+typedef vector< GcdTerm > Polynomial;
+
+// returns a function that appends the terms it is called with to polynomial
+auto append(Polynomial& polynomial)
+{
+    return [&polynomial](const Coefficient& coef, int expon)
+    {
+        GcdTerm term;
+        term.coef = coef;
+        term.expon = expon;
+        polynomial.push_back(term);
+    };
+}
+
+// returns a / b, provided that b divides a
+Polynomial exactQuotient(const Polynomial& a, const Polynomial& b);
+
+// returns true if and only if the gcd of a and b is 1
+bool coprime(const Polynomial& a, const Polynomial& b);
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "usage: GcdBenchmark file [repetitions]" << endl;
+        return 1;
+    }
+
+    int repetitions = argc > 2 ? atoi(argv[2]) : 1;
+
+    vector< Polynomial > dividends;
+    vector< Polynomial > divisors;
+    if (!readWorkload(argv[1], dividends, divisors) || dividends.empty())
+    {
+        cerr << "File could not be opened or holds no pairs" << endl;
+        return 1;
+    }
+
+    size_t numPairs = dividends.size();
+    vector< Polynomial > as(numPairs);
+    vector< Polynomial > bs(numPairs);
+    long long numTerms = 0;
+    for (size_t i = 0; i < numPairs; i++)
+    {
+        const Polynomial& next = dividends[(i + 1) % numPairs];
+        sparseMultiplication(termLayout(divisors[i]), termLayout(dividends[i]), append(as[i]));
+        sparseMultiplication(termLayout(divisors[i]), termLayout(next), append(bs[i]));
+        numTerms += as[i].size() + bs[i].size();
+    }
+
+    cout << numPairs << " pairs, " << numTerms << " terms\n\n";
+
+    vector< Polynomial > gcds(numPairs);
+    long long numPrimes = 0;
+    long long numUnluckyPrimes = 0;
+    long long numTrialDivisions = 0;
+
+    steady_clock::time_point start = steady_clock::now();
+    for (int r = 0; r < repetitions; r++)
+        for (size_t i = 0; i < numPairs; i++)
+        {
+            gcds[i].clear();
+            polynomialGcd(termLayout(as[i]), termLayout(bs[i]), append(gcds[i]));
+
+            numPrimes += gcdStatistics().numPrimes;
+            numUnluckyPrimes += gcdStatistics().numUnluckyPrimes;
+            numTrialDivisions += gcdStatistics().numTrialDivisions;
+        }
+    double seconds = duration< double >(steady_clock::now() - start).count();
+
+    int numErrors = 0;
+    for (size_t i = 0; i < numPairs; i++)
+    {
+        // the primitive part of divisor[ i ], with a positive leading coefficient
+        Polynomial factor = divisors[i];
+        Coefficient content = 0;
+        for (size_t t = 0; t < factor.size(); t++)
+            content = integerGcd(content, factor[t].coef);
+        if (factor[0].coef < Coefficient())
+            content = -content;
+        for (size_t t = 0; t < factor.size(); t++)
+            factor[t].coef = factor[t].coef / content;
+
+        if (gcds[i].empty() || !dividesExactly(gcds[i], as[i]) || !dividesExactly(gcds[i], bs[i]) ||
+            !dividesExactly(factor, gcds[i]) ||
+            !coprime(exactQuotient(as[i], gcds[i]), exactQuotient(bs[i], gcds[i])))
+            numErrors++;
+    }
+
+    cout << fixed << setprecision(4);
+    cout << setw(20) << "seconds" << setw(12) << seconds << endl;
+    cout << setw(20) << "primes" << setw(12) << numPrimes << endl;
+    cout << setw(20) << "unlucky primes" << setw(12) << numUnluckyPrimes << endl;
+    cout << setw(20) << "trial divisions" << setw(12) << numTrialDivisions << endl;
+    cout << "\nThere are " << numErrors << " errors!\n";
+
+    return numErrors == 0 ? 0 : 1;
+}
+
+// returns a / b, provided that b divides a
+Polynomial exactQuotient(const Polynomial& a, const Polynomial& b)
+{
+    Polynomial quotient;
+    heapDivision(termLayout(a), termLayout(b), append(quotient), [](const Coefficient&, int) {});
+    return quotient;
+}
+
+// returns true if and only if the gcd of a and b is 1
+bool coprime(const Polynomial& a, const Polynomial& b)
+{
+    Polynomial gcd;
+    polynomialGcd(termLayout(a), termLayout(b), append(gcd));
+    return gcd.size() == 1 && gcd[0].coef == Coefficient(1) && gcd[0].expon == 0;
+}
@@ -0,0 +1,185 @@
+// HashMultiplication.h
+// Sparse polynomial multiplication by hash accumulation.
+//
+// All n * m products are added into a flat open-addressing table keyed by exponent
+// ( power-of-two size, linear probing ), and the nonzero sums are put in order by one
+// LSD radix sort on the exponents. When many products share an exponent this beats
+// the heap merge, which pays O( log n ) for every product.
+
+#ifndef HASH_MULTIPLICATION_H
+#define HASH_MULTIPLICATION_H
+
+#include <utility>
+#include <vector>
+
+#include "HeapMultiplication.h"
+
+// spreads the bits of an exponent over the table ( Fibonacci hashing )
+inline unsigned exponentHash(int expon)
+{
+    return static_cast< unsigned >(expon) * 2654435769u;
+}
+
+// returns a key whose ascending unsigned order is the descending order of the exponents
+inline unsigned descendingKey(int expon)
+{
+    return ~(static_cast< unsigned >(expon) ^ 0x80000000u);
+}
+
+// sorts terms ( members coef and expon ) in descending order of exponents by LSD radix sort,
+// 8 bits per pass; passes in which all terms share the digit are skipped
+template< typename TermType >
+void radixSortDescending(std::vector< TermType >& terms)
+{
+    std::vector< TermType > buffer(terms.size());
+
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        size_t count[257] = {};
+        for (size_t i = 0; i < terms.size(); i++)
+            count[((descendingKey(terms[i].expon) >> shift) & 0xFF) + 1]++;
+
+        bool trivial = false;
+        for (int digit = 1; digit <= 256; digit++)
+            if (count[digit] == terms.size())
+                trivial = true;
+        if (trivial)
+            continue;
+
+        for (int digit = 1; digit <= 256; digit++)
+            count[digit] += count[digit - 1];
+
+        for (size_t i = 0; i < terms.size(); i++)
+            buffer[count[(descendingKey(terms[i].expon) >> shift) & 0xFF]++] = std::move(terms[i]);
+
+        terms.swap(buffer);
+    }
+}
+
+// the table used by hashMultiplication; it keeps its storage between calls
+template< typename Coef >
+class ExponentTable
+{
+public:
+    struct Slot
+    {
+        int expon;
+        Coef coef;
+        bool used;
+    };
+
+    // empties the table and makes room for about expectedSize exponents;
+    // larger tables are reached by growing
+    void clear(long long expectedSize)
+    {
+        int bits = 4;
+        while (bits < 24 && (1LL << bits) < 2 * expectedSize)
+            bits++;
+
+        resize(bits);
+    }
+
+    // table[ expon ] += coef
+    void add(int expon, const Coef& coef)
+    {
+        size_t mask = slots.size() - 1;
+        size_t i = exponentHash(expon) >> shift;
+        while (slots[i].used && slots[i].expon != expon)
+            i = (i + 1) & mask;
+
+        if (slots[i].used)
+        {
+            slots[i].coef += coef;
+            return;
+        }
+
+        slots[i].expon = expon;
+        slots[i].coef = coef;
+        slots[i].used = true;
+
+        // keep the load factor at most 1 / 2
+        if (++numUsed * 2 > slots.size())
+            grow();
+    }
+
+    const std::vector< Slot >& contents() const
+    {
+        return slots;
+    }
+
+private:
+    void resize(int bits)
+    {
+        shift = 32 - bits;
+        numUsed = 0;
+        slots.assign(static_cast< size_t >(1) << bits, Slot{ 0, Coef(), false });
+    }
+
+    void grow()
+    {
+        std::vector< Slot > old;
+        old.swap(slots);
+
+        resize(32 - shift + 1);
+        for (size_t i = 0; i < old.size(); i++)
+            if (old[i].used)
+                add(old[i].expon, old[i].coef);
+    }
+
+    std::vector< Slot > slots;
+    int shift = 28;
+    size_t numUsed = 0;
+};
+
+// returns an upper bound on the number of terms of multiplicand * multiplier
+template< typename Layout1, typename Layout2 >
+long long productSizeBound(const Layout1& multiplicand, const Layout2& multiplier)
+{
+    if (multiplicand.size == 0 || multiplier.size == 0)
+        return 0;
+
+    long long numProducts = static_cast< long long >(multiplicand.size) * multiplier.size;
+    long long span = static_cast< long long >(multiplicand.expon(0)) + multiplier.expon(0) -
+        multiplicand.expon(multiplicand.size - 1) - multiplier.expon(multiplier.size - 1) + 1;
+
+    return numProducts < span ? numProducts : span;
+}
+
+// calls emit( coef, expon ) for every term of multiplicand * multiplier,
+// in descending order of exponents
+template< typename Layout1, typename Layout2, typename Emit >
+void hashMultiplication(const Layout1& multiplicand, const Layout2& multiplier, Emit emit)
+{
+    typedef typename Layout1::Coef Coef;
+
+    struct Sum
+    {
+        Coef coef;
+        int expon;
+    };
+
+    // the table is reused by later calls on the same thread
+    static thread_local ExponentTable< Coef > table;
+    table.clear(productSizeBound(multiplicand, multiplier));
+
+    for (int i = 0; i < multiplicand.size; i++)
+    {
+        Coef coef = multiplicand.coef(i);
+        int expon = multiplicand.expon(i);
+        for (int j = 0; j < multiplier.size; j++)
+            table.add(expon + multiplier.expon(j), coef * multiplier.coef(j));
+    }
+
+    std::vector< Sum > sums;
+    const std::vector< typename ExponentTable< Coef >::Slot >& slots = table.contents();
+    for (size_t i = 0; i < slots.size(); i++)
+        if (slots[i].used && slots[i].coef != Coef())
+            sums.push_back(Sum{ slots[i].coef, slots[i].expon });
+
+    radixSortDescending(sums);
+
+    for (size_t i = 0; i < sums.size(); i++)
+        emit(sums[i].coef, sums[i].expon);
+}
+
+#endif
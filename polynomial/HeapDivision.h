@@ -0,0 +1,165 @@
+// HeapDivision.h
+// Sparse polynomial division in the style of Monagan and Pearce.
+//
+// The remainder is never stored. The terms of dividend - divisor * quotient are produced
+// in descending order of exponents by merging the dividend with a heap that holds one entry
+// per nonleading divisor term ( the products divisor[ i ] * quotient[ j ] ); each new term
+// either yields a quotient term or goes straight to the remainder. The work is
+// O( ( |dividend| + |divisor| * |quotient| ) * log |divisor| ) instead of
+// O( |quotient| * |remainder| ) for repeated subtraction.
+
+#ifndef HEAP_DIVISION_H
+#define HEAP_DIVISION_H
+
+#include <vector>
+
+#include "HeapMultiplication.h"
+
+// returns true if and only if a term of exponent divisorExpon divides a term of exponent expon
+inline bool exponentDivides(int divisorExpon, int expon)
+{
+    return expon >= divisorExpon;
+}
+
+// quotient = dividend / divisor; remainder = dividend % divisor, provided that divisor != 0;
+// calls emitQuotient( coef, expon ) and emitRemainder( coef, expon ) for their terms,
+// each in descending order of exponents.
+// Like the term-by-term division of hw7 and hw8, a quotient coefficient is the integer
+// quotient of the leading coefficients; a term that leaves a nonzero integer remainder
+// contributes that remainder to the remainder polynomial.
+template< typename Layout1, typename Layout2, typename EmitQuotient, typename EmitRemainder >
+void heapDivision(const Layout1& dividend, const Layout2& divisor,
+    EmitQuotient emitQuotient, EmitRemainder emitRemainder)
+{
+    typedef typename Layout1::Coef Coef;
+    typedef typename Layout1::Expon Expon;
+
+    struct Entry
+    {
+        Expon expon; // the exponent of divisor[ row ] * quotient[ column ]
+        int row;
+        int column;
+    };
+
+    // the working storage is reused by later calls on the same thread
+    static thread_local std::vector< Coef > quotientCoef;
+    static thread_local std::vector< Expon > quotientExpon;
+    static thread_local std::vector< Entry > heap;
+    static thread_local std::vector< int > waiting; // rows whose next product needs a quotient term not yet known
+
+    quotientCoef.clear();
+    quotientExpon.clear();
+    heap.clear();
+    waiting.clear();
+
+    heap.reserve(divisor.size);
+    waiting.reserve(divisor.size);
+    for (int row = divisor.size - 1; row >= 1; row--)
+        waiting.push_back(row);
+
+    const Coef leadingCoef = divisor.coef(0);
+    const Expon leadingExpon = divisor.expon(0);
+
+    // restores the heap after the entry at position hole has been replaced by a smaller one
+    auto siftDown = [](int hole)
+    {
+        int size = static_cast< int >(heap.size());
+        Entry entry = heap[hole];
+        for (int child = 2 * hole + 1; child < size; child = 2 * hole + 1)
+        {
+            if (child + 1 < size && heap[child].expon < heap[child + 1].expon)
+                child++;
+            if (!(entry.expon < heap[child].expon))
+                break;
+            heap[hole] = heap[child];
+            hole = child;
+        }
+        heap[hole] = entry;
+    };
+
+    // restores the heap after an entry has been appended
+    auto siftUp = []()
+    {
+        int hole = static_cast< int >(heap.size()) - 1;
+        Entry entry = heap[hole];
+        while (hole > 0 && heap[(hole - 1) / 2].expon < entry.expon)
+        {
+            heap[hole] = heap[(hole - 1) / 2];
+            hole = (hole - 1) / 2;
+        }
+        heap[hole] = entry;
+    };
+
+    int k = 0; // the next term of dividend
+    while (k < dividend.size || !heap.empty())
+    {
+        // the largest exponent not processed yet
+        Expon expon;
+        if (heap.empty() || (k < dividend.size && heap.front().expon < dividend.expon(k)))
+            expon = dividend.expon(k);
+        else
+            expon = heap.front().expon;
+
+        Coef coef = Coef();
+        if (k < dividend.size && dividend.expon(k) == expon)
+        {
+            coef = dividend.coef(k);
+            k++;
+        }
+
+        // subtract every product divisor[ row ] * quotient[ column ] of this exponent
+        while (!heap.empty() && heap.front().expon == expon)
+        {
+            Entry& top = heap.front();
+            coef -= divisor.coef(top.row) * quotientCoef[top.column];
+
+            if (top.column + 1 < static_cast< int >(quotientCoef.size()))
+            {
+                top.column++;
+                top.expon = divisor.expon(top.row) + quotientExpon[top.column];
+                siftDown(0);
+            }
+            else
+            {
+                waiting.push_back(top.row);
+                top = heap.back();
+                heap.pop_back();
+                if (!heap.empty())
+                    siftDown(0);
+            }
+        }
+
+        if (coef == Coef())
+            continue;
+
+        Coef quotient = Coef();
+        if (exponentDivides(leadingExpon, expon))
+            quotient = coef / leadingCoef;
+
+        if (quotient == Coef())
+        {
+            emitRemainder(coef, expon);
+            continue;
+        }
+
+        // a new quotient term; the rows waiting for it resume
+        quotientCoef.push_back(quotient);
+        quotientExpon.push_back(expon - leadingExpon);
+        emitQuotient(quotientCoef.back(), quotientExpon.back());
+
+        int column = static_cast< int >(quotientCoef.size()) - 1;
+        for (size_t i = 0; i < waiting.size(); i++)
+        {
+            int row = waiting[i];
+            heap.push_back(Entry{ divisor.expon(row) + quotientExpon[column], row, column });
+            siftUp();
+        }
+        waiting.clear();
+
+        Coef rest = coef - quotient * leadingCoef;
+        if (rest != Coef())
+            emitRemainder(rest, expon);
+    }
+}
+
+#endif
@@ -0,0 +1,226 @@
+// HeapMultiplication.h
+// Sparse polynomial multiplication by Johnson's heap method.
+//
+// Both operands have their terms in descending order of exponents. At most one heap entry is
+// kept per term of the shorter operand ( a row ), and the products are merged in exponent order
+// straight into the output, so n * m products cost O( n * m * log( min( n, m ) ) ) time and
+// O( min( n, m ) ) extra memory. Row r + 1 enters the heap only after the first product of row r
+// has been taken, which keeps the heap small when the product is sparse.
+
+#ifndef HEAP_MULTIPLICATION_H
+#define HEAP_MULTIPLICATION_H
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "SmallVector.h"
+
+// terms stored as an array of structs with members coef and expon ( hw8 )
+template< typename TermType >
+struct TermLayout
+{
+    typedef decltype(std::declval< TermType >().coef) Coef;
+    typedef decltype(std::declval< TermType >().expon) Expon;
+
+    const TermType* terms;
+    int size;
+
+    const Coef& coef(int i) const { return terms[i].coef; }
+    Expon expon(int i) const { return terms[i].expon; }
+};
+
+// coefficients and exponents stored in two parallel arrays ( hw7 )
+struct ArrayLayout
+{
+    typedef int Coef;
+    typedef int Expon;
+
+    const int* coefficient;
+    const int* exponent;
+    int size;
+
+    Coef coef(int i) const { return coefficient[i]; }
+    Expon expon(int i) const { return exponent[i]; }
+};
+
+template< typename TermType >
+TermLayout< TermType > termLayout(const TermType* terms, int size)
+{
+    return TermLayout< TermType >{ terms, size };
+}
+
+template< typename TermType, typename Allocator >
+TermLayout< TermType > termLayout(const std::vector< TermType, Allocator >& terms)
+{
+    return TermLayout< TermType >{ terms.data(), static_cast< int >(terms.size()) };
+}
+
+inline ArrayLayout arrayLayout(const int* coefficient, const int* exponent, int size)
+{
+    return ArrayLayout{ coefficient, exponent, size };
+}
+
+// appends a term to an array allocated by new[], doubling its capacity when it is full
+template< typename TermType, typename Coef, typename Expon >
+void appendTerm(TermType*& terms, int& size, int& capacity, const Coef& coef, const Expon& expon)
+{
+    if (size == capacity)
+    {
+        capacity = capacity < 4 ? 4 : 2 * capacity;
+        TermType* newTerms = new TermType[capacity];
+        for (int i = 0; i < size; i++)
+            newTerms[i] = terms[i];
+        delete[] terms;
+        terms = newTerms;
+    }
+
+    terms[size].coef = coef;
+    terms[size].expon = expon;
+    size++;
+}
+
+// the number of heap entries a product stream holds without allocating
+const int numInlineRows = 8;
+
+// produces the terms of multiplicand * multiplier one at a time,
+// in descending order of exponents and without zero terms
+template< typename Layout1, typename Layout2 >
+class HeapProductStream
+{
+public:
+    typedef typename Layout1::Coef Coef;
+    typedef typename Layout1::Expon Expon;
+
+    HeapProductStream(const Layout1& multiplicand, const Layout2& multiplier)
+        : left(multiplicand), right(multiplier)
+    {
+        // one entry per row; a row walks the longer operand
+        rowsOnLeft = left.size <= right.size;
+        int numRows = rowsOnLeft ? left.size : right.size;
+        int numColumns = rowsOnLeft ? right.size : left.size;
+
+        heap.reserve(numRows);
+        if (numRows > 0 && numColumns > 0)
+            heap.push_back(Entry{ exponent(0, 0), 0, 0 });
+    }
+
+    // returns false if all terms have been produced;
+    // otherwise stores the next term of the product in coef and expon
+    bool next(Coef& coef, Expon& expon)
+    {
+        int numRows = rowsOnLeft ? left.size : right.size;
+        int numColumns = rowsOnLeft ? right.size : left.size;
+
+        while (!heap.empty())
+        {
+            expon = heap.front().expon;
+            coef = Coef();
+
+            // add up all products with the largest exponent
+            while (!heap.empty() && heap.front().expon == expon)
+            {
+                Entry& top = heap.front();
+                coef += coefficient(top.row, top.column);
+
+                // the next row starts once the first product of this row is taken
+                int nextRow = top.column == 0 && top.row + 1 < numRows ? top.row + 1 : 0;
+
+                if (top.column + 1 < numColumns)
+                {
+                    top.column++;
+                    top.expon = exponent(top.row, top.column);
+                    siftDown();
+                }
+                else
+                {
+                    top = heap.back();
+                    heap.pop_back();
+                    siftDown();
+                }
+
+                if (nextRow != 0)
+                {
+                    heap.push_back(Entry{ exponent(nextRow, 0), nextRow, 0 });
+                    siftUp(static_cast< int >(heap.size()) - 1);
+                }
+            }
+
+            if (coef != Coef())
+                return true;
+        }
+
+        return false;
+    }
+
+private:
+    struct Entry
+    {
+        Expon expon; // the exponent of the product of the current row and column
+        int row;
+        int column;
+    };
+
+    // moves the entry at the top down to its place
+    void siftDown()
+    {
+        int size = static_cast< int >(heap.size());
+        if (size == 0)
+            return;
+
+        Entry entry = heap[0];
+        int hole = 0;
+        for (int child = 1; child < size; child = 2 * hole + 1)
+        {
+            if (child + 1 < size && heap[child].expon < heap[child + 1].expon)
+                child++;
+            if (!(entry.expon < heap[child].expon))
+                break;
+            heap[hole] = heap[child];
+            hole = child;
+        }
+        heap[hole] = entry;
+    }
+
+    // moves the entry at position hole up to its place
+    void siftUp(int hole)
+    {
+        Entry entry = heap[hole];
+        while (hole > 0 && heap[(hole - 1) / 2].expon < entry.expon)
+        {
+            heap[hole] = heap[(hole - 1) / 2];
+            hole = (hole - 1) / 2;
+        }
+        heap[hole] = entry;
+    }
+
+    Coef coefficient(int row, int column) const
+    {
+        return rowsOnLeft ? left.coef(row) * right.coef(column) : left.coef(column) * right.coef(row);
+    }
+
+    Expon exponent(int row, int column) const
+    {
+        return rowsOnLeft ? left.expon(row) + right.expon(column) : left.expon(column) + right.expon(row);
+    }
+
+    Layout1 left;
+    Layout2 right;
+    bool rowsOnLeft;
+    SmallVector< Entry, numInlineRows > heap; // products of up to numInlineRows rows need no allocation
+};
+
+// calls emit( coef, expon ) for every term of multiplicand * multiplier,
+// in descending order of exponents
+template< typename Layout1, typename Layout2, typename Emit >
+void heapMultiplication(const Layout1& multiplicand, const Layout2& multiplier, Emit emit)
+{
+    HeapProductStream< Layout1, Layout2 > stream(multiplicand, multiplier);
+
+    typename Layout1::Coef coef;
+    typename Layout1::Expon expon;
+    while (stream.next(coef, expon))
+        emit(coef, expon);
+}
+
+#endif
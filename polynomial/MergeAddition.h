@@ -0,0 +1,393 @@
+// MergeAddition.h
+// Addition of term arrays by a merge without data-dependent branches.
+//
+// The terms of both operands are first merged into one array in descending order of exponents,
+// so that terms with the same exponent become neighbours; a compaction pass then adds such
+// neighbours and drops the terms that cancel. Each operand has distinct exponents, so at most
+// two terms share an exponent.
+//
+// The scalar merge chooses the next term with a conditional move instead of a branch, which
+// costs the same whether the exponents of the operands interleave randomly or in long runs;
+// it merges from both ends at once, since each choice waits for the loads of the one before.
+// An operand with fewer than 1 / skewedSizeRatio the terms of the other is not merged term by
+// term: each of its terms is found in the larger operand by a galloping search and the run of
+// terms before it is copied as a block, adding like terms on the way.
+// When the compiler targets AVX2 ( -mavx2 or /arch:AVX2 ) and a term is an int coefficient
+// followed by an int exponent, a term is one 64-bit word whose signed value orders terms by
+// exponent, and the merge runs a bitonic network over 4 words per register: the coefficients
+// travel with their exponents without being unpacked.
+
+#ifndef MERGE_ADDITION_H
+#define MERGE_ADDITION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// an operand with fewer than 1 / skewedSizeRatio the terms of the other is added by skewedAddition
+const int skewedSizeRatio = 8;
+
+// sum = large + small, copying the runs of large between the terms of small; sum has room for
+// largeSize + smallSize terms. returns the number of terms of sum
+template< typename TermType >
+int skewedAddition(const TermType* large, int largeSize, const TermType* small, int smallSize, TermType* sum)
+{
+    typedef typename std::remove_cv< decltype(TermType::coef) >::type Coef;
+    typedef typename std::remove_cv< decltype(TermType::expon) >::type Expon;
+
+    const TermType* next = large;
+    const TermType* end = large + largeSize;
+    TermType* k = sum;
+    for (int j = 0; j < smallSize; j++)
+    {
+        // the run is bracketed by doubling steps, so a short run costs a few comparisons
+        Expon expon = small[j].expon;
+        ptrdiff_t step = 1;
+        while (step < end - next && next[step].expon > expon)
+            step *= 2;
+        const TermType* run = std::partition_point(next + step / 2, next + std::min(step, end - next),
+            [expon](const TermType& term) { return term.expon > expon; });
+        k = std::copy(next, run, k);
+        next = run;
+
+        if (next != end && next->expon == expon)
+        {
+            Coef coef = next->coef + small[j].coef;
+            if (coef != Coef())
+            {
+                k->coef = coef;
+                k->expon = expon;
+                k++;
+            }
+            next++;
+        }
+        else
+            *k++ = small[j];
+    }
+
+    k = std::copy(next, end, k);
+    return static_cast< int >(k - sum);
+}
+
+// merges the terms of augend and addend into sum in descending order of exponents,
+// with the term of augend first where the exponents are equal
+template< typename TermType >
+void branchlessMerge(const TermType* augend, int augendSize, const TermType* addend, int addendSize, TermType* sum)
+{
+    if (augendSize == 0 || addendSize == 0)
+    {
+        for (int i = 0; i < augendSize; i++)
+            sum[i] = augend[i];
+        for (int j = 0; j < addendSize; j++)
+            sum[j] = addend[j];
+        return;
+    }
+
+    // the first half of sum is merged from the front and the second half from the back; each
+    // step waits for the loads chosen by the step before, so two independent chains of steps
+    // run about twice as fast as one. an index past the end of an operand is clamped to its
+    // last term, which is then never chosen
+    int size = augendSize + addendSize;
+    int i = 0;                  // the next term of augend from the front
+    int j = 0;                  // the next term of addend from the front
+    int iBack = augendSize - 1; // the next term of augend from the back
+    int jBack = addendSize - 1; // the next term of addend from the back
+
+    for (int k = 0; k < size / 2; k++)
+    {
+        int a = i < augendSize ? i : augendSize - 1;
+        int b = j < addendSize ? j : addendSize - 1;
+        bool takeAugend = (i < augendSize) & ((j >= addendSize) | (augend[a].expon >= addend[b].expon));
+        const TermType* next = takeAugend ? augend + a : addend + b;
+        sum[k] = *next;
+        i += takeAugend;
+        j += !takeAugend;
+
+        a = iBack >= 0 ? iBack : 0;
+        b = jBack >= 0 ? jBack : 0;
+        takeAugend = (iBack >= 0) & ((jBack < 0) | (augend[a].expon < addend[b].expon));
+        next = takeAugend ? augend + a : addend + b;
+        sum[size - 1 - k] = *next;
+        iBack -= takeAugend;
+        jBack -= !takeAugend;
+    }
+
+    // the middle term of an odd number of terms
+    if (size % 2 != 0)
+    {
+        int a = i < augendSize ? i : augendSize - 1;
+        int b = j < addendSize ? j : addendSize - 1;
+        bool takeAugend = (i < augendSize) & ((j >= addendSize) | (augend[a].expon >= addend[b].expon));
+        sum[size / 2] = takeAugend ? augend[a] : addend[b];
+    }
+}
+
+// continues combineTerms from terms[ i ], with k terms kept so far; added tells whether
+// terms[ i ] has been added to the term before it. returns the number of terms left
+template< typename TermType >
+int combineTerms(TermType* terms, int size, int i, int k, bool added)
+{
+    typedef typename std::remove_cv< decltype(TermType::coef) >::type Coef;
+
+    if (i == size)
+        return k;
+
+    // every term is written at k <= i, after terms[ i ] and terms[ i + 1 ] are read; it is kept
+    // unless its coefficient went into the term before it or it cancelled with the next term
+    for (; i + 1 < size; i++)
+    {
+        bool same = terms[i + 1].expon == terms[i].expon;
+        Coef coef = terms[i].coef + (same ? terms[i + 1].coef : Coef());
+        terms[k].expon = terms[i].expon;
+        terms[k].coef = coef;
+        k += (!added) & ((!same) | (coef != Coef()));
+        added = same;
+    }
+
+    terms[k] = terms[size - 1];
+    return k + !added;
+}
+
+// adds the neighbouring terms of terms[ 0 .. size - 1 ] that have the same exponent and drops
+// the sums that are zero; returns the number of terms left
+template< typename TermType >
+int combineTerms(TermType* terms, int size)
+{
+    return combineTerms(terms, size, 0, 0, false);
+}
+
+// returns true if TermType is an int coefficient followed by an int exponent and nothing else
+template< typename TermType >
+constexpr bool isPackedTerm()
+{
+    return std::is_standard_layout< TermType >::value && std::is_trivially_copyable< TermType >::value &&
+        sizeof(TermType) == 8 &&
+        std::is_same< decltype(TermType::coef), int >::value && offsetof(TermType, coef) == 0 &&
+        std::is_same< decltype(TermType::expon), int >::value && offsetof(TermType, expon) == 4;
+}
+
+#ifdef __AVX2__
+
+// puts the larger of each pair of lanes in large and the smaller in small
+inline void minMax(__m256i& large, __m256i& small)
+{
+    __m256i greater = _mm256_cmpgt_epi64(small, large);
+    __m256i larger = _mm256_blendv_epi8(large, small, greater);
+    small = _mm256_blendv_epi8(small, large, greater);
+    large = larger;
+}
+
+// sorts a bitonic sequence of 4 words in descending order
+inline __m256i bitonicClean(__m256i words)
+{
+    // lanes 2 apart, then neighbouring lanes
+    __m256i large = words;
+    __m256i small = _mm256_permute4x64_epi64(words, 0x4E);
+    minMax(large, small);
+    words = _mm256_blend_epi32(large, small, 0xF0);
+
+    large = words;
+    small = _mm256_permute4x64_epi64(words, 0xB1);
+    minMax(large, small);
+    return _mm256_blend_epi32(large, small, 0xCC);
+}
+
+// merges the descending sequences high and low of 4 words each; afterwards high holds the
+// 4 largest words and low the others, both in descending order
+inline void bitonicMerge(__m256i& high, __m256i& low)
+{
+    // high followed by low reversed is bitonic
+    low = _mm256_permute4x64_epi64(low, 0x1B);
+    minMax(high, low);
+    high = bitonicClean(high);
+    low = bitonicClean(low);
+}
+
+// the word of a packed term
+template< typename TermType >
+inline long long termWord(const TermType& term)
+{
+    long long word;
+    std::memcpy(&word, &term, sizeof(word));
+    return word;
+}
+
+// merges the terms of augend and addend into sum in descending order of exponents by a bitonic
+// network; provided that isPackedTerm< TermType >()
+template< typename TermType >
+void bitonicMergeTerms(const TermType* augend, int augendSize, const TermType* addend, int addendSize, TermType* sum)
+{
+    if (augendSize < 8 || addendSize < 8)
+    {
+        branchlessMerge(augend, augendSize, addend, addendSize, sum);
+        return;
+    }
+
+    // as in branchlessMerge, the front and the back of sum are merged by independent chains.
+    // every word written at the front is at least as large as every word not yet written, and
+    // every word written at the back at most as large, because the next 4 words come from the
+    // operand whose next word is larger ( at the back, smaller )
+    __m256i frontHigh = _mm256_loadu_si256(reinterpret_cast< const __m256i* >(augend));
+    __m256i frontLow = _mm256_loadu_si256(reinterpret_cast< const __m256i* >(addend));
+    __m256i backHigh = _mm256_loadu_si256(reinterpret_cast< const __m256i* >(augend + augendSize - 4));
+    __m256i backLow = _mm256_loadu_si256(reinterpret_cast< const __m256i* >(addend + addendSize - 4));
+    int i = 4;                      // augend[ i .. iEnd - 1 ] are not loaded yet
+    int j = 4;                      // addend[ j .. jEnd - 1 ] are not loaded yet
+    int iEnd = augendSize - 4;
+    int jEnd = addendSize - 4;
+    int front = 0;                  // sum[ front .. back - 1 ] are not written yet
+    int back = augendSize + addendSize;
+
+    for (;;)
+    {
+        bitonicMerge(frontHigh, frontLow);
+        _mm256_storeu_si256(reinterpret_cast< __m256i* >(sum + front), frontHigh);
+        front += 4;
+
+        bitonicMerge(backHigh, backLow);
+        back -= 4;
+        _mm256_storeu_si256(reinterpret_cast< __m256i* >(sum + back), backLow);
+
+        // both ends may load from the same operand
+        if (iEnd - i < 8 || jEnd - j < 8)
+            break;
+
+        bool takeAugend = termWord(augend[i]) >= termWord(addend[j]);
+        const TermType* next = takeAugend ? augend + i : addend + j;
+        frontHigh = _mm256_loadu_si256(reinterpret_cast< const __m256i* >(next));
+        i += takeAugend ? 4 : 0;
+        j += takeAugend ? 0 : 4;
+
+        takeAugend = termWord(augend[iEnd - 1]) < termWord(addend[jEnd - 1]);
+        next = takeAugend ? augend + iEnd - 4 : addend + jEnd - 4;
+        backLow = _mm256_loadu_si256(reinterpret_cast< const __m256i* >(next));
+        iEnd -= takeAugend ? 4 : 0;
+        jEnd -= takeAugend ? 0 : 4;
+    }
+
+    // the middle of sum: the words held by both ends, the fewer than 8 left of one operand and
+    // the rest of the other
+    TermType held[8];
+    TermType heldTerms[8];
+    TermType head[16];
+    _mm256_storeu_si256(reinterpret_cast< __m256i* >(held), frontLow);
+    _mm256_storeu_si256(reinterpret_cast< __m256i* >(held + 4), backHigh);
+    branchlessMerge(held, 4, held + 4, 4, heldTerms);
+
+    if (iEnd - i < 8)
+    {
+        branchlessMerge(heldTerms, 8, augend + i, iEnd - i, head);
+        branchlessMerge(head, 8 + iEnd - i, addend + j, jEnd - j, sum + front);
+    }
+    else
+    {
+        branchlessMerge(heldTerms, 8, addend + j, jEnd - j, head);
+        branchlessMerge(head, 8 + jEnd - j, augend + i, iEnd - i, sum + front);
+    }
+}
+
+// the indices of the 32-bit lanes that move the 64-bit lanes set in a mask of 4 bits to the front
+struct LeftPackTable
+{
+    int lanes[16][8];
+
+    LeftPackTable()
+    {
+        for (int mask = 0; mask < 16; mask++)
+        {
+            int n = 0;
+            for (int lane = 0; lane < 4; lane++)
+                if (mask & (1 << lane))
+                {
+                    lanes[mask][n++] = 2 * lane;
+                    lanes[mask][n++] = 2 * lane + 1;
+                }
+            while (n < 8)
+                lanes[mask][n++] = 0;
+        }
+    }
+};
+
+// combineTerms for packed terms, 4 at a time: the terms kept of every 4 are moved to the front
+// of a register by one permutation and stored together; provided that isPackedTerm< TermType >()
+template< typename TermType >
+int combinePackedTerms(TermType* terms, int size)
+{
+    static const LeftPackTable table;
+
+    const __m256i coefLanes = _mm256_set1_epi64x(0xFFFFFFFFLL);
+    int k = 0;
+    bool added = false;
+    int i = 0;
+
+    // the 4 terms from i and the 4 from i + 1 are loaded before anything is stored at k <= i
+    for (; i + 5 <= size; i += 4)
+    {
+        __m256i current = _mm256_loadu_si256(reinterpret_cast< const __m256i* >(terms + i));
+        __m256i next = _mm256_loadu_si256(reinterpret_cast< const __m256i* >(terms + i + 1));
+
+        // all bits of a lane are set where its exponent is that of the next term
+        __m256i same = _mm256_shuffle_epi32(_mm256_cmpeq_epi32(current, next), 0xF5);
+        __m256i sum = _mm256_add_epi32(current, _mm256_and_si256(next, _mm256_and_si256(same, coefLanes)));
+
+        // lanes whose term was added to the one before, and sums that cancelled
+        __m256i previousSame = _mm256_permute4x64_epi64(same, 0x90);
+        previousSame = _mm256_blend_epi32(previousSame, _mm256_set1_epi64x(added ? -1LL : 0LL), 0x03);
+        __m256i zero = _mm256_shuffle_epi32(_mm256_cmpeq_epi32(sum, _mm256_setzero_si256()), 0xA0);
+        __m256i drop = _mm256_or_si256(previousSame, _mm256_and_si256(same, zero));
+
+        int keep = ~_mm256_movemask_pd(_mm256_castsi256_pd(drop)) & 0xF;
+        __m256i lanes = _mm256_loadu_si256(reinterpret_cast< const __m256i* >(table.lanes[keep]));
+        _mm256_storeu_si256(reinterpret_cast< __m256i* >(terms + k), _mm256_permutevar8x32_epi32(sum, lanes));
+
+        k += static_cast< int >((0x4332322132212110ULL >> (4 * keep)) & 0xF); // the bits set in keep
+        added = (_mm256_movemask_pd(_mm256_castsi256_pd(same)) & 0x8) != 0;
+    }
+
+    return combineTerms(terms, size, i, k, added);
+}
+
+#endif
+
+// merges the terms of augend and addend into sum in descending order of exponents
+template< typename TermType >
+void mergeTerms(const TermType* augend, int augendSize, const TermType* addend, int addendSize, TermType* sum)
+{
+#ifdef __AVX2__
+    if constexpr (isPackedTerm< TermType >())
+    {
+        bitonicMergeTerms(augend, augendSize, addend, addendSize, sum);
+        return;
+    }
+#endif
+
+    branchlessMerge(augend, augendSize, addend, addendSize, sum);
+}
+
+// sum = augend + addend for operands in descending order of exponents; sum has room for
+// augendSize + addendSize terms and does not overlap the operands. terms that cancel are
+// dropped; returns the number of terms of sum
+template< typename TermType >
+int mergeAddition(const TermType* augend, int augendSize, const TermType* addend, int addendSize, TermType* sum)
+{
+    if (addendSize < augendSize / skewedSizeRatio)
+        return skewedAddition(augend, augendSize, addend, addendSize, sum);
+    if (augendSize < addendSize / skewedSizeRatio)
+        return skewedAddition(addend, addendSize, augend, augendSize, sum);
+
+    mergeTerms(augend, augendSize, addend, addendSize, sum);
+
+#ifdef __AVX2__
+    if constexpr (isPackedTerm< TermType >())
+        return combinePackedTerms(sum, augendSize + addendSize);
+#endif
+
+    return combineTerms(sum, augendSize + addendSize);
+}
+
+#endif
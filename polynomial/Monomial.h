@@ -0,0 +1,158 @@
+// Monomial.h
+// Monomials in up to 8 variables packed into one 64-bit word.
+//
+// A monomial x1^e1 * ... * xN^eN is stored as N + 1 bit fields of 64 / ( N + 1 ) bits each:
+// the total degree e1 + ... + eN in the most significant field, then e1, ..., eN. Comparing
+// two packed words as unsigned integers is then the graded lexicographic order, and
+// multiplying two monomials is one addition. The top bit of every field is a guard bit that
+// stays clear for valid monomials; it catches a field that overflows in a product and makes
+// the divisibility test one subtraction and one mask.
+//
+// The sparse kernels work on monomials unchanged: TermLayout takes the exponent type from
+// the term, the heaps compare and add exponents, and heapDivision finds the
+// exponentDivides overload below.
+
+#ifndef MONOMIAL_H
+#define MONOMIAL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+const int maxVariables = 8;
+
+// returns the number of bits of a field when numVariables variables are packed
+inline int monomialFieldBits(int numVariables)
+{
+    return 64 / (numVariables + 1);
+}
+
+// returns the largest total degree a packed monomial in numVariables variables can hold
+inline int maxPackedDegree(int numVariables)
+{
+    return static_cast< int >((1ULL << (monomialFieldBits(numVariables) - 1)) - 1);
+}
+
+template< int N >
+struct Monomial
+{
+    static_assert(N >= 1 && N <= maxVariables, "a monomial has 1 to 8 variables");
+
+    static const int fieldBits = 64 / (N + 1);
+
+    // the guard bits of all fields
+    static constexpr uint64_t guardMask()
+    {
+        uint64_t mask = 0;
+        for (int field = 0; field <= N; field++)
+            mask |= 1ULL << (field * fieldBits + fieldBits - 1);
+        return mask;
+    }
+
+    uint64_t bits = 0;
+
+    // returns the exponent of variable ( 1 .. N ); variable 0 is the total degree
+    int exponent(int variable) const
+    {
+        return static_cast< int >((bits >> ((N - variable) * fieldBits)) & ((1ULL << fieldBits) - 1));
+    }
+
+    bool operator==(const Monomial& monomial2) const { return bits == monomial2.bits; }
+    bool operator!=(const Monomial& monomial2) const { return bits != monomial2.bits; }
+    bool operator<(const Monomial& monomial2) const { return bits < monomial2.bits; }
+    bool operator>(const Monomial& monomial2) const { return bits > monomial2.bits; }
+    bool operator<=(const Monomial& monomial2) const { return bits <= monomial2.bits; }
+    bool operator>=(const Monomial& monomial2) const { return bits >= monomial2.bits; }
+
+    // the product of two monomials
+    Monomial operator+(const Monomial& monomial2) const
+    {
+        return Monomial{ bits + monomial2.bits };
+    }
+
+    // the quotient of two monomials, provided that monomial2 divides this monomial
+    Monomial operator-(const Monomial& monomial2) const
+    {
+        return Monomial{ bits - monomial2.bits };
+    }
+};
+
+// packs exponents[ 0 .. N - 1 ] into monomial;
+// returns false if an exponent is negative or the total degree does not fit in a field
+template< int N >
+bool packMonomial(const int* exponents, Monomial< N >& monomial)
+{
+    long long degree = 0;
+    for (int i = 0; i < N; i++)
+    {
+        if (exponents[i] < 0)
+            return false;
+        degree += exponents[i];
+    }
+    if (degree > maxPackedDegree(N))
+        return false;
+
+    monomial.bits = static_cast< uint64_t >(degree);
+    for (int i = 0; i < N; i++)
+        monomial.bits = (monomial.bits << Monomial< N >::fieldBits) | static_cast< uint64_t >(exponents[i]);
+
+    return true;
+}
+
+// returns true if and only if a field of monomial has overflowed into its guard bit
+template< int N >
+bool overflows(const Monomial< N >& monomial)
+{
+    return (monomial.bits & Monomial< N >::guardMask()) != 0;
+}
+
+// returns true if and only if every exponent of divisorExpon is at most that of expon;
+// the guard bits absorb the borrows, so no field is inspected on its own
+template< int N >
+bool exponentDivides(const Monomial< N >& divisorExpon, const Monomial< N >& expon)
+{
+    const uint64_t guard = Monomial< N >::guardMask();
+    return (((expon.bits | guard) - divisorExpon.bits) & guard) == guard;
+}
+
+// a term of a multivariate polynomial
+template< int N >
+struct MultivariateTerm
+{
+    int coef = 0;          // the coefficient of a term
+    Monomial< N > expon;   // the packed exponents of a term
+};
+
+// builds a polynomial from coefficients[ i ] and exponents[ i * N .. i * N + N - 1 ],
+// in descending graded order with like terms combined;
+// returns false if a monomial does not fit in the packing
+template< int N, typename TermType >
+bool packPolynomial(const std::vector< int >& coefficients, const std::vector< int >& exponents,
+    std::vector< TermType >& polynomial)
+{
+    polynomial.resize(coefficients.size());
+    for (size_t i = 0; i < coefficients.size(); i++)
+    {
+        polynomial[i].coef = coefficients[i];
+        if (!packMonomial< N >(&exponents[i * N], polynomial[i].expon))
+            return false;
+    }
+
+    std::sort(polynomial.begin(), polynomial.end(),
+        [](const TermType& a, const TermType& b) { return a.expon > b.expon; });
+
+    size_t k = 0;
+    for (size_t i = 0; i < polynomial.size(); )
+    {
+        TermType term = polynomial[i];
+        for (i++; i < polynomial.size() && polynomial[i].expon == term.expon; i++)
+            term.coef += polynomial[i].coef;
+        if (term.coef != 0)
+            polynomial[k++] = term;
+    }
+    polynomial.resize(k);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,279 @@
+// Compares sparse multiplication kernels on the dividend * divisor products of a workload
+//
+// usage: MultiplicationBenchmark file [repetitions [threads]]
+//   file         a workload in the legacy or the scalable layout ( see PolynomialGenerator.cpp )
+//   repetitions  the number of times every product is computed (1)
+//   threads      the number of threads of the parallel kernel (all cores)
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <iomanip>
+using std::setw;
+using std::fixed;
+using std::setprecision;
+
+#include <vector>
+using std::vector;
+
+#include <string>
+using std::string;
+
+#include <chrono>
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+#include <cstdlib>
+
+#include "PolynomialFile.h"
+#include "SparseMultiplication.h"
+
+struct Term
+{
+    int coef = 0;  // the coefficient of a term
+    int expon = 0; // the exponent of a term
+};
+
+// product = multiplicand * multiplier, merging one scaled row of multiplicand at a time
+// ( the method of hw7 and hw8 before the heap kernel )
+void rowMultiplication(const vector< Term >& multiplicand, const vector< Term >& multiplier,
+    vector< Term >& product);
+
+// product = multiplicand * multiplier by Johnson's heap method
+void heapProduct(const vector< Term >& multiplicand, const vector< Term >& multiplier,
+    vector< Term >& product);
+
+// product = multiplicand * multiplier by hash accumulation
+void hashProduct(const vector< Term >& multiplicand, const vector< Term >& multiplier,
+    vector< Term >& product);
+
+// product = multiplicand * multiplier by radix sorting all term products on numParallelThreads threads
+void radixProduct(const vector< Term >& multiplicand, const vector< Term >& multiplier,
+    vector< Term >& product);
+
+// product = multiplicand * multiplier by the kernel chosen by sparseMultiplication
+void sparseProduct(const vector< Term >& multiplicand, const vector< Term >& multiplier,
+    vector< Term >& product);
+
+// product = multiplicand * multiplier on numParallelThreads threads
+void parallelProduct(const vector< Term >& multiplicand, const vector< Term >& multiplier,
+    vector< Term >& product);
+
+// the number of threads used by parallelProduct
+int numParallelThreads = defaultThreadCount();
+
+// returns true if and only if polynomial1 == polynomial2
+bool equal(const vector< Term >& polynomial1, const vector< Term >& polynomial2);
+
+typedef void (*Kernel)(const vector< Term >&, const vector< Term >&, vector< Term >&);
+
+// returns the number of seconds taken by computing every product repetitions times
+double timeKernel(Kernel kernel, const vector< vector< Term > >& dividends,
+    const vector< vector< Term > >& divisors, int repetitions, vector< vector< Term > >& products);
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "usage: MultiplicationBenchmark file [repetitions [threads]]" << endl;
+        return 1;
+    }
+
+    int repetitions = argc > 2 ? atoi(argv[2]) : 1;
+    if (argc > 3)
+        numParallelThreads = atoi(argv[3]);
+
+    vector< vector< Term > > dividends;
+    vector< vector< Term > > divisors;
+    if (!readWorkload(argv[1], dividends, divisors))
+    {
+        cerr << "File could not be opened" << endl;
+        return 1;
+    }
+
+    long long numProducts = 0;
+    for (size_t i = 0; i < dividends.size(); i++)
+        numProducts += static_cast< long long >(dividends[i].size()) * divisors[i].size();
+
+    cout << dividends.size() << " pairs, " << numProducts << " term products per repetition\n\n";
+
+    const int numKernels = 6;
+    const char* names[numKernels] = { "row", "heap", "hash", "radix", "auto", "parallel" };
+    Kernel kernels[numKernels] = { rowMultiplication, heapProduct, hashProduct, radixProduct, sparseProduct, parallelProduct };
+
+    vector< vector< Term > > expected;
+    vector< vector< Term > > products;
+
+    cout << fixed << setprecision(4);
+    cout << setw(8) << "kernel" << setw(14) << "seconds" << setw(14) << "ns / product" << endl;
+
+    int numErrors = 0;
+    for (int k = 0; k < numKernels; k++)
+    {
+        double seconds = timeKernel(kernels[k], dividends, divisors, repetitions, k == 0 ? expected : products);
+        cout << setw(8) << names[k] << setw(14) << seconds
+            << setw(14) << seconds * 1e9 / (numProducts * repetitions) << endl;
+
+        if (k > 0)
+            for (size_t i = 0; i < expected.size(); i++)
+                if (!equal(expected[i], products[i]))
+                    numErrors++;
+    }
+
+    cout << "\nThere are " << numErrors << " errors!\n";
+
+    return numErrors == 0 ? 0 : 1;
+}
+
+// product = multiplicand * multiplier, merging one scaled row of multiplicand at a time
+void rowMultiplication(const vector< Term >& multiplicand, const vector< Term >& multiplier,
+    vector< Term >& product)
+{
+    product.clear();
+
+    vector< Term > buffer(multiplicand.size());
+    vector< Term > sum;
+
+    for (size_t j = 0; j < multiplier.size(); j++)
+    {
+        for (size_t i = 0; i < multiplicand.size(); i++)
+        {
+            buffer[i].coef = multiplicand[i].coef * multiplier[j].coef;
+            buffer[i].expon = multiplicand[i].expon + multiplier[j].expon;
+        }
+
+        // sum = product + buffer
+        sum.clear();
+        size_t i = 0;
+        size_t k = 0;
+        while (i < product.size() || k < buffer.size())
+        {
+            if (k == buffer.size() || (i < product.size() && product[i].expon > buffer[k].expon))
+                sum.push_back(product[i++]);
+            else if (i == product.size() || product[i].expon < buffer[k].expon)
+                sum.push_back(buffer[k++]);
+            else
+            {
+                Term term;
+                term.coef = product[i].coef + buffer[k].coef;
+                term.expon = product[i].expon;
+                if (term.coef != 0)
+                    sum.push_back(term);
+                i++;
+                k++;
+            }
+        }
+
+        product.swap(sum);
+    }
+}
+
+// product = multiplicand * multiplier by Johnson's heap method
+void heapProduct(const vector< Term >& multiplicand, const vector< Term >& multiplier,
+    vector< Term >& product)
+{
+    product.clear();
+    heapMultiplication(termLayout(multiplicand), termLayout(multiplier),
+        [&](int coef, int expon)
+        {
+            Term term;
+            term.coef = coef;
+            term.expon = expon;
+            product.push_back(term);
+        });
+}
+
+// product = multiplicand * multiplier by hash accumulation
+void hashProduct(const vector< Term >& multiplicand, const vector< Term >& multiplier,
+    vector< Term >& product)
+{
+    product.clear();
+    hashMultiplication(termLayout(multiplicand), termLayout(multiplier),
+        [&](int coef, int expon)
+        {
+            Term term;
+            term.coef = coef;
+            term.expon = expon;
+            product.push_back(term);
+        });
+}
+
+// product = multiplicand * multiplier by radix sorting all term products on numParallelThreads threads
+void radixProduct(const vector< Term >& multiplicand, const vector< Term >& multiplier,
+    vector< Term >& product)
+{
+    product.clear();
+    radixMultiplication(termLayout(multiplicand), termLayout(multiplier),
+        [&](int coef, int expon)
+        {
+            Term term;
+            term.coef = coef;
+            term.expon = expon;
+            product.push_back(term);
+        },
+        numParallelThreads);
+}
+
+// product = multiplicand * multiplier by the kernel chosen by sparseMultiplication
+void sparseProduct(const vector< Term >& multiplicand, const vector< Term >& multiplier,
+    vector< Term >& product)
+{
+    product.clear();
+    sparseMultiplication(termLayout(multiplicand), termLayout(multiplier),
+        [&](int coef, int expon)
+        {
+            Term term;
+            term.coef = coef;
+            term.expon = expon;
+            product.push_back(term);
+        });
+}
+
+// product = multiplicand * multiplier on numParallelThreads threads
+void parallelProduct(const vector< Term >& multiplicand, const vector< Term >& multiplier,
+    vector< Term >& product)
+{
+    product.clear();
+    parallelMultiplication(termLayout(multiplicand), termLayout(multiplier),
+        [&](int coef, int expon)
+        {
+            Term term;
+            term.coef = coef;
+            term.expon = expon;
+            product.push_back(term);
+        },
+        numParallelThreads,
+        [](const auto& block, const TermLayout< Term >& factor, auto emitBlock)
+        {
+            sequentialMultiplication(block, factor, emitBlock);
+        });
+}
+
+// returns true if and only if polynomial1 == polynomial2
+bool equal(const vector< Term >& polynomial1, const vector< Term >& polynomial2)
+{
+    if (polynomial1.size() != polynomial2.size())
+        return false;
+
+    for (size_t i = 0; i < polynomial1.size(); i++)
+        if (polynomial1[i].coef != polynomial2[i].coef || polynomial1[i].expon != polynomial2[i].expon)
+            return false;
+
+    return true;
+}
+
+// returns the number of seconds taken by computing every product repetitions times
+double timeKernel(Kernel kernel, const vector< vector< Term > >& dividends,
+    const vector< vector< Term > >& divisors, int repetitions, vector< vector< Term > >& products)
+{
+    products.assign(dividends.size(), vector< Term >());
+
+    steady_clock::time_point start = steady_clock::now();
+    for (int r = 0; r < repetitions; r++)
+        for (size_t i = 0; i < dividends.size(); i++)
+            kernel(dividends[i], divisors[i], products[i]);
+
+    return duration< double >(steady_clock::now() - start).count();
+}
@@ -0,0 +1,184 @@
+// Divides the multivariate dividend / divisor pairs of a workload and checks every result
+//
+// For every pair it computes quotient and remainder by heap division in graded order,
+// then buffer = divisor * quotient and buffer + remainder, and compares the sum with the
+// dividend; no term of the remainder may be divisible by the leading term of the divisor.
+//
+// usage: MultivariateBenchmark file [repetitions]
+//   file         a workload in the multivariate layout ( PolynomialGenerator --variables n )
+//   repetitions  the number of times every pair is processed (1)
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <iomanip>
+using std::setw;
+using std::fixed;
+using std::setprecision;
+
+#include <fstream>
+using std::ifstream;
+using std::ios;
+
+#include <vector>
+using std::vector;
+
+#include <chrono>
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+#include <cstdlib>
+
+#include "PolynomialFile.h"
+#include "Monomial.h"
+#include "SparseAddition.h"
+#include "SparseMultiplication.h"
+#include "HeapDivision.h"
+
+// the time spent in every operation
+struct Timing
+{
+    double division = 0.0;
+    double multiplication = 0.0;
+    double addition = 0.0;
+};
+
+// inputs all pairs, divides them repetitions times and reports the number of wrong results
+template< int N >
+int run(ifstream& inFile, int numPairs, int repetitions);
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "usage: MultivariateBenchmark file [repetitions]" << endl;
+        return 1;
+    }
+
+    int repetitions = argc > 2 ? atoi(argv[2]) : 1;
+
+    ifstream inFile(argv[1], ios::in | ios::binary);
+    int numPairs = 0;
+    int numVariables = 0;
+    if (!inFile || !readMultivariateHeader(inFile, numPairs, numVariables))
+    {
+        cerr << "File could not be opened or is not in the multivariate layout" << endl;
+        return 1;
+    }
+
+    int numErrors = 0;
+    switch (numVariables)
+    {
+    case 1: numErrors = run< 1 >(inFile, numPairs, repetitions); break;
+    case 2: numErrors = run< 2 >(inFile, numPairs, repetitions); break;
+    case 3: numErrors = run< 3 >(inFile, numPairs, repetitions); break;
+    case 4: numErrors = run< 4 >(inFile, numPairs, repetitions); break;
+    case 5: numErrors = run< 5 >(inFile, numPairs, repetitions); break;
+    case 6: numErrors = run< 6 >(inFile, numPairs, repetitions); break;
+    case 7: numErrors = run< 7 >(inFile, numPairs, repetitions); break;
+    case 8: numErrors = run< 8 >(inFile, numPairs, repetitions); break;
+    default:
+        cerr << "At most " << maxVariables << " variables are supported" << endl;
+        return 1;
+    }
+
+    cout << "\nThere are " << numErrors << " errors!\n";
+    return numErrors == 0 ? 0 : 1;
+}
+
+// inputs all pairs, divides them repetitions times and reports the number of wrong results
+template< int N >
+int run(ifstream& inFile, int numPairs, int repetitions)
+{
+    typedef MultivariateTerm< N > Term;
+
+    vector< vector< Term > > dividends(numPairs);
+    vector< vector< Term > > divisors(numPairs);
+    vector< int > coefficients;
+    vector< int > exponents;
+    long long numTerms = 0;
+
+    for (int i = 0; i < numPairs; i++)
+    {
+        if (!readMultivariate(inFile, N, coefficients, exponents) ||
+            !packPolynomial< N >(coefficients, exponents, dividends[i]) ||
+            !readMultivariate(inFile, N, coefficients, exponents) ||
+            !packPolynomial< N >(coefficients, exponents, divisors[i]) || divisors[i].empty())
+        {
+            cerr << "Pair " << i << " could not be read or does not fit in packed monomials" << endl;
+            return numPairs;
+        }
+        numTerms += dividends[i].size();
+    }
+
+    cout << numPairs << " pairs in " << N << " variables, " << numTerms << " dividend terms, "
+        << Monomial< N >::fieldBits << "-bit fields\n\n";
+
+    auto append = [](vector< Term >& polynomial)
+    {
+        return [&polynomial](int coef, const Monomial< N >& expon)
+        {
+            Term term;
+            term.coef = coef;
+            term.expon = expon;
+            polynomial.push_back(term);
+        };
+    };
+
+    Timing timing;
+    int numErrors = 0;
+    vector< Term > quotient;
+    vector< Term > remainder;
+    vector< Term > buffer;
+    vector< Term > sum;
+
+    for (int r = 0; r < repetitions; r++)
+        for (int i = 0; i < numPairs; i++)
+        {
+            quotient.clear();
+            remainder.clear();
+            buffer.clear();
+            sum.clear();
+
+            steady_clock::time_point start = steady_clock::now();
+            heapDivision(termLayout(dividends[i]), termLayout(divisors[i]), append(quotient), append(remainder));
+            steady_clock::time_point divided = steady_clock::now();
+
+            // the leading product has the highest total degree, so if it fits, every product fits
+            bool fits = quotient.empty() || !overflows(divisors[i][0].expon + quotient[0].expon);
+            if (fits)
+                sparseMultiplication(termLayout(divisors[i]), termLayout(quotient), append(buffer));
+            steady_clock::time_point multiplied = steady_clock::now();
+
+            sparseAddition(termLayout(buffer), termLayout(remainder), append(sum));
+            steady_clock::time_point added = steady_clock::now();
+
+            timing.division += duration< double >(divided - start).count();
+            timing.multiplication += duration< double >(multiplied - divided).count();
+            timing.addition += duration< double >(added - multiplied).count();
+
+            if (r > 0)
+                continue;
+
+            bool correct = fits && sum.size() == dividends[i].size();
+            for (size_t t = 0; correct && t < sum.size(); t++)
+                if (sum[t].coef != dividends[i][t].coef || sum[t].expon != dividends[i][t].expon)
+                    correct = false;
+            for (size_t t = 0; correct && t < remainder.size(); t++)
+                if (exponentDivides(divisors[i][0].expon, remainder[t].expon))
+                    correct = false;
+
+            if (!correct)
+                numErrors++;
+        }
+
+    cout << fixed << setprecision(4);
+    cout << setw(16) << "operation" << setw(12) << "seconds" << endl;
+    cout << setw(16) << "division" << setw(12) << timing.division << endl;
+    cout << setw(16) << "multiplication" << setw(12) << timing.multiplication << endl;
+    cout << setw(16) << "addition" << setw(12) << timing.addition << endl;
+
+    return numErrors;
+}
@@ -0,0 +1,192 @@
+// ParallelMultiplication.h
+// Sparse polynomial multiplication on several threads.
+//
+// The multiplicand is cut into one block of consecutive terms per thread, and every thread
+// multiplies its block by the whole multiplier with a sequential kernel, giving a sorted
+// partial product. The partial products are then merged in parallel: a few exponents sampled
+// from them split the exponent axis into one range per thread, and every thread merges the
+// slices of all partial products that fall in its range. Equal exponents always meet in the
+// same range and are added in the order of the blocks, so the result does not depend on the
+// scheduling of the threads.
+
+#ifndef PARALLEL_MULTIPLICATION_H
+#define PARALLEL_MULTIPLICATION_H
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// the terms from first to first + size - 1 of another layout
+template< typename Layout >
+struct RangeLayout
+{
+    typedef typename Layout::Coef Coef;
+    typedef typename Layout::Expon Expon;
+
+    const Layout* layout;
+    int first;
+    int size;
+
+    decltype(auto) coef(int i) const { return layout->coef(first + i); }
+    Expon expon(int i) const { return layout->expon(first + i); }
+};
+
+// returns the number of threads used when none is given
+inline int defaultThreadCount()
+{
+    unsigned numCores = std::thread::hardware_concurrency();
+    return numCores == 0 ? 1 : static_cast< int >(numCores);
+}
+
+// the number of exponents taken from every partial product for every range
+const int numSamplesPerRange = 16;
+
+// calls emit( coef, expon ) for every term of multiplicand * multiplier,
+// in descending order of exponents, using numThreads threads;
+// kernel( multiplicand, multiplier, emit ) is the sequential multiplication used for every block.
+// emit is called on the calling thread only.
+template< typename Layout1, typename Layout2, typename Emit, typename Kernel >
+void parallelMultiplication(const Layout1& multiplicand, const Layout2& multiplier, Emit emit,
+    int numThreads, Kernel kernel)
+{
+    typedef typename Layout1::Coef Coef;
+    typedef typename Layout1::Expon Expon;
+
+    struct Product
+    {
+        Coef coef;
+        Expon expon;
+    };
+
+    typedef std::vector< Product > Partial;
+
+    // every block has at least one term
+    if (numThreads > multiplicand.size)
+        numThreads = multiplicand.size;
+    if (numThreads <= 1)
+    {
+        kernel(multiplicand, multiplier, emit);
+        return;
+    }
+
+    // thread t multiplies the terms numTerms * t / numThreads .. numTerms * ( t + 1 ) / numThreads - 1
+    std::vector< Partial > partials(numThreads);
+    auto multiplyBlock = [&](int t)
+    {
+        int first = static_cast< int >(static_cast< long long >(multiplicand.size) * t / numThreads);
+        int last = static_cast< int >(static_cast< long long >(multiplicand.size) * (t + 1) / numThreads);
+        RangeLayout< Layout1 > block{ &multiplicand, first, last - first };
+
+        Partial& partial = partials[t];
+        kernel(block, multiplier, [&partial](const Coef& coef, const Expon& expon)
+        {
+            partial.push_back(Product{ coef, expon });
+        });
+    };
+
+    std::vector< std::thread > threads;
+    for (int t = 1; t < numThreads; t++)
+        threads.emplace_back(multiplyBlock, t);
+    multiplyBlock(0);
+    for (size_t t = 0; t < threads.size(); t++)
+        threads[t].join();
+    threads.clear();
+
+    // splitters[ 0 ] > splitters[ 1 ] > ...; range r holds the exponents in
+    // ( splitters[ r ], splitters[ r - 1 ] ], the first range has no upper and the last no lower end
+    std::vector< Expon > samples;
+    for (int p = 0; p < numThreads; p++)
+    {
+        const Partial& partial = partials[p];
+        int numSamples = numSamplesPerRange * numThreads;
+        for (int s = 1; s < numSamples && !partial.empty(); s++)
+            samples.push_back(partial[static_cast< size_t >(static_cast< long long >(partial.size()) * s / numSamples)].expon);
+    }
+    std::sort(samples.begin(), samples.end(), [](const Expon& a, const Expon& b) { return b < a; });
+
+    std::vector< Expon > splitters;
+    for (int r = 1; r < numThreads && !samples.empty(); r++)
+    {
+        const Expon& splitter = samples[static_cast< size_t >(static_cast< long long >(samples.size()) * r / numThreads)];
+        if (splitters.empty() || splitter < splitters.back())
+            splitters.push_back(splitter);
+    }
+    int numRanges = static_cast< int >(splitters.size()) + 1;
+
+    // bounds[ p ][ r ] is the first term of partial p in range r
+    std::vector< std::vector< size_t > > bounds(numThreads, std::vector< size_t >(numRanges + 1));
+    for (int p = 0; p < numThreads; p++)
+    {
+        const Partial& partial = partials[p];
+        bounds[p][0] = 0;
+        for (int r = 1; r < numRanges; r++)
+        {
+            const Expon& splitter = splitters[r - 1];
+            bounds[p][r] = std::partition_point(partial.begin(), partial.end(),
+                [&splitter](const Product& product) { return splitter < product.expon; }) - partial.begin();
+        }
+        bounds[p][numRanges] = partial.size();
+    }
+
+    // range r is merged into merged[ r ]
+    std::vector< Partial > merged(numRanges);
+    auto mergeRange = [&](int r)
+    {
+        struct Cursor
+        {
+            Expon expon;
+            int partial;
+            size_t position;
+        };
+
+        // the cursor with the largest exponent, and among those the earliest block, is on top
+        auto lower = [](const Cursor& a, const Cursor& b)
+        {
+            return a.expon < b.expon || (a.expon == b.expon && a.partial > b.partial);
+        };
+
+        std::vector< Cursor > heap;
+        for (int p = 0; p < numThreads; p++)
+            if (bounds[p][r] < bounds[p][r + 1])
+                heap.push_back(Cursor{ partials[p][bounds[p][r]].expon, p, bounds[p][r] });
+        std::make_heap(heap.begin(), heap.end(), lower);
+
+        Partial& output = merged[r];
+        while (!heap.empty())
+        {
+            Expon expon = heap.front().expon;
+            Coef coef = Coef();
+
+            // add up the terms of this exponent from every partial product
+            while (!heap.empty() && heap.front().expon == expon)
+            {
+                std::pop_heap(heap.begin(), heap.end(), lower);
+                Cursor& cursor = heap.back();
+                coef += partials[cursor.partial][cursor.position].coef;
+
+                if (++cursor.position < bounds[cursor.partial][r + 1])
+                {
+                    cursor.expon = partials[cursor.partial][cursor.position].expon;
+                    std::push_heap(heap.begin(), heap.end(), lower);
+                }
+                else
+                    heap.pop_back();
+            }
+
+            if (coef != Coef())
+                output.push_back(Product{ coef, expon });
+        }
+    };
+
+    for (int r = 1; r < numRanges; r++)
+        threads.emplace_back(mergeRange, r);
+    mergeRange(0);
+    for (size_t t = 0; t < threads.size(); t++)
+        threads[t].join();
+
+    for (int r = 0; r < numRanges; r++)
+        for (size_t i = 0; i < merged[r].size(); i++)
+            emit(merged[r][i].coef, merged[r][i].expon);
+}
+
+#endif
@@ -0,0 +1,646 @@
+// Runs every sparse polynomial implementation on the same workload:
+//   hw7    coef / expon parallel arrays      ( 1103321-hw7/Source.h )
+//   hw8-1  Term* in a per-case arena         ( 1103321-hw8-1.h )
+//   hw8-2  Polynomial struct                 ( 1103321-hw8-2.h )
+//   hw8-3  Polynomial class                  ( 1103321-hw8-3.h )
+//   hw8-4  vector< Term >                    ( 1103321-hw8-4.h )
+//   hw8-4e vector< Term >, verified by one fused expression ( PolynomialExpression.h )
+// and reports time, the number of allocations and peak resident set size for
+// addition ( dividend + divisor ), multiplication ( divisor * quotient ), division and the
+// verify loop of the drivers ( division, multiplication, addition and equal ).
+// Every implementation runs in its own process, so its peak RSS is not affected by the others.
+//
+// usage: PolynomialBenchmark file [repetitions]
+//   file         a workload in the legacy or the scalable layout ( see PolynomialGenerator.cpp )
+//   repetitions  the number of times every operation is performed (1)
+//
+// build: link AllocationCounter.cpp, which counts the allocations
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#endif
+
+#include "PolynomialFile.h"
+#include "SparseMultiplication.h"
+#include "HeapDivision.h"
+#include "Arena.h"
+#include "PolynomialExpression.h"
+#include "MergeAddition.h"
+#include "AllocationCounter.h"
+
+// the polynomials of every driver, each in a namespace of its own
+#include "../1103321-hw7/Source.h"
+#include "../1103321-hw8/1103321-hw8/1103321-hw8-1.h"
+#include "../1103321-hw8/1103321-hw8/1103321-hw8-2.h"
+#include "../1103321-hw8/1103321-hw8/1103321-hw8-3.h"
+#include "../1103321-hw8/1103321-hw8/1103321-hw8-4.h"
+
+using std::cout;
+using std::cerr;
+using std::endl;
+using std::setw;
+using std::fixed;
+using std::setprecision;
+using std::vector;
+using std::string;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+struct Term
+{
+    int coef = 0;  // the coefficient of a term
+    int expon = 0; // the exponent of a term
+};
+
+const int numOperations = 4;
+const char* const operationNames[numOperations] = { "addition", "multiplication", "division", "verify" };
+
+struct Result
+{
+    double seconds[numOperations] = {};
+    long long allocations[numOperations] = {};
+    long long bytes[numOperations] = {};
+    long long peakKilobytes = 0;
+    int numErrors = 0;
+};
+
+struct Workload
+{
+    vector< vector< Term > > dividends;
+    vector< vector< Term > > divisors;
+    vector< vector< Term > > quotients; // dividend / divisor, for the multiplication benchmark
+};
+
+// hw7: coef / expon parallel arrays with a capacity
+struct ArrayAdapter
+{
+    struct Polynomial
+    {
+        int* coef = nullptr;
+        int* expon = nullptr;
+        int size = 0;
+        int capacity = 0;
+    };
+
+    static void load(const vector< Term >& terms, Polynomial& polynomial)
+    {
+        polynomial.size = static_cast< int >(terms.size());
+        hw7::reserve(polynomial.coef, polynomial.expon, polynomial.capacity, polynomial.size, 0);
+        for (int i = 0; i < polynomial.size; i++)
+        {
+            polynomial.coef[i] = terms[i].coef;
+            polynomial.expon[i] = terms[i].expon;
+        }
+    }
+
+    static void copy(const Polynomial& source, Polynomial& polynomial)
+    {
+        polynomial.size = source.size;
+        hw7::reserve(polynomial.coef, polynomial.expon, polynomial.capacity, polynomial.size, 0);
+        for (int i = 0; i < polynomial.size; i++)
+        {
+            polynomial.coef[i] = source.coef[i];
+            polynomial.expon[i] = source.expon[i];
+        }
+    }
+
+    static void add(Polynomial& addend, const Polynomial& adder)
+    {
+        hw7::addition(addend.coef, addend.expon, addend.size, addend.capacity,
+            adder.coef, adder.expon, adder.size);
+    }
+
+    static void multiply(const Polynomial& multiplicand, const Polynomial& multiplier, Polynomial& product)
+    {
+        hw7::multiplication(multiplicand.coef, multiplicand.expon, multiplicand.size,
+            multiplier.coef, multiplier.expon, multiplier.size,
+            product.coef, product.expon, product.size, product.capacity);
+    }
+
+    static void divide(const Polynomial& dividend, const Polynomial& divisor,
+        Polynomial& quotient, Polynomial& remainder)
+    {
+        hw7::division(dividend.coef, dividend.expon, dividend.size,
+            divisor.coef, divisor.expon, divisor.size,
+            quotient.coef, quotient.expon, quotient.size, quotient.capacity,
+            remainder.coef, remainder.expon, remainder.size, remainder.capacity);
+    }
+
+    static bool equal(const Polynomial& polynomial1, const Polynomial& polynomial2)
+    {
+        return hw7::equal(polynomial1.coef, polynomial1.expon, polynomial1.size,
+            polynomial2.coef, polynomial2.expon, polynomial2.size);
+    }
+
+    static void endCase(Polynomial&, Polynomial&, Polynomial&)
+    {
+    }
+
+    static void release(Polynomial& polynomial)
+    {
+        hw7::release(polynomial.coef, polynomial.expon, polynomial.size, polynomial.capacity);
+    }
+};
+
+// hw8-1: Term* and a size, with the arrays of a test case in an arena
+struct PointerAdapter
+{
+    struct Polynomial
+    {
+        hw81::Term* terms = nullptr;
+        int size = 0;
+    };
+
+    static Arena workloadArena; // the polynomials of the workload
+    static Arena caseArena;     // everything computed for one pair
+
+    static void load(const vector< Term >& terms, Polynomial& polynomial)
+    {
+        polynomial.size = static_cast< int >(terms.size());
+        polynomial.terms = arenaArray< hw81::Term >(workloadArena, polynomial.size);
+        for (int i = 0; i < polynomial.size; i++)
+        {
+            polynomial.terms[i].coef = terms[i].coef;
+            polynomial.terms[i].expon = terms[i].expon;
+        }
+    }
+
+    static void copy(const Polynomial& source, Polynomial& polynomial)
+    {
+        polynomial.size = source.size;
+        polynomial.terms = arenaArray< hw81::Term >(caseArena, polynomial.size);
+        for (int i = 0; i < polynomial.size; i++)
+            polynomial.terms[i] = source.terms[i];
+    }
+
+    static void add(Polynomial& addend, const Polynomial& adder)
+    {
+        hw81::addition(addend.terms, addend.size, adder.terms, adder.size, caseArena);
+    }
+
+    static void multiply(const Polynomial& multiplicand, const Polynomial& multiplier, Polynomial& product)
+    {
+        hw81::multiplication(multiplicand.terms, multiplicand.size,
+            multiplier.terms, multiplier.size, product.terms, product.size, caseArena);
+    }
+
+    static void divide(const Polynomial& dividend, const Polynomial& divisor,
+        Polynomial& quotient, Polynomial& remainder)
+    {
+        hw81::division(dividend.terms, dividend.size, divisor.terms, divisor.size,
+            quotient.terms, quotient.size, remainder.terms, remainder.size, caseArena);
+    }
+
+    static bool equal(const Polynomial& polynomial1, const Polynomial& polynomial2)
+    {
+        return hw81::equal(polynomial1.terms, polynomial1.size, polynomial2.terms, polynomial2.size);
+    }
+
+    static void endCase(Polynomial& buffer, Polynomial& quotient, Polynomial& remainder)
+    {
+        hw81::reset(buffer.terms, buffer.size);
+        hw81::reset(quotient.terms, quotient.size);
+        hw81::reset(remainder.terms, remainder.size);
+        caseArena.reset();
+    }
+
+    static void release(Polynomial& polynomial)
+    {
+        hw81::reset(polynomial.terms, polynomial.size);
+    }
+};
+
+Arena PointerAdapter::workloadArena;
+Arena PointerAdapter::caseArena;
+
+// hw8-2: Polynomial struct and free functions
+struct StructAdapter
+{
+    typedef hw82::Polynomial Polynomial;
+
+    static void load(const vector< Term >& terms, Polynomial& polynomial)
+    {
+        hw82::reset(polynomial);
+        polynomial.size = static_cast< int >(terms.size());
+        polynomial.terms = new hw82::Term[polynomial.size];
+        for (int i = 0; i < polynomial.size; i++)
+        {
+            polynomial.terms[i].coef = terms[i].coef;
+            polynomial.terms[i].expon = terms[i].expon;
+        }
+    }
+
+    static void copy(const Polynomial& source, Polynomial& polynomial)
+    {
+        hw82::reset(polynomial);
+        polynomial.size = source.size;
+        polynomial.terms = new hw82::Term[polynomial.size];
+        for (int i = 0; i < polynomial.size; i++)
+            polynomial.terms[i] = source.terms[i];
+    }
+
+    static void add(Polynomial& addend, const Polynomial& adder)
+    {
+        hw82::addition(addend, adder);
+    }
+
+    static void multiply(const Polynomial& multiplicand, const Polynomial& multiplier, Polynomial& product)
+    {
+        hw82::multiplication(multiplicand, multiplier, product);
+    }
+
+    static void divide(const Polynomial& dividend, const Polynomial& divisor,
+        Polynomial& quotient, Polynomial& remainder)
+    {
+        hw82::division(dividend, divisor, quotient, remainder);
+    }
+
+    static bool equal(const Polynomial& polynomial1, const Polynomial& polynomial2)
+    {
+        return hw82::equal(polynomial1, polynomial2);
+    }
+
+    static void endCase(Polynomial&, Polynomial&, Polynomial&)
+    {
+    }
+
+    static void release(Polynomial& polynomial)
+    {
+        hw82::reset(polynomial);
+    }
+};
+
+// hw8-3: Polynomial class
+struct ClassAdapter
+{
+    typedef hw83::Polynomial Polynomial;
+
+    static void load(const vector< Term >& terms, Polynomial& polynomial)
+    {
+        polynomial.reset();
+        for (size_t i = 0; i < terms.size(); i++)
+            polynomial.append(terms[i].coef, terms[i].expon);
+    }
+
+    static void copy(const Polynomial& source, Polynomial& polynomial)
+    {
+        polynomial = source;
+    }
+
+    static void add(Polynomial& addend, const Polynomial& adder)
+    {
+        addend.addition(adder);
+    }
+
+    static void multiply(const Polynomial& multiplicand, const Polynomial& multiplier, Polynomial& product)
+    {
+        multiplicand.multiplication(multiplier, product);
+    }
+
+    static void divide(const Polynomial& dividend, const Polynomial& divisor,
+        Polynomial& quotient, Polynomial& remainder)
+    {
+        dividend.division(divisor, quotient, remainder);
+    }
+
+    static bool equal(const Polynomial& polynomial1, const Polynomial& polynomial2)
+    {
+        return polynomial1.equal(polynomial2);
+    }
+
+    static void endCase(Polynomial&, Polynomial&, Polynomial&)
+    {
+    }
+
+    static void release(Polynomial& polynomial)
+    {
+        polynomial = Polynomial();
+    }
+};
+
+// hw8-4: vector< Term >
+struct VectorAdapter
+{
+    typedef vector< hw84::Term > Polynomial;
+
+    static void load(const vector< Term >& terms, Polynomial& polynomial)
+    {
+        polynomial.resize(terms.size());
+        for (size_t i = 0; i < terms.size(); i++)
+        {
+            polynomial[i].coef = terms[i].coef;
+            polynomial[i].expon = terms[i].expon;
+        }
+    }
+
+    static void copy(const Polynomial& source, Polynomial& polynomial)
+    {
+        polynomial = source;
+    }
+
+    static void add(Polynomial& addend, const Polynomial& adder)
+    {
+        hw84::addition(addend, adder);
+    }
+
+    static void multiply(const Polynomial& multiplicand, const Polynomial& multiplier, Polynomial& product)
+    {
+        hw84::multiplication(multiplicand, multiplier, product);
+    }
+
+    static void divide(const Polynomial& dividend, const Polynomial& divisor,
+        Polynomial& quotient, Polynomial& remainder)
+    {
+        hw84::division(dividend, divisor, quotient, remainder);
+    }
+
+    static bool equal(const Polynomial& polynomial1, const Polynomial& polynomial2)
+    {
+        return hw84::equal(polynomial1, polynomial2);
+    }
+
+    static void endCase(Polynomial&, Polynomial&, Polynomial&)
+    {
+    }
+
+    static void release(Polynomial& polynomial)
+    {
+        Polynomial().swap(polynomial);
+    }
+};
+
+// the time and the allocations of the operations between start() and stop()
+class Meter
+{
+public:
+    void start()
+    {
+        allocations = numAllocations;
+        bytes = numBytesAllocated;
+        time = steady_clock::now();
+    }
+
+    void stop(Result& result, int operation)
+    {
+        result.seconds[operation] += duration< double >(steady_clock::now() - time).count();
+        result.allocations[operation] += numAllocations - allocations;
+        result.bytes[operation] += numBytesAllocated - bytes;
+    }
+
+private:
+    long long allocations = 0;
+    long long bytes = 0;
+    steady_clock::time_point time;
+};
+
+// hw8-4 with the verify loop written as divisor * quotient + remainder == dividend
+struct FusedVectorAdapter : VectorAdapter
+{
+};
+
+// buffer = divisor * quotient + remainder; returns true if and only if buffer == dividend
+template< typename Adapter >
+bool verify(const typename Adapter::Polynomial& dividend, const typename Adapter::Polynomial& divisor,
+    const typename Adapter::Polynomial& quotient, const typename Adapter::Polynomial& remainder,
+    typename Adapter::Polynomial& buffer)
+{
+    Adapter::multiply(divisor, quotient, buffer);
+    Adapter::add(buffer, remainder);
+    return Adapter::equal(buffer, dividend);
+}
+
+// the terms of divisor * quotient + remainder are compared with dividend as they are produced
+template<>
+bool verify< FusedVectorAdapter >(const VectorAdapter::Polynomial& dividend, const VectorAdapter::Polynomial& divisor,
+    const VectorAdapter::Polynomial& quotient, const VectorAdapter::Polynomial& remainder,
+    VectorAdapter::Polynomial&)
+{
+    return divisor * quotient + remainder == dividend;
+}
+
+// performs every operation of the benchmark with one implementation
+template< typename Adapter >
+void run(const Workload& workload, int repetitions, Result& result)
+{
+    typedef typename Adapter::Polynomial Polynomial;
+
+    size_t numPairs = workload.dividends.size();
+    vector< Polynomial > dividends(numPairs);
+    vector< Polynomial > divisors(numPairs);
+    vector< Polynomial > quotients(numPairs);
+    for (size_t i = 0; i < numPairs; i++)
+    {
+        Adapter::load(workload.dividends[i], dividends[i]);
+        Adapter::load(workload.divisors[i], divisors[i]);
+        Adapter::load(workload.quotients[i], quotients[i]);
+    }
+
+    Polynomial buffer;
+    Polynomial quotient;
+    Polynomial remainder;
+    Meter meter;
+
+    for (int r = 0; r < repetitions; r++)
+        for (size_t i = 0; i < numPairs; i++)
+        {
+            // addition: buffer = dividend + divisor
+            Adapter::copy(dividends[i], buffer);
+            meter.start();
+            Adapter::add(buffer, divisors[i]);
+            meter.stop(result, 0);
+
+            // multiplication: buffer = divisor * quotient
+            meter.start();
+            Adapter::multiply(divisors[i], quotients[i], buffer);
+            meter.stop(result, 1);
+
+            // division
+            meter.start();
+            Adapter::divide(dividends[i], divisors[i], quotient, remainder);
+            meter.stop(result, 2);
+
+            // the verify loop of the drivers
+            meter.start();
+            Adapter::divide(dividends[i], divisors[i], quotient, remainder);
+            bool correct = verify< Adapter >(dividends[i], divisors[i], quotient, remainder, buffer);
+            meter.stop(result, 3);
+
+            if (!correct && r == 0)
+                result.numErrors++;
+
+            Adapter::endCase(buffer, quotient, remainder);
+        }
+
+    Adapter::release(buffer);
+    Adapter::release(quotient);
+    Adapter::release(remainder);
+    for (size_t i = 0; i < numPairs; i++)
+    {
+        Adapter::release(dividends[i]);
+        Adapter::release(divisors[i]);
+        Adapter::release(quotients[i]);
+    }
+}
+
+// inputs the workload and computes the quotients used by the multiplication benchmark
+bool loadWorkload(const char* fileName, Workload& workload);
+
+// runs the implementation with the given index ( 0 = hw7, ..., 5 = hw8-4e )
+void runImplementation(int implementation, const char* fileName, int repetitions, Result& result);
+
+const int numImplementations = 6;
+const char* const implementationNames[numImplementations] = { "hw7", "hw8-1", "hw8-2", "hw8-3", "hw8-4", "hw8-4e" };
+const char* const layoutNames[numImplementations] = { "SoA arrays", "Term*", "struct", "class", "vector", "vector" };
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "usage: PolynomialBenchmark file [repetitions]" << endl;
+        return 1;
+    }
+
+    int repetitions = argc > 2 ? atoi(argv[2]) : 1;
+
+    Workload workload;
+    if (!loadWorkload(argv[1], workload))
+    {
+        cerr << "File could not be opened" << endl;
+        return 1;
+    }
+
+    long long numTerms = 0;
+    for (size_t i = 0; i < workload.dividends.size(); i++)
+        numTerms += workload.dividends[i].size();
+    cout << workload.dividends.size() << " pairs, " << numTerms << " dividend terms, "
+        << repetitions << " repetitions\n\n";
+
+    Result results[numImplementations];
+    for (int k = 0; k < numImplementations; k++)
+    {
+#ifndef _WIN32
+        // run the implementation in a child process and collect its results through a pipe
+        int channel[2];
+        if (pipe(channel) != 0)
+            return 1;
+
+        cout.flush();
+        pid_t child = fork();
+        if (child == 0)
+        {
+            close(channel[0]);
+            Result result;
+            runImplementation(k, argv[1], repetitions, result);
+            ssize_t written = write(channel[1], &result, sizeof(result));
+            _exit(written == sizeof(result) ? 0 : 1);
+        }
+
+        close(channel[1]);
+        ssize_t received = read(channel[0], &results[k], sizeof(Result));
+        close(channel[0]);
+
+        int status = 0;
+        struct rusage usage;
+        wait4(child, &status, 0, &usage);
+        if (received != sizeof(Result) || status != 0)
+        {
+            cerr << implementationNames[k] << " failed" << endl;
+            return 1;
+        }
+        results[k].peakKilobytes = usage.ru_maxrss;
+#else
+        runImplementation(k, argv[1], repetitions, results[k]);
+#endif
+    }
+
+    cout << fixed;
+    for (int operation = 0; operation < numOperations; operation++)
+    {
+        cout << operationNames[operation] << endl;
+        cout << setw(8) << "impl" << setw(12) << "layout" << setw(12) << "seconds"
+            << setw(14) << "allocations" << setw(14) << "MB allocated" << endl;
+        for (int k = 0; k < numImplementations; k++)
+            cout << setw(8) << implementationNames[k] << setw(12) << layoutNames[k]
+                << setw(12) << setprecision(4) << results[k].seconds[operation]
+                << setw(14) << results[k].allocations[operation]
+                << setw(14) << setprecision(1) << results[k].bytes[operation] / 1048576.0 << endl;
+        cout << endl;
+    }
+
+    int numErrors = 0;
+    cout << setw(8) << "impl" << setw(16) << "peak RSS (MB)" << setw(10) << "errors" << endl;
+    for (int k = 0; k < numImplementations; k++)
+    {
+        cout << setw(8) << implementationNames[k] << setw(16) << setprecision(1)
+            << results[k].peakKilobytes / 1024.0 << setw(10) << results[k].numErrors << endl;
+        numErrors += results[k].numErrors;
+    }
+
+    return numErrors == 0 ? 0 : 1;
+}
+
+// inputs the workload and computes the quotients used by the multiplication benchmark
+bool loadWorkload(const char* fileName, Workload& workload)
+{
+    if (!readWorkload(fileName, workload.dividends, workload.divisors))
+        return false;
+
+    workload.quotients.resize(workload.dividends.size());
+    for (size_t i = 0; i < workload.dividends.size(); i++)
+    {
+        vector< Term >& quotient = workload.quotients[i];
+        heapDivision(termLayout(workload.dividends[i]), termLayout(workload.divisors[i]),
+            [&](int coef, int expon)
+            {
+                Term term;
+                term.coef = coef;
+                term.expon = expon;
+                quotient.push_back(term);
+            },
+            [](int, int) {});
+    }
+
+    return true;
+}
+
+// runs the implementation with the given index ( 0 = hw7, ..., 5 = hw8-4e )
+void runImplementation(int implementation, const char* fileName, int repetitions, Result& result)
+{
+    Workload workload;
+    loadWorkload(fileName, workload);
+
+    switch (implementation)
+    {
+    case 0:
+        run< ArrayAdapter >(workload, repetitions, result);
+        break;
+    case 1:
+        run< PointerAdapter >(workload, repetitions, result);
+        break;
+    case 2:
+        run< StructAdapter >(workload, repetitions, result);
+        break;
+    case 3:
+        run< ClassAdapter >(workload, repetitions, result);
+        break;
+    case 4:
+        run< VectorAdapter >(workload, repetitions, result);
+        break;
+    case 5:
+        run< FusedVectorAdapter >(workload, repetitions, result);
+        break;
+    }
+}
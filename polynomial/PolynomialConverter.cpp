@@ -0,0 +1,160 @@
+// Converts a workload between the layouts of PolynomialFile.h, one polynomial at a time
+//
+// The input layout is recognized from the file; the output is written as it is read, so files
+// of any size need memory for one polynomial only.
+//
+// usage: PolynomialConverter [options] input output
+//   --to layout          compact, scalable or legacy (compact)
+//   --index-interval n   the number of polynomials per index entry of the compact layout (64)
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <fstream>
+using std::ifstream;
+using std::ofstream;
+using std::ios;
+
+#include <vector>
+using std::vector;
+
+#include <memory>
+using std::unique_ptr;
+
+#include <chrono>
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+#include <cstdlib>
+#include <cstring>
+
+#include "PolynomialFile.h"
+
+struct Term
+{
+    int coef = 0;  // the coefficient of a term
+    int expon = 0; // the exponent of a term
+};
+
+enum Layout { LEGACY, SCALABLE, COMPACT };
+
+int main(int argc, char* argv[])
+{
+    Layout outputLayout = COMPACT;
+    int indexInterval = compactIndexInterval;
+
+    int argument = 1;
+    for (; argument + 1 < argc && strncmp(argv[argument], "--", 2) == 0; argument += 2)
+    {
+        const char* name = argv[argument];
+        const char* value = argv[argument + 1];
+
+        if (strcmp(name, "--to") == 0 && strcmp(value, "compact") == 0)
+            outputLayout = COMPACT;
+        else if (strcmp(name, "--to") == 0 && strcmp(value, "scalable") == 0)
+            outputLayout = SCALABLE;
+        else if (strcmp(name, "--to") == 0 && strcmp(value, "legacy") == 0)
+            outputLayout = LEGACY;
+        else if (strcmp(name, "--index-interval") == 0 && atoi(value) >= 1)
+            indexInterval = atoi(value);
+        else
+            argument = argc; // an unknown option
+    }
+
+    if (argument + 2 != argc)
+    {
+        cerr << "usage: PolynomialConverter [--to compact|scalable|legacy] [--index-interval n] input output" << endl;
+        return 1;
+    }
+
+    ifstream inFile(argv[argument], ios::in | ios::binary);
+    ofstream outFile(argv[argument + 1], ios::out | ios::binary);
+    if (!inFile || !outFile)
+    {
+        cerr << "File could not be opened" << endl;
+        return 1;
+    }
+
+    steady_clock::time_point start = steady_clock::now();
+
+    // recognize the input layout; the polynomials follow the header
+    CompactReader compactReader(inFile);
+    int numPairs = 0;
+    Layout inputLayout = COMPACT;
+    if (!compactReader.isOpen())
+    {
+        inFile.clear();
+        inFile.seekg(0);
+        inputLayout = readScalableHeader(inFile, numPairs) ? SCALABLE : LEGACY;
+        if (inputLayout == LEGACY)
+        {
+            inFile.clear();
+            inFile.seekg(0);
+        }
+    }
+
+    // the number of pairs in the header of the output is stored once it is known
+    unique_ptr< CompactWriter > compactWriter;
+    if (outputLayout == COMPACT)
+        compactWriter.reset(new CompactWriter(outFile, indexInterval));
+    else if (outputLayout == SCALABLE)
+        writeScalableHeader(outFile, 0);
+
+    vector< Term > polynomial;
+    long long numPolynomials = 0;
+    for (;;)
+    {
+        bool read = false;
+        if (inputLayout == LEGACY)
+            read = readLegacy(inFile, polynomial);
+        else if (inputLayout == SCALABLE)
+            read = numPolynomials < 2LL * numPairs && readScalable(inFile, polynomial);
+        else
+            read = compactReader.read(polynomial);
+        if (!read)
+            break;
+
+        if (outputLayout == COMPACT)
+            compactWriter->write(polynomial);
+        else if (outputLayout == SCALABLE)
+            writeScalable(outFile, polynomial);
+        else if (polynomial.size() <= static_cast< size_t >(legacyArraySize))
+            writeLegacy(outFile, polynomial);
+        else
+        {
+            cerr << "Polynomial " << numPolynomials << " has more than " << legacyArraySize
+                << " terms and does not fit in the legacy layout" << endl;
+            return 1;
+        }
+
+        numPolynomials++;
+    }
+
+    if (outputLayout == COMPACT)
+        compactWriter->finish();
+    else if (outputLayout == SCALABLE)
+    {
+        outFile.seekp(0);
+        writeScalableHeader(outFile, static_cast< int >(numPolynomials / 2));
+        outFile.seekp(0, ios::end);
+    }
+
+    inFile.clear();
+    inFile.seekg(0, ios::end);
+    long long inputBytes = static_cast< long long >(inFile.tellg());
+    long long outputBytes = static_cast< long long >(outFile.tellp());
+    double seconds = duration< double >(steady_clock::now() - start).count();
+
+    if (!outFile)
+    {
+        cerr << "Output could not be written" << endl;
+        return 1;
+    }
+
+    cout << numPolynomials / 2 << " pairs, " << inputBytes << " bytes in, " << outputBytes << " bytes out ( "
+        << (inputBytes > 0 ? 100.0 * outputBytes / inputBytes : 0.0) << "% ), " << seconds << " seconds\n";
+
+    return 0;
+}
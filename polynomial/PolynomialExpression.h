@@ -0,0 +1,218 @@
+// PolynomialExpression.h
+// Expression templates for polynomials stored as vector< Term >.
+//
+// a * b + c == d does not build a * b or a * b + c. Each operator returns a small object that
+// produces the terms of its value one at a time, in descending order of exponents and without
+// zero terms: a product streams its terms out of a HeapProductStream, and a sum merges the
+// streams of its operands. The comparison pulls terms until the first difference, so a wrong
+// result is usually rejected after a few terms. An expression refers to its vectors, so it must
+// be used within the full expression that creates it.
+
+#ifndef POLYNOMIAL_EXPRESSION_H
+#define POLYNOMIAL_EXPRESSION_H
+
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "HeapMultiplication.h"
+
+// the base of every expression; Derived has a member bool next( Coef& coef, Expon& expon )
+template< typename Derived >
+struct PolynomialExpression
+{
+};
+
+// true if T is a vector of terms ( elements with members coef and expon )
+template< typename T, typename = void >
+struct IsTermVector : std::false_type
+{
+};
+
+template< typename TermType, typename Allocator >
+struct IsTermVector< std::vector< TermType, Allocator >,
+    decltype(void(std::declval< TermType >().coef), void(std::declval< TermType >().expon)) > : std::true_type
+{
+};
+
+// true if T is an expression
+template< typename T >
+struct IsPolynomialExpression : std::is_base_of< PolynomialExpression< T >, T >
+{
+};
+
+// the terms of a stored polynomial
+template< typename TermType >
+class TermExpression : public PolynomialExpression< TermExpression< TermType > >
+{
+public:
+    typedef typename TermLayout< TermType >::Coef Coef;
+    typedef typename TermLayout< TermType >::Expon Expon;
+
+    explicit TermExpression(const TermLayout< TermType >& polynomial)
+        : terms(polynomial)
+    {
+    }
+
+    bool next(Coef& coef, Expon& expon)
+    {
+        if (position == terms.size)
+            return false;
+
+        coef = terms.coef(position);
+        expon = terms.expon(position);
+        position++;
+        return true;
+    }
+
+private:
+    TermLayout< TermType > terms;
+    int position = 0;
+};
+
+// the terms of multiplicand * multiplier, merged by a heap as they are needed
+template< typename TermType >
+class ProductExpression : public PolynomialExpression< ProductExpression< TermType > >
+{
+public:
+    typedef typename TermLayout< TermType >::Coef Coef;
+    typedef typename TermLayout< TermType >::Expon Expon;
+
+    ProductExpression(const TermLayout< TermType >& multiplicand, const TermLayout< TermType >& multiplier)
+        : stream(multiplicand, multiplier)
+    {
+    }
+
+    bool next(Coef& coef, Expon& expon)
+    {
+        return stream.next(coef, expon);
+    }
+
+private:
+    HeapProductStream< TermLayout< TermType >, TermLayout< TermType > > stream;
+};
+
+// the terms of augend + addend, merged from the terms of the operands
+template< typename Expression1, typename Expression2 >
+class SumExpression : public PolynomialExpression< SumExpression< Expression1, Expression2 > >
+{
+public:
+    typedef typename Expression1::Coef Coef;
+    typedef typename Expression1::Expon Expon;
+
+    SumExpression(Expression1 augend, Expression2 addend)
+        : left(std::move(augend)), right(std::move(addend))
+    {
+        hasLeft = left.next(leftCoef, leftExpon);
+        hasRight = right.next(rightCoef, rightExpon);
+    }
+
+    bool next(Coef& coef, Expon& expon)
+    {
+        while (hasLeft || hasRight)
+        {
+            if (!hasRight || (hasLeft && leftExpon > rightExpon))
+            {
+                coef = leftCoef;
+                expon = leftExpon;
+                hasLeft = left.next(leftCoef, leftExpon);
+                return true;
+            }
+
+            if (!hasLeft || rightExpon > leftExpon)
+            {
+                coef = rightCoef;
+                expon = rightExpon;
+                hasRight = right.next(rightCoef, rightExpon);
+                return true;
+            }
+
+            // equal exponents; terms that cancel are skipped
+            coef = leftCoef + rightCoef;
+            expon = leftExpon;
+            hasLeft = left.next(leftCoef, leftExpon);
+            hasRight = right.next(rightCoef, rightExpon);
+            if (coef != Coef())
+                return true;
+        }
+
+        return false;
+    }
+
+private:
+    Expression1 left;
+    Expression2 right;
+
+    // the next term of each operand
+    bool hasLeft;
+    bool hasRight;
+    Coef leftCoef;
+    Coef rightCoef;
+    Expon leftExpon;
+    Expon rightExpon;
+};
+
+// wraps a vector of terms or passes an expression through
+template< typename TermType, typename Allocator >
+TermExpression< TermType > expression(const std::vector< TermType, Allocator >& polynomial)
+{
+    return TermExpression< TermType >(termLayout(polynomial));
+}
+
+template< typename Expression,
+    typename = typename std::enable_if< IsPolynomialExpression< Expression >::value >::type >
+Expression expression(Expression polynomial)
+{
+    return polynomial;
+}
+
+// true if T is a vector of terms or an expression
+template< typename T >
+struct IsPolynomialOperand : std::integral_constant< bool,
+    IsTermVector< T >::value || IsPolynomialExpression< T >::value >
+{
+};
+
+// multiplicand * multiplier for two stored polynomials
+template< typename TermType, typename Allocator1, typename Allocator2,
+    typename = typename std::enable_if< IsTermVector< std::vector< TermType, Allocator1 > >::value >::type >
+ProductExpression< TermType > operator*(const std::vector< TermType, Allocator1 >& multiplicand,
+    const std::vector< TermType, Allocator2 >& multiplier)
+{
+    return ProductExpression< TermType >(termLayout(multiplicand), termLayout(multiplier));
+}
+
+// augend + addend where either operand is an expression
+template< typename T1, typename T2, typename = typename std::enable_if<
+    IsPolynomialOperand< T1 >::value && IsPolynomialOperand< T2 >::value &&
+    (IsPolynomialExpression< T1 >::value || IsPolynomialExpression< T2 >::value) >::type >
+auto operator+(const T1& augend, const T2& addend)
+    -> SumExpression< decltype(expression(augend)), decltype(expression(addend)) >
+{
+    return SumExpression< decltype(expression(augend)), decltype(expression(addend)) >(
+        expression(augend), expression(addend));
+}
+
+// returns true if and only if the value of an expression equals a stored polynomial,
+// stopping at the first term that differs
+template< typename Expression, typename TermType, typename Allocator,
+    typename = typename std::enable_if< IsPolynomialExpression< Expression >::value >::type >
+bool operator==(Expression value, const std::vector< TermType, Allocator >& polynomial)
+{
+    typename Expression::Coef coef;
+    typename Expression::Expon expon;
+    for (size_t i = 0; i < polynomial.size(); i++)
+        if (!value.next(coef, expon) || coef != polynomial[i].coef || expon != polynomial[i].expon)
+            return false;
+
+    return !value.next(coef, expon);
+}
+
+template< typename Expression, typename TermType, typename Allocator,
+    typename = typename std::enable_if< IsPolynomialExpression< Expression >::value >::type >
+bool operator!=(Expression value, const std::vector< TermType, Allocator >& polynomial)
+{
+    return !(std::move(value) == polynomial);
+}
+
+#endif
@@ -0,0 +1,516 @@
+// PolynomialFile.h
+// Reading and writing polynomial workloads.
+//
+// Legacy layout (Polynomials.dat): every polynomial occupies 160 bytes,
+// an 80-byte block of 20 coefficients followed by an 80-byte block of
+// 20 exponents, padded with zeroes; dividend and divisor alternate.
+//
+// Scalable layout: a 12-byte header ( 'P' 'O' 'L' 'Y', int version, int numPairs )
+// followed by 2 * numPairs polynomials, dividend first. Every polynomial is stored as
+// int numTerms, then numTerms coefficients, then numTerms exponents,
+// with exponents in descending order.
+//
+// Multivariate layout: a 16-byte header ( 'P' 'O' 'L' 'Y', int version 2, int numPairs,
+// int numVariables ) followed by 2 * numPairs polynomials, dividend first. Every polynomial
+// is stored as int numTerms, then numTerms coefficients, then numVariables exponents per term,
+// with terms in descending graded lexicographic order ( see Monomial.h ).
+//
+// Compact layout: a 16-byte header ( 'P' 'O' 'L' 'Y', int version 3, int numPairs,
+// int indexInterval ) followed by 2 * numPairs polynomials, dividend first, then an index and
+// an 8-byte trailer. Every polynomial is stored as the varint numTerms, the varint number of
+// payload bytes, and the payload: numTerms exponents, the first as a zigzag varint and every
+// other as the zigzag varint of its distance from the one before, then numTerms coefficients
+// as zigzag varints ( see VarintCodec.h ). The index holds, as 8-byte integers, the offset from
+// the header of polynomials 0, indexInterval, 2 * indexInterval, ...; the trailer holds the
+// offset of the index. A reader seeks to any polynomial through the index and skips the
+// polynomials before it in its block by their payload sizes, without decoding them.
+
+#ifndef POLYNOMIAL_FILE_H
+#define POLYNOMIAL_FILE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "VarintCodec.h"
+
+const int legacyArraySize = 20;   // the number of terms in a legacy block
+const int legacyBlockBytes = 80;  // the number of bytes of a legacy block
+const int scalableVersion = 1;
+const int multivariateVersion = 2;
+const int compactVersion = 3;
+const int compactIndexInterval = 64; // the number of polynomials per index entry
+
+// the most bytes a read allocates ahead of the data it has received
+const size_t readChunkBytes = 1 << 20;
+
+// inputs count values of type T into values, which grow only as fast as the stream delivers them,
+// so that a malformed count cannot make a read allocate more than the file holds;
+// returns false if the stream ends first
+template< typename T >
+bool readChunked(std::istream& inFile, std::vector< T >& values, size_t count)
+{
+    values.clear();
+    while (values.size() < count)
+    {
+        size_t begin = values.size();
+        size_t numValues = std::min(readChunkBytes / sizeof(T), count - begin);
+        values.resize(begin + numValues);
+        inFile.read(reinterpret_cast<char*>(values.data() + begin), sizeof(T) * numValues);
+        if (!inFile)
+            return false;
+    }
+
+    return true;
+}
+
+// inputs a polynomial stored in the legacy layout
+template< typename TermType >
+bool readLegacy(std::istream& inFile, std::vector< TermType >& polynomial)
+{
+    int coefficient[legacyArraySize] = {};
+    int exponent[legacyArraySize] = {};
+
+    inFile.read(reinterpret_cast<char*>(coefficient), legacyBlockBytes);
+    inFile.read(reinterpret_cast<char*>(exponent), legacyBlockBytes);
+    if (!inFile)
+        return false;
+
+    int size = legacyArraySize;
+    while (size > 0 && coefficient[size - 1] == 0)
+        size--;
+
+    polynomial.resize(size);
+    for (int i = 0; i < size; i++)
+    {
+        polynomial[i].coef = coefficient[i];
+        polynomial[i].expon = exponent[i];
+    }
+
+    return true;
+}
+
+// outputs a polynomial in the legacy layout
+// provided that polynomial.size() <= legacyArraySize
+template< typename TermType >
+void writeLegacy(std::ostream& outFile, const std::vector< TermType >& polynomial)
+{
+    int coefficient[legacyArraySize] = {};
+    int exponent[legacyArraySize] = {};
+
+    for (size_t i = 0; i < polynomial.size() && i < legacyArraySize; i++)
+    {
+        coefficient[i] = polynomial[i].coef;
+        exponent[i] = polynomial[i].expon;
+    }
+
+    outFile.write(reinterpret_cast<const char*>(coefficient), legacyBlockBytes);
+    outFile.write(reinterpret_cast<const char*>(exponent), legacyBlockBytes);
+}
+
+// inputs the header of a file in the scalable layout;
+// returns false if the file is not in the scalable layout
+inline bool readScalableHeader(std::istream& inFile, int& numPairs)
+{
+    char magic[4] = {};
+    int version = 0;
+
+    inFile.read(magic, 4);
+    inFile.read(reinterpret_cast<char*>(&version), sizeof(int));
+    inFile.read(reinterpret_cast<char*>(&numPairs), sizeof(int));
+
+    return inFile && magic[0] == 'P' && magic[1] == 'O' && magic[2] == 'L' && magic[3] == 'Y' &&
+        version == scalableVersion && numPairs >= 0;
+}
+
+// outputs the header of a file in the scalable layout
+inline void writeScalableHeader(std::ostream& outFile, int numPairs)
+{
+    const char magic[4] = { 'P', 'O', 'L', 'Y' };
+    const int version = scalableVersion;
+
+    outFile.write(magic, 4);
+    outFile.write(reinterpret_cast<const char*>(&version), sizeof(int));
+    outFile.write(reinterpret_cast<const char*>(&numPairs), sizeof(int));
+}
+
+// inputs a polynomial stored in the scalable layout
+template< typename TermType >
+bool readScalable(std::istream& inFile, std::vector< TermType >& polynomial)
+{
+    int size = 0;
+    inFile.read(reinterpret_cast<char*>(&size), sizeof(int));
+    if (!inFile || size < 0)
+        return false;
+
+    // the terms are stored only once the file has shown that it holds their coefficients
+    std::vector< int > numericString;
+    if (!readChunked(inFile, numericString, size))
+        return false;
+
+    polynomial.resize(size);
+    for (int i = 0; i < size; i++)
+        polynomial[i].coef = numericString[i];
+
+    if (!readChunked(inFile, numericString, size))
+        return false;
+
+    for (int i = 0; i < size; i++)
+        polynomial[i].expon = numericString[i];
+
+    return true;
+}
+
+// outputs a polynomial in the scalable layout
+template< typename TermType >
+void writeScalable(std::ostream& outFile, const std::vector< TermType >& polynomial)
+{
+    int size = static_cast< int >(polynomial.size());
+    std::vector< int > numericString(size);
+
+    outFile.write(reinterpret_cast<const char*>(&size), sizeof(int));
+
+    for (int i = 0; i < size; i++)
+        numericString[i] = polynomial[i].coef;
+    outFile.write(reinterpret_cast<const char*>(numericString.data()), sizeof(int) * size);
+
+    for (int i = 0; i < size; i++)
+        numericString[i] = polynomial[i].expon;
+    outFile.write(reinterpret_cast<const char*>(numericString.data()), sizeof(int) * size);
+}
+
+// inputs the header of a file in the multivariate layout;
+// returns false if the file is not in the multivariate layout
+inline bool readMultivariateHeader(std::istream& inFile, int& numPairs, int& numVariables)
+{
+    char magic[4] = {};
+    int version = 0;
+
+    inFile.read(magic, 4);
+    inFile.read(reinterpret_cast<char*>(&version), sizeof(int));
+    inFile.read(reinterpret_cast<char*>(&numPairs), sizeof(int));
+    inFile.read(reinterpret_cast<char*>(&numVariables), sizeof(int));
+
+    return inFile && magic[0] == 'P' && magic[1] == 'O' && magic[2] == 'L' && magic[3] == 'Y' &&
+        version == multivariateVersion && numPairs >= 0 && numVariables >= 1;
+}
+
+// outputs the header of a file in the multivariate layout
+inline void writeMultivariateHeader(std::ostream& outFile, int numPairs, int numVariables)
+{
+    const char magic[4] = { 'P', 'O', 'L', 'Y' };
+    const int version = multivariateVersion;
+
+    outFile.write(magic, 4);
+    outFile.write(reinterpret_cast<const char*>(&version), sizeof(int));
+    outFile.write(reinterpret_cast<const char*>(&numPairs), sizeof(int));
+    outFile.write(reinterpret_cast<const char*>(&numVariables), sizeof(int));
+}
+
+// inputs a polynomial stored in the multivariate layout; the exponents of term i
+// are exponents[ i * numVariables .. i * numVariables + numVariables - 1 ]
+inline bool readMultivariate(std::istream& inFile, int numVariables,
+    std::vector< int >& coefficients, std::vector< int >& exponents)
+{
+    int size = 0;
+    inFile.read(reinterpret_cast<char*>(&size), sizeof(int));
+    if (!inFile || size < 0)
+        return false;
+
+    return readChunked(inFile, coefficients, size) &&
+        readChunked(inFile, exponents, static_cast< size_t >(size) * numVariables);
+}
+
+// outputs a polynomial in the multivariate layout
+inline void writeMultivariate(std::ostream& outFile,
+    const std::vector< int >& coefficients, const std::vector< int >& exponents)
+{
+    int size = static_cast< int >(coefficients.size());
+
+    outFile.write(reinterpret_cast<const char*>(&size), sizeof(int));
+    outFile.write(reinterpret_cast<const char*>(coefficients.data()), sizeof(int) * coefficients.size());
+    outFile.write(reinterpret_cast<const char*>(exponents.data()), sizeof(int) * exponents.size());
+}
+
+// inputs a varint from a stream; returns false if it is cut off or malformed
+inline bool readVarint(std::istream& inFile, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 7 * maxVarintBytes; shift += 7)
+    {
+        int byte = inFile.get();
+        if (byte == std::char_traits< char >::eof())
+            return false;
+        value |= static_cast< uint64_t >(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+// outputs polynomials in the compact layout; the stream must be seekable,
+// since the number of pairs is known only at the end
+class CompactWriter
+{
+public:
+    // outputs the header; every indexInterval-th polynomial gets an index entry
+    explicit CompactWriter(std::ostream& outFile, int indexInterval = compactIndexInterval)
+        : out(outFile), start(outFile.tellp()), interval(indexInterval)
+    {
+        const char magic[4] = { 'P', 'O', 'L', 'Y' };
+        const int version = compactVersion;
+        const int numPairs = 0;
+
+        out.write(magic, 4);
+        out.write(reinterpret_cast<const char*>(&version), sizeof(int));
+        out.write(reinterpret_cast<const char*>(&numPairs), sizeof(int));
+        out.write(reinterpret_cast<const char*>(&interval), sizeof(int));
+    }
+
+    // outputs the next polynomial
+    template< typename TermType >
+    void write(const std::vector< TermType >& polynomial)
+    {
+        if (numWritten % interval == 0)
+            index.push_back(static_cast< uint64_t >(out.tellp() - start));
+        numWritten++;
+
+        payload.clear();
+        long long previous = 0;
+        for (size_t i = 0; i < polynomial.size(); i++)
+        {
+            long long expon = polynomial[i].expon;
+            appendVarint(payload, zigzagEncode(i == 0 ? expon : previous - expon));
+            previous = expon;
+        }
+        for (size_t i = 0; i < polynomial.size(); i++)
+            appendVarint(payload, zigzagEncode(polynomial[i].coef));
+
+        prefix.clear();
+        appendVarint(prefix, polynomial.size());
+        appendVarint(prefix, payload.size());
+        out.write(reinterpret_cast<const char*>(prefix.data()), prefix.size());
+        out.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+    }
+
+    // outputs the index and the trailer and stores the number of pairs in the header
+    void finish()
+    {
+        uint64_t indexOffset = static_cast< uint64_t >(out.tellp() - start);
+        out.write(reinterpret_cast<const char*>(index.data()), sizeof(uint64_t) * index.size());
+        out.write(reinterpret_cast<const char*>(&indexOffset), sizeof(uint64_t));
+
+        std::streampos end = out.tellp();
+        int numPairs = static_cast< int >(numWritten / 2);
+        out.seekp(start + static_cast< std::streamoff >(8));
+        out.write(reinterpret_cast<const char*>(&numPairs), sizeof(int));
+        out.seekp(end);
+    }
+
+private:
+    std::ostream& out;
+    std::streampos start;   // the position of the header
+    int interval;
+    long long numWritten = 0;
+    std::vector< uint64_t > index;
+    std::vector< unsigned char > prefix;
+    std::vector< unsigned char > payload;
+};
+
+// inputs polynomials stored in the compact layout, one after another or at any position
+class CompactReader
+{
+public:
+    // inputs the header; isOpen() tells whether the stream is in the compact layout
+    explicit CompactReader(std::istream& inFile)
+        : in(inFile), start(inFile.tellg())
+    {
+        char magic[4] = {};
+        int version = 0;
+
+        in.read(magic, 4);
+        in.read(reinterpret_cast<char*>(&version), sizeof(int));
+        in.read(reinterpret_cast<char*>(&pairs), sizeof(int));
+        in.read(reinterpret_cast<char*>(&interval), sizeof(int));
+
+        open = in && magic[0] == 'P' && magic[1] == 'O' && magic[2] == 'L' && magic[3] == 'Y' &&
+            version == compactVersion && pairs >= 0 && interval >= 1;
+    }
+
+    bool isOpen() const
+    {
+        return open;
+    }
+
+    int numPairs() const
+    {
+        return pairs;
+    }
+
+    // inputs the next polynomial; returns false at the end of the data or on malformed data
+    template< typename TermType >
+    bool read(std::vector< TermType >& polynomial)
+    {
+        uint64_t numTerms = 0;
+        uint64_t numBytes = 0;
+        // every term takes 2 to 2 * maxVarintBytes bytes
+        if (!open || next >= 2LL * pairs || !readVarint(in, numTerms) || !readVarint(in, numBytes) ||
+            numTerms > numBytes / 2 || numBytes / (2 * maxVarintBytes) > numTerms)
+            return false;
+
+        // the payload is stored only as far as the stream holds it, and the values are fewer than its bytes
+        if (!readChunked(in, payload, static_cast< size_t >(numBytes)))
+            return false;
+
+        values.resize(2 * numTerms);
+        size_t position = 0;
+        if (!decodeVarints(payload.data(), payload.size(), position, values.data(), values.size()) ||
+            position != payload.size())
+            return false;
+
+        polynomial.resize(numTerms);
+        long long expon = 0;
+        for (size_t i = 0; i < numTerms; i++)
+        {
+            long long delta = zigzagDecode(values[i]);
+            expon = i == 0 ? delta : expon - delta;
+            polynomial[i].coef = static_cast< int >(zigzagDecode(values[numTerms + i]));
+            polynomial[i].expon = static_cast< int >(expon);
+        }
+
+        next++;
+        return true;
+    }
+
+    // moves to polynomial number ( 0 .. 2 * numPairs() - 1; dividend i is 2 * i, divisor i is 2 * i + 1 );
+    // returns false if there is no such polynomial or the index cannot be read
+    bool seek(long long number)
+    {
+        if (!open || number < 0 || number >= 2LL * pairs || !loadIndex())
+            return false;
+
+        in.clear();
+        in.seekg(start + static_cast< std::streamoff >(index[number / interval]));
+        next = number / interval * interval;
+
+        // skip the polynomials before it in its block by their sizes
+        while (next < number)
+        {
+            uint64_t numTerms = 0;
+            uint64_t numBytes = 0;
+            if (!readVarint(in, numTerms) || !readVarint(in, numBytes))
+                return false;
+
+            std::streamoff bytesLeft = end - in.tellg();
+            if (bytesLeft < 0 || numBytes > static_cast< uint64_t >(bytesLeft))
+                return false;
+            in.seekg(static_cast< std::streamoff >(numBytes), std::ios::cur);
+            next++;
+        }
+
+        return static_cast< bool >(in);
+    }
+
+private:
+    // inputs the index through the trailer, once; returns false unless the index lies between
+    // the header and the trailer
+    bool loadIndex()
+    {
+        if (!index.empty())
+            return true;
+
+        in.clear();
+        in.seekg(0, std::ios::end);
+        end = in.tellg();
+
+        uint64_t indexOffset = 0;
+        in.seekg(-static_cast< std::streamoff >(sizeof(uint64_t)), std::ios::end);
+        in.read(reinterpret_cast<char*>(&indexOffset), sizeof(uint64_t));
+
+        uint64_t numEntries = static_cast< uint64_t >((2LL * pairs + interval - 1) / interval);
+        std::streamoff indexBytes = end - start - static_cast< std::streamoff >(sizeof(uint64_t));
+        if (!in || indexBytes < 0 || indexOffset > static_cast< uint64_t >(indexBytes) ||
+            numEntries > (static_cast< uint64_t >(indexBytes) - indexOffset) / sizeof(uint64_t))
+            return false;
+
+        index.resize(static_cast< size_t >(numEntries));
+        in.seekg(start + static_cast< std::streamoff >(indexOffset));
+        in.read(reinterpret_cast<char*>(index.data()), sizeof(uint64_t) * index.size());
+        if (!in)
+            index.clear();
+
+        return static_cast< bool >(in);
+    }
+
+    std::istream& in;
+    std::streampos start; // the position of the header
+    std::streampos end;   // the end of the stream, known once the index is loaded
+    bool open = false;
+    int pairs = 0;
+    int interval = 1;
+    long long next = 0;   // the number of the polynomial read next
+    std::vector< uint64_t > index;
+    std::vector< unsigned char > payload;
+    std::vector< uint64_t > values;
+};
+
+// inputs all dividend / divisor pairs of a file in any univariate layout;
+// returns false if the file could not be opened
+template< typename TermType >
+bool readWorkload(const std::string& fileName, std::vector< std::vector< TermType > >& dividends,
+    std::vector< std::vector< TermType > >& divisors)
+{
+    std::ifstream inFile(fileName, std::ios::in | std::ios::binary);
+    if (!inFile)
+        return false;
+
+    dividends.clear();
+    divisors.clear();
+
+    std::vector< TermType > dividend;
+    std::vector< TermType > divisor;
+
+    int numPairs = 0;
+    if (readScalableHeader(inFile, numPairs))
+    {
+        for (int i = 0; i < numPairs && readScalable(inFile, dividend) && readScalable(inFile, divisor); i++)
+        {
+            dividends.push_back(dividend);
+            divisors.push_back(divisor);
+        }
+    }
+    else
+    {
+        inFile.clear();
+        inFile.seekg(0);
+
+        CompactReader reader(inFile);
+        if (reader.isOpen())
+        {
+            while (reader.read(dividend) && reader.read(divisor))
+            {
+                dividends.push_back(dividend);
+                divisors.push_back(divisor);
+            }
+        }
+        else
+        {
+            inFile.clear();
+            inFile.seekg(0);
+            while (readLegacy(inFile, dividend) && readLegacy(inFile, divisor))
+            {
+                dividends.push_back(dividend);
+                divisors.push_back(divisor);
+            }
+        }
+    }
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,541 @@
+// PolynomialGcd.h
+// Greatest common divisors of polynomials with integer coefficients by the modular method.
+//
+// Euclid's algorithm over the integers makes the coefficients of the remainders grow
+// exponentially. Instead the primitive parts of both polynomials are reduced modulo primes
+// just below 2^31, where Euclid's algorithm is exact and cheap. The monic images of the gcd are
+// combined by the Chinese remainder theorem, every coefficient is recovered as a fraction by
+// rational reconstruction, and the denominators are cleared. A candidate is accepted only when it
+// divides both primitive parts, which heapDivision checks exactly; an unlucky prime shows itself
+// by an image of too high a degree and is skipped.
+//
+// The polynomials are kept as sparse terms. Modulo a prime, a step of Euclid's algorithm is a
+// heapDivision on residue terms while the remainders stay sparse, and the algorithm moves to
+// dense residue arrays, O( d^2 ) for degree d after the common power of x has been divided out,
+// only once they have filled in; a sparse input such as x^1000000 - 1 never allocates or walks an
+// array of its degree.
+
+#ifndef POLYNOMIAL_GCD_H
+#define POLYNOMIAL_GCD_H
+
+#include <vector>
+#include <algorithm>
+
+#include "Coefficient.h"
+#include "HeapDivision.h"
+
+// returns true if and only if n is a prime
+inline bool isPrime(unsigned n)
+{
+    if (n < 2)
+        return false;
+
+    for (unsigned divisor = 2; divisor <= n / divisor; divisor++)
+        if (n % divisor == 0)
+            return false;
+
+    return true;
+}
+
+// returns the largest prime below n, provided that n > 2
+inline unsigned previousPrime(unsigned n)
+{
+    unsigned candidate = n - 1;
+    while (!isPrime(candidate))
+        candidate--;
+
+    return candidate;
+}
+
+// returns base^exponent mod prime
+inline unsigned long long powerMod(unsigned long long base, unsigned long long exponent, unsigned prime)
+{
+    unsigned long long power = 1;
+    for (base %= prime; exponent != 0; exponent >>= 1)
+    {
+        if (exponent & 1)
+            power = power * base % prime;
+        base = base * base % prime;
+    }
+
+    return power;
+}
+
+// returns the inverse of value modulo prime, provided that prime does not divide value
+inline unsigned long long inverseMod(unsigned long long value, unsigned prime)
+{
+    return powerMod(value, prime - 2, prime);
+}
+
+// returns value mod prime in [ 0, prime )
+inline unsigned long long residue(const Coefficient& value, unsigned prime)
+{
+    long long remainder = 0;
+    (value % Coefficient(static_cast< long long >(prime))).toLongLong(remainder);
+    return remainder < 0 ? remainder + prime : remainder;
+}
+
+// returns | value |
+inline Coefficient absoluteValue(const Coefficient& value)
+{
+    return value < Coefficient() ? -value : value;
+}
+
+// returns the nonnegative gcd of two integers
+inline Coefficient integerGcd(Coefficient a, Coefficient b)
+{
+    while (b != Coefficient())
+    {
+        Coefficient rest = a % b;
+        a = std::move(b);
+        b = std::move(rest);
+    }
+
+    return absoluteValue(a);
+}
+
+// finds numerator / denominator == value modulo modulus with | numerator |, denominator < sqrt( modulus / 2 )
+// ( Wang's rational reconstruction ); returns false if there is no such fraction
+inline bool rationalReconstruction(const Coefficient& value, const Coefficient& modulus,
+    Coefficient& numerator, Coefficient& denominator)
+{
+    Coefficient r0 = modulus;
+    Coefficient r1 = value;
+    Coefficient t0 = 0;
+    Coefficient t1 = 1;
+
+    // the extended Euclidean algorithm, stopped at the first remainder below the bound
+    while (Coefficient(2) * r1 * r1 >= modulus)
+    {
+        Coefficient quotient = r0 / r1;
+
+        Coefficient r2 = r0 - quotient * r1;
+        r0 = std::move(r1);
+        r1 = std::move(r2);
+
+        Coefficient t2 = t0 - quotient * t1;
+        t0 = std::move(t1);
+        t1 = std::move(t2);
+    }
+
+    if (Coefficient(2) * t1 * t1 >= modulus || integerGcd(r1, t1) != Coefficient(1))
+        return false;
+
+    numerator = t1 < Coefficient() ? -r1 : r1;
+    denominator = absoluteValue(t1);
+    return true;
+}
+
+// the coefficients of a dense polynomial modulo a prime, the coefficient of x^i at position i;
+// the last coefficient is nonzero
+typedef std::vector< unsigned long long > DenseModularPolynomial;
+
+// removes the zero coefficients of the highest powers
+inline void trim(DenseModularPolynomial& polynomial)
+{
+    while (!polynomial.empty() && polynomial.back() == 0)
+        polynomial.pop_back();
+}
+
+// dividend = dividend mod divisor, provided that divisor != 0
+inline void remainderMod(DenseModularPolynomial& dividend, const DenseModularPolynomial& divisor, unsigned prime)
+{
+    const size_t divisorDegree = divisor.size() - 1;
+    const unsigned long long leadingInverse = inverseMod(divisor.back(), prime);
+
+    while (dividend.size() >= divisor.size())
+    {
+        // dividend -= ( lc( dividend ) / lc( divisor ) ) * x^shift * divisor
+        unsigned long long factor = dividend.back() * leadingInverse % prime;
+        size_t shift = dividend.size() - 1 - divisorDegree;
+        for (size_t i = 0; i < divisorDegree; i++)
+            dividend[shift + i] = (dividend[shift + i] + (prime - factor) * divisor[i]) % prime;
+
+        dividend.pop_back();
+        trim(dividend);
+    }
+}
+
+// returns the monic gcd of two polynomials modulo prime, provided that not both are 0
+inline DenseModularPolynomial gcdMod(DenseModularPolynomial a, DenseModularPolynomial b, unsigned prime)
+{
+    while (!b.empty())
+    {
+        remainderMod(a, b, prime);
+        a.swap(b);
+    }
+
+    unsigned long long leadingInverse = inverseMod(a.back(), prime);
+    for (size_t i = 0; i < a.size(); i++)
+        a[i] = a[i] * leadingInverse % prime;
+
+    return a;
+}
+
+// a coefficient modulo a prime, with the arithmetic heapDivision needs; a quotient is taken with
+// the inverse of the divisor, so it is exact. Residue() is 0 modulo every prime, and the other
+// operand of an operation supplies the prime.
+struct Residue
+{
+    unsigned long long value = 0; // in [ 0, prime )
+    unsigned prime = 0;
+};
+
+inline bool operator==(const Residue& residue1, const Residue& residue2)
+{
+    return residue1.value == residue2.value;
+}
+
+inline bool operator!=(const Residue& residue1, const Residue& residue2)
+{
+    return residue1.value != residue2.value;
+}
+
+inline Residue operator-(const Residue& minuend, const Residue& subtrahend)
+{
+    Residue difference;
+    difference.prime = minuend.prime > subtrahend.prime ? minuend.prime : subtrahend.prime;
+    difference.value = (minuend.value + difference.prime - subtrahend.value) % difference.prime;
+    return difference;
+}
+
+inline Residue& operator-=(Residue& minuend, const Residue& subtrahend)
+{
+    return minuend = minuend - subtrahend;
+}
+
+inline Residue operator*(const Residue& multiplicand, const Residue& multiplier)
+{
+    Residue product;
+    product.prime = multiplicand.prime > multiplier.prime ? multiplicand.prime : multiplier.prime;
+    product.value = multiplicand.value * multiplier.value % product.prime;
+    return product;
+}
+
+// provided that divisor != 0
+inline Residue operator/(const Residue& dividend, const Residue& divisor)
+{
+    Residue inverse;
+    inverse.prime = divisor.prime;
+    inverse.value = inverseMod(divisor.value, divisor.prime);
+    return dividend * inverse;
+}
+
+// a term of a polynomial modulo a prime
+struct ResidueTerm
+{
+    Residue coef;  // the coefficient of a term
+    int expon = 0; // the exponent of a term
+};
+
+// the nonzero terms of a polynomial modulo a prime, in descending order of exponents
+typedef std::vector< ResidueTerm > ModularPolynomial;
+
+// dividend = dividend mod divisor, provided that divisor != 0
+inline void remainderMod(ModularPolynomial& dividend, const ModularPolynomial& divisor)
+{
+    ModularPolynomial remainder;
+    heapDivision(termLayout(dividend), termLayout(divisor),
+        [](const Residue&, int) {},
+        [&remainder](const Residue& coef, int expon)
+        {
+            ResidueTerm term;
+            term.coef = coef;
+            term.expon = expon;
+            remainder.push_back(term);
+        });
+
+    dividend.swap(remainder);
+}
+
+// returns the dense array of a polynomial modulo a prime
+inline DenseModularPolynomial denseResidues(const ModularPolynomial& polynomial)
+{
+    DenseModularPolynomial dense(polynomial.empty() ? 0 : polynomial.front().expon + 1);
+    for (size_t i = 0; i < polynomial.size(); i++)
+        dense[polynomial[i].expon] = polynomial[i].coef.value;
+
+    return dense;
+}
+
+// returns the nonzero terms of a dense polynomial modulo prime
+inline ModularPolynomial sparseResidues(const DenseModularPolynomial& dense, unsigned prime)
+{
+    ModularPolynomial polynomial;
+    for (size_t i = dense.size(); i-- > 0; )
+        if (dense[i] != 0)
+        {
+            ResidueTerm term;
+            term.coef.value = dense[i];
+            term.coef.prime = prime;
+            term.expon = static_cast< int >(i);
+            polynomial.push_back(term);
+        }
+
+    return polynomial;
+}
+
+// Euclid's algorithm switches to dense arrays once the polynomials have at least
+// 1 / denseResidueRatio as many terms as their degree
+const size_t denseResidueRatio = 16;
+
+// returns the monic gcd of two polynomials modulo a prime, provided that not both are 0.
+// While the remainders stay sparse, every step is a heapDivision on their terms; once they have
+// filled in, a step on dense arrays is a plain loop and the rest of the algorithm runs there.
+inline ModularPolynomial gcdMod(ModularPolynomial a, ModularPolynomial b)
+{
+    while (!b.empty())
+    {
+        size_t degree = static_cast< size_t >(std::max(a.front().expon, b.front().expon));
+        if ((a.size() + b.size()) * denseResidueRatio > degree)
+        {
+            unsigned prime = b.front().coef.prime;
+            return sparseResidues(gcdMod(denseResidues(a), denseResidues(b), prime), prime);
+        }
+
+        remainderMod(a, b);
+        a.swap(b);
+    }
+
+    const Residue leadingCoef = a.front().coef;
+    for (size_t i = 0; i < a.size(); i++)
+        a[i].coef = a[i].coef / leadingCoef;
+
+    return a;
+}
+
+// a term of the polynomials built by polynomialGcd
+struct GcdTerm
+{
+    Coefficient coef; // the coefficient of a term
+    int expon = 0;    // the exponent of a term
+};
+
+inline bool operator==(const GcdTerm& term1, const GcdTerm& term2)
+{
+    return term1.expon == term2.expon && term1.coef == term2.coef;
+}
+
+// returns the terms of polynomial modulo prime, without those that vanish
+inline ModularPolynomial reduceMod(const std::vector< GcdTerm >& polynomial, unsigned prime)
+{
+    ModularPolynomial reduced;
+    for (size_t i = 0; i < polynomial.size(); i++)
+    {
+        ResidueTerm term;
+        term.coef.value = residue(polynomial[i].coef, prime);
+        term.coef.prime = prime;
+        term.expon = polynomial[i].expon;
+        if (term.coef.value != 0)
+            reduced.push_back(term);
+    }
+
+    return reduced;
+}
+
+// returns true if and only if divisor divides dividend exactly;
+// heapDivision keeps dividend == divisor * quotient + remainder, so an empty remainder proves it
+inline bool dividesExactly(const std::vector< GcdTerm >& divisor, const std::vector< GcdTerm >& dividend)
+{
+    bool exact = true;
+    heapDivision(termLayout(dividend), termLayout(divisor),
+        [](const Coefficient&, int) {},
+        [&exact](const Coefficient&, int) { exact = false; });
+
+    return exact;
+}
+
+// statistics of the last call of polynomialGcd on this thread
+struct GcdStatistics
+{
+    int numPrimes = 0;        // the primes whose images were computed
+    int numUnluckyPrimes = 0; // the primes whose images had too high a degree
+    int numTrialDivisions = 0;
+};
+
+inline GcdStatistics& gcdStatistics()
+{
+    static thread_local GcdStatistics statistics;
+    return statistics;
+}
+
+// returns the primitive part of the gcd of two primitive polynomials of positive degree,
+// with a positive leading coefficient; the terms are in descending order of exponents
+inline std::vector< GcdTerm > primitiveGcd(const std::vector< GcdTerm >& a, const std::vector< GcdTerm >& b)
+{
+    GcdStatistics& statistics = gcdStatistics();
+
+    Coefficient modulus = 1;
+    std::vector< GcdTerm > images; // the monic gcd modulo modulus, coefficients in [ 0, modulus )
+    std::vector< GcdTerm > lastCandidate;
+    unsigned prime = 1u << 31;
+
+    for (;;)
+    {
+        prime = previousPrime(prime);
+
+        // a prime that divides a leading coefficient lowers a degree
+        if (residue(a.front().coef, prime) == 0 || residue(b.front().coef, prime) == 0)
+            continue;
+
+        ModularPolynomial image = gcdMod(reduceMod(a, prime), reduceMod(b, prime));
+        statistics.numPrimes++;
+
+        // the images of coprime polynomials are coprime for all but finitely many primes
+        if (image.front().expon == 0)
+            return std::vector< GcdTerm >(1, GcdTerm{ Coefficient(1), 0 });
+
+        if (images.empty() || image.front().expon < images.front().expon)
+        {
+            // the first image, or every earlier prime was unlucky
+            statistics.numUnluckyPrimes += images.empty() ? 0 : 1;
+            modulus = static_cast< long long >(prime);
+            images.assign(image.size(), GcdTerm());
+            for (size_t i = 0; i < image.size(); i++)
+            {
+                images[i].coef = static_cast< long long >(image[i].coef.value);
+                images[i].expon = image[i].expon;
+            }
+        }
+        else if (image.front().expon > images.front().expon)
+        {
+            statistics.numUnluckyPrimes++;
+            continue;
+        }
+        else
+        {
+            // images[ i ] += modulus * ( ( image[ i ] - images[ i ] ) / modulus mod prime ),
+            // merged by exponent, since a coefficient may vanish modulo some of the primes
+            unsigned long long modulusInverse = inverseMod(residue(modulus, prime), prime);
+            std::vector< GcdTerm > merged;
+            size_t i = 0;
+            size_t j = 0;
+            while (i < images.size() || j < image.size())
+            {
+                GcdTerm term;
+                unsigned long long imageValue = 0;
+                if (j == image.size() || (i < images.size() && images[i].expon > image[j].expon))
+                    term = images[i++];
+                else if (i == images.size() || image[j].expon > images[i].expon)
+                {
+                    term.expon = image[j].expon;
+                    imageValue = image[j++].coef.value;
+                }
+                else
+                {
+                    term = images[i++];
+                    imageValue = image[j++].coef.value;
+                }
+
+                unsigned long long difference = (imageValue + prime - residue(term.coef, prime)) % prime;
+                term.coef += modulus * Coefficient(static_cast< long long >(difference * modulusInverse % prime));
+                merged.push_back(term);
+            }
+            images.swap(merged);
+            modulus *= static_cast< long long >(prime);
+        }
+
+        // recover the rational coefficients of the monic gcd and clear their denominators
+        std::vector< Coefficient > numerators(images.size());
+        std::vector< Coefficient > denominators(images.size());
+        bool reconstructed = true;
+        for (size_t i = 0; reconstructed && i < images.size(); i++)
+            reconstructed = rationalReconstruction(images[i].coef, modulus, numerators[i], denominators[i]);
+        if (!reconstructed)
+            continue;
+
+        Coefficient denominatorLcm = 1;
+        for (size_t i = 0; i < denominators.size(); i++)
+            denominatorLcm = denominatorLcm / integerGcd(denominatorLcm, denominators[i]) * denominators[i];
+
+        std::vector< GcdTerm > candidate;
+        Coefficient content = 0;
+        for (size_t i = 0; i < images.size(); i++)
+            if (numerators[i] != Coefficient())
+            {
+                GcdTerm term;
+                term.coef = numerators[i] * (denominatorLcm / denominators[i]);
+                term.expon = images[i].expon;
+                content = integerGcd(content, term.coef);
+                candidate.push_back(term);
+            }
+        for (size_t i = 0; i < candidate.size(); i++)
+            candidate[i].coef = candidate[i].coef / content;
+
+        // a candidate that failed once stays wrong until another prime changes it
+        if (candidate == lastCandidate)
+            continue;
+        lastCandidate = candidate;
+
+        statistics.numTrialDivisions++;
+        if (dividesExactly(candidate, a) && dividesExactly(candidate, b))
+            return candidate;
+    }
+}
+
+// calls emit( coef, expon ) for every term of gcd( polynomial1, polynomial2 ), in descending order
+// of exponents; coef is a Coefficient. The gcd has a positive leading coefficient, and gcd( a, 0 )
+// is a with its sign made positive. The exponents are int and the coefficients anything a
+// Coefficient can be made from.
+template< typename Layout1, typename Layout2, typename Emit >
+void polynomialGcd(const Layout1& polynomial1, const Layout2& polynomial2, Emit emit)
+{
+    gcdStatistics() = GcdStatistics();
+
+    // gcd( a, 0 ) = | a |
+    auto emitPositive = [&emit](const auto& polynomial)
+    {
+        bool negative = polynomial.size != 0 && Coefficient(polynomial.coef(0)) < Coefficient();
+        for (int i = 0; i < polynomial.size; i++)
+        {
+            Coefficient coef = polynomial.coef(i);
+            emit(negative ? -coef : coef, polynomial.expon(i));
+        }
+    };
+
+    if (polynomial2.size == 0)
+    {
+        emitPositive(polynomial1);
+        return;
+    }
+    if (polynomial1.size == 0)
+    {
+        emitPositive(polynomial2);
+        return;
+    }
+
+    // copies with the lowest power of x divided out, and their contents
+    auto sparsePrimitive = [](const auto& polynomial, Coefficient& content)
+    {
+        int lowest = polynomial.expon(polynomial.size - 1);
+        std::vector< GcdTerm > terms(polynomial.size);
+        content = 0;
+        for (int i = 0; i < polynomial.size; i++)
+        {
+            terms[i].coef = polynomial.coef(i);
+            terms[i].expon = polynomial.expon(i) - lowest;
+            content = integerGcd(content, terms[i].coef);
+        }
+        for (size_t i = 0; i < terms.size(); i++)
+            terms[i].coef = terms[i].coef / content;
+
+        return terms;
+    };
+
+    Coefficient content1;
+    Coefficient content2;
+    std::vector< GcdTerm > a = sparsePrimitive(polynomial1, content1);
+    std::vector< GcdTerm > b = sparsePrimitive(polynomial2, content2);
+
+    Coefficient content = integerGcd(content1, content2);
+    int lowest = std::min(polynomial1.expon(polynomial1.size - 1), polynomial2.expon(polynomial2.size - 1));
+
+    std::vector< GcdTerm > gcd(1, GcdTerm{ Coefficient(1), 0 });
+    if (a.front().expon > 0 && b.front().expon > 0)
+        gcd = primitiveGcd(a, b);
+
+    for (size_t i = 0; i < gcd.size(); i++)
+        emit(content * gcd[i].coef, gcd[i].expon + lowest);
+}
+
+#endif
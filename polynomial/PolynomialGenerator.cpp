@@ -0,0 +1,558 @@
+// Generates dividend / divisor pairs whose quotient and remainder have integer coefficients
+//
+// usage: PolynomialGenerator [options]
+//   --pairs n            the number of dividend / divisor pairs (200)
+//   --divisor-terms n    the number of terms of every divisor (5)
+//   --quotient-terms n   the number of terms of every quotient (5)
+//   --remainder-terms n  the maximum number of terms of every remainder (3)
+//   --degree n           the maximum degree of divisors and quotients (19)
+//   --sparsity s         the fraction of nonzero terms, 0 < s <= 1; overrides --degree
+//   --max-gap n          the maximum gap between consecutive exponents; overrides --degree
+//   --coef-range n       coefficients are chosen from [ -n, n ] \ { 0 } (9)
+//   --seed n             the seed of the random number generator (1)
+//   --variables n        the number of variables, 1 to 8 (1); more than one variable
+//                        writes the multivariate layout to the --scalable file, the remainder
+//                        then has no term divisible by the leading term of the divisor
+//   --legacy file        writes the 80 / 160-byte layout read by hw7 and hw8 (Polynomials.dat)
+//   --scalable file      writes the scalable layout described in PolynomialFile.h
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <fstream>
+using std::ofstream;
+using std::ios;
+
+#include <vector>
+using std::vector;
+
+#include <string>
+using std::string;
+
+#include <algorithm>
+using std::sort;
+
+#include <map>
+using std::map;
+
+#include <random>
+using std::mt19937_64;
+using std::uniform_int_distribution;
+
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+#include "PolynomialFile.h"
+#include "Monomial.h"
+
+struct Term
+{
+    int coef = 0;  // the coefficient of a term
+    int expon = 0; // the exponent of a term
+};
+
+struct Options
+{
+    int numPairs = 200;
+    int divisorTerms = 5;
+    int quotientTerms = 5;
+    int remainderTerms = 3;
+    int degree = 19;
+    double sparsity = 0.0;
+    int maxGap = 0;
+    int coefRange = 9;
+    unsigned long long seed = 1;
+    int numVariables = 1;
+    string legacyFile;
+    string scalableFile;
+};
+
+// reads the command-line options; returns false on an unknown or malformed option
+bool parseOptions(int argc, char* argv[], Options& options);
+
+// returns a random polynomial with numTerms terms whose degree is less than or equal to maxDegree
+// and whose exponents are not less than minExpon; if maxGap > 0, consecutive exponents differ by
+// at most maxGap and maxDegree is ignored
+vector< Term > randomPolynomial(mt19937_64& engine, const Options& options,
+    int numTerms, int minExpon, int maxDegree, int maxGap);
+
+// dividend = divisor * quotient + remainder;
+// returns false if a coefficient of dividend does not fit in an int
+bool compose(const vector< Term >& divisor, const vector< Term >& quotient,
+    const vector< Term >& remainder, vector< Term >& dividend);
+
+// a term of a multivariate polynomial with its exponents unpacked
+struct VectorTerm
+{
+    int coef = 0;          // the coefficient of a term
+    vector< int > expon;   // the exponent of every variable
+};
+
+// returns true if and only if exponent vector a precedes b in descending graded lexicographic order
+bool gradedGreater(const vector< int >& a, const vector< int >& b);
+
+// returns a random polynomial in options.numVariables variables with at most numTerms terms
+// of total degree at most maxDegree, in descending graded order; if leadingMonomial is not
+// nullptr, no term is divisible by it
+vector< VectorTerm > randomMultivariate(mt19937_64& engine, const Options& options,
+    int numTerms, int maxDegree, const vector< int >* leadingMonomial);
+
+// dividend = divisor * quotient + remainder for multivariate polynomials;
+// returns false if a coefficient of dividend does not fit in an int
+bool composeMultivariate(const vector< VectorTerm >& divisor, const vector< VectorTerm >& quotient,
+    const vector< VectorTerm >& remainder, vector< VectorTerm >& dividend);
+
+// writes options.numPairs multivariate pairs to options.scalableFile; returns the exit code
+int generateMultivariate(const Options& options);
+
+const int maxAttempts = 1000; // the number of attempts to find a pair that fits the requested layout
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+        return 1;
+
+    if (options.numVariables > 1)
+        return generateMultivariate(options);
+
+    if (options.legacyFile.empty() && options.scalableFile.empty())
+        options.legacyFile = "Polynomials.dat";
+
+    bool legacy = !options.legacyFile.empty();
+    if (legacy && (options.divisorTerms > legacyArraySize || options.quotientTerms > legacyArraySize))
+    {
+        cerr << "The legacy layout holds at most " << legacyArraySize << " terms per polynomial" << endl;
+        return 1;
+    }
+
+    ofstream legacyFile;
+    ofstream scalableFile;
+    if (legacy)
+        legacyFile.open(options.legacyFile, ios::out | ios::binary);
+    if (!options.scalableFile.empty())
+    {
+        scalableFile.open(options.scalableFile, ios::out | ios::binary);
+        writeScalableHeader(scalableFile, options.numPairs);
+    }
+
+    if ((legacy && !legacyFile) || (!options.scalableFile.empty() && !scalableFile))
+    {
+        cerr << "File could not be opened" << endl;
+        return 1;
+    }
+
+    mt19937_64 engine(options.seed);
+    vector< Term > dividend;
+    long long totalDividendTerms = 0;
+
+    for (int i = 0; i < options.numPairs; i++)
+    {
+        vector< Term > divisor;
+        vector< Term > quotient;
+        vector< Term > remainder;
+
+        int attempt = 0;
+        for (; attempt < maxAttempts; attempt++)
+        {
+            divisor = randomPolynomial(engine, options, options.divisorTerms, 0, options.degree, options.maxGap);
+
+            // deg( remainder ) < deg( divisor )
+            int divisorDegree = divisor[0].expon;
+            int remainderTerms = uniform_int_distribution< int >(0, options.remainderTerms)(engine);
+            if (remainderTerms > divisorDegree)
+                remainderTerms = divisorDegree;
+
+            quotient = randomPolynomial(engine, options, options.quotientTerms, 0, options.degree, options.maxGap);
+            remainder = randomPolynomial(engine, options, remainderTerms, 0, divisorDegree - 1, 0);
+
+            if (!compose(divisor, quotient, remainder, dividend))
+                continue;
+            if (legacy && dividend.size() > legacyArraySize)
+                continue;
+            break;
+        }
+
+        if (attempt == maxAttempts)
+        {
+            cerr << "Could not generate pair " << i << "; try fewer terms or a smaller coefficient range" << endl;
+            return 1;
+        }
+
+        totalDividendTerms += dividend.size();
+
+        if (legacy)
+        {
+            writeLegacy(legacyFile, dividend);
+            writeLegacy(legacyFile, divisor);
+        }
+
+        if (scalableFile.is_open())
+        {
+            writeScalable(scalableFile, dividend);
+            writeScalable(scalableFile, divisor);
+        }
+    }
+
+    cout << options.numPairs << " pairs written, " << totalDividendTerms / (options.numPairs > 0 ? options.numPairs : 1)
+        << " dividend terms on average" << endl;
+}
+
+// reads the command-line options; returns false on an unknown or malformed option
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (i + 1 == argc)
+        {
+            cerr << "Missing value for " << argv[i] << endl;
+            return false;
+        }
+
+        const char* name = argv[i];
+        const char* value = argv[++i];
+
+        if (strcmp(name, "--pairs") == 0)
+            options.numPairs = atoi(value);
+        else if (strcmp(name, "--divisor-terms") == 0)
+            options.divisorTerms = atoi(value);
+        else if (strcmp(name, "--quotient-terms") == 0)
+            options.quotientTerms = atoi(value);
+        else if (strcmp(name, "--remainder-terms") == 0)
+            options.remainderTerms = atoi(value);
+        else if (strcmp(name, "--degree") == 0)
+            options.degree = atoi(value);
+        else if (strcmp(name, "--sparsity") == 0)
+            options.sparsity = atof(value);
+        else if (strcmp(name, "--max-gap") == 0)
+            options.maxGap = atoi(value);
+        else if (strcmp(name, "--coef-range") == 0)
+            options.coefRange = atoi(value);
+        else if (strcmp(name, "--seed") == 0)
+            options.seed = strtoull(value, nullptr, 10);
+        else if (strcmp(name, "--variables") == 0)
+            options.numVariables = atoi(value);
+        else if (strcmp(name, "--legacy") == 0)
+            options.legacyFile = value;
+        else if (strcmp(name, "--scalable") == 0)
+            options.scalableFile = value;
+        else
+        {
+            cerr << "Unknown option " << name << endl;
+            return false;
+        }
+    }
+
+    if (options.numPairs < 0 || options.divisorTerms < 1 || options.quotientTerms < 1 ||
+        options.remainderTerms < 0 || options.coefRange < 1 || options.maxGap < 0 ||
+        options.numVariables < 1 || options.numVariables > maxVariables ||
+        options.sparsity < 0.0 || options.sparsity > 1.0 ||
+        static_cast< long long >(options.maxGap) * (options.divisorTerms + options.quotientTerms) > INT_MAX / 2)
+    {
+        cerr << "Invalid option value" << endl;
+        return false;
+    }
+
+    // the degree must leave room for the requested number of distinct exponents
+    if (options.sparsity > 0.0)
+        options.degree = static_cast< int >(options.quotientTerms / options.sparsity) - 1;
+    if (options.degree < options.divisorTerms - 1)
+        options.degree = options.divisorTerms - 1;
+    if (options.degree < options.quotientTerms - 1)
+        options.degree = options.quotientTerms - 1;
+
+    if (options.numVariables > 1)
+    {
+        if (options.scalableFile.empty() || !options.legacyFile.empty() || options.maxGap > 0)
+        {
+            cerr << "Multivariate pairs are written with --scalable only, without --legacy or --max-gap" << endl;
+            return false;
+        }
+
+        // the dividend has twice the degree of a divisor or quotient and must fit in a packed monomial
+        if (2 * options.degree > maxPackedDegree(options.numVariables))
+        {
+            cerr << "The degree of a monomial in " << options.numVariables << " variables is at most "
+                << maxPackedDegree(options.numVariables) << "; use --degree "
+                << maxPackedDegree(options.numVariables) / 2 << " or less" << endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// returns a random polynomial with numTerms terms whose degree is less than or equal to maxDegree
+// and whose exponents are not less than minExpon; if maxGap > 0, consecutive exponents differ by
+// at most maxGap and maxDegree is ignored
+vector< Term > randomPolynomial(mt19937_64& engine, const Options& options,
+    int numTerms, int minExpon, int maxDegree, int maxGap)
+{
+    vector< Term > polynomial(numTerms);
+    if (numTerms == 0)
+        return polynomial;
+
+    uniform_int_distribution< int > coefficient(1, options.coefRange);
+    vector< int > exponent(numTerms);
+
+    if (maxGap > 0)
+    {
+        // consecutive exponents differ by 1 ... maxGap, starting from the lowest one
+        uniform_int_distribution< int > gap(1, maxGap);
+        int expon = minExpon + gap(engine) - 1;
+        for (int i = numTerms - 1; i >= 0; i--)
+        {
+            exponent[i] = expon;
+            expon += gap(engine);
+        }
+    }
+    else
+    {
+        // numTerms distinct exponents chosen uniformly from [ minExpon, maxDegree ] (Floyd's algorithm)
+        int range = maxDegree - minExpon + 1;
+        vector< int > chosen;
+        vector< bool > used(range);
+        chosen.reserve(numTerms);
+        for (int j = range - numTerms; j < range; j++)
+        {
+            int candidate = uniform_int_distribution< int >(0, j)(engine);
+            if (used[candidate])
+                candidate = j;
+            used[candidate] = true;
+            chosen.push_back(candidate);
+        }
+
+        sort(chosen.begin(), chosen.end(), [](int a, int b) { return a > b; });
+        for (int i = 0; i < numTerms; i++)
+            exponent[i] = minExpon + chosen[i];
+    }
+
+    for (int i = 0; i < numTerms; i++)
+    {
+        polynomial[i].coef = coefficient(engine);
+        if (engine() & 1)
+            polynomial[i].coef = -polynomial[i].coef;
+        polynomial[i].expon = exponent[i];
+    }
+
+    return polynomial;
+}
+
+// dividend = divisor * quotient + remainder;
+// returns false if a coefficient of dividend does not fit in an int
+bool compose(const vector< Term >& divisor, const vector< Term >& quotient,
+    const vector< Term >& remainder, vector< Term >& dividend)
+{
+    struct Product
+    {
+        long long coef;
+        long long expon;
+    };
+
+    vector< Product > products;
+    products.reserve(divisor.size() * quotient.size() + remainder.size());
+
+    for (size_t i = 0; i < divisor.size(); i++)
+        for (size_t j = 0; j < quotient.size(); j++)
+            products.push_back({ static_cast< long long >(divisor[i].coef) * quotient[j].coef,
+                static_cast< long long >(divisor[i].expon) + quotient[j].expon });
+
+    for (size_t i = 0; i < remainder.size(); i++)
+        products.push_back({ remainder[i].coef, remainder[i].expon });
+
+    sort(products.begin(), products.end(),
+        [](const Product& a, const Product& b) { return a.expon > b.expon; });
+
+    dividend.clear();
+    for (size_t i = 0; i < products.size(); )
+    {
+        long long expon = products[i].expon;
+        long long coef = 0;
+        for (; i < products.size() && products[i].expon == expon; i++)
+            coef += products[i].coef;
+
+        if (coef == 0)
+            continue;
+        if (coef > INT_MAX || coef < -INT_MAX || expon > INT_MAX)
+            return false;
+
+        Term term;
+        term.coef = static_cast< int >(coef);
+        term.expon = static_cast< int >(expon);
+        dividend.push_back(term);
+    }
+
+    // the leading term of divisor * quotient never cancels, so the dividend is nonzero
+    return true;
+}
+
+
+// returns true if and only if exponent vector a precedes b in descending graded lexicographic order
+bool gradedGreater(const vector< int >& a, const vector< int >& b)
+{
+    int degreeA = 0;
+    int degreeB = 0;
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        degreeA += a[i];
+        degreeB += b[i];
+    }
+
+    if (degreeA != degreeB)
+        return degreeA > degreeB;
+    return a > b;
+}
+
+// returns a random polynomial in options.numVariables variables with at most numTerms terms
+// of total degree at most maxDegree, in descending graded order; if leadingMonomial is not
+// nullptr, no term is divisible by it
+vector< VectorTerm > randomMultivariate(mt19937_64& engine, const Options& options,
+    int numTerms, int maxDegree, const vector< int >* leadingMonomial)
+{
+    int numVariables = options.numVariables;
+    uniform_int_distribution< int > coefficient(1, options.coefRange);
+
+    map< vector< int >, int, bool (*)(const vector< int >&, const vector< int >&) > terms(gradedGreater);
+    for (int attempt = 0; attempt < maxAttempts && static_cast< int >(terms.size()) < numTerms; attempt++)
+    {
+        // a total degree, split among the variables at numVariables - 1 random cuts
+        int degree = uniform_int_distribution< int >(0, maxDegree)(engine);
+        vector< int > cut(numVariables + 1);
+        for (int i = 1; i < numVariables; i++)
+            cut[i] = uniform_int_distribution< int >(0, degree)(engine);
+        cut[numVariables] = degree;
+        sort(cut.begin(), cut.end());
+
+        vector< int > expon(numVariables);
+        for (int i = 0; i < numVariables; i++)
+            expon[i] = cut[i + 1] - cut[i];
+
+        if (leadingMonomial != nullptr)
+        {
+            bool divisible = true;
+            for (int i = 0; i < numVariables; i++)
+                if (expon[i] < (*leadingMonomial)[i])
+                    divisible = false;
+            if (divisible)
+                continue;
+        }
+
+        int coef = coefficient(engine);
+        terms[expon] = engine() & 1 ? -coef : coef;
+    }
+
+    vector< VectorTerm > polynomial;
+    for (auto term = terms.begin(); term != terms.end(); ++term)
+    {
+        VectorTerm vectorTerm;
+        vectorTerm.coef = term->second;
+        vectorTerm.expon = term->first;
+        polynomial.push_back(vectorTerm);
+    }
+
+    return polynomial;
+}
+
+// dividend = divisor * quotient + remainder for multivariate polynomials;
+// returns false if a coefficient of dividend does not fit in an int
+bool composeMultivariate(const vector< VectorTerm >& divisor, const vector< VectorTerm >& quotient,
+    const vector< VectorTerm >& remainder, vector< VectorTerm >& dividend)
+{
+    map< vector< int >, long long, bool (*)(const vector< int >&, const vector< int >&) > sums(gradedGreater);
+
+    for (size_t i = 0; i < divisor.size(); i++)
+        for (size_t j = 0; j < quotient.size(); j++)
+        {
+            vector< int > expon(divisor[i].expon.size());
+            for (size_t k = 0; k < expon.size(); k++)
+                expon[k] = divisor[i].expon[k] + quotient[j].expon[k];
+            sums[expon] += static_cast< long long >(divisor[i].coef) * quotient[j].coef;
+        }
+
+    for (size_t i = 0; i < remainder.size(); i++)
+        sums[remainder[i].expon] += remainder[i].coef;
+
+    dividend.clear();
+    for (auto sum = sums.begin(); sum != sums.end(); ++sum)
+    {
+        if (sum->second == 0)
+            continue;
+        if (sum->second > INT_MAX || sum->second < -INT_MAX)
+            return false;
+
+        VectorTerm term;
+        term.coef = static_cast< int >(sum->second);
+        term.expon = sum->first;
+        dividend.push_back(term);
+    }
+
+    return true;
+}
+
+// writes options.numPairs multivariate pairs to options.scalableFile; returns the exit code
+int generateMultivariate(const Options& options)
+{
+    ofstream scalableFile(options.scalableFile, ios::out | ios::binary);
+    if (!scalableFile)
+    {
+        cerr << "File could not be opened" << endl;
+        return 1;
+    }
+
+    writeMultivariateHeader(scalableFile, options.numPairs, options.numVariables);
+
+    mt19937_64 engine(options.seed);
+    vector< VectorTerm > dividend;
+    long long totalDividendTerms = 0;
+
+    for (int i = 0; i < options.numPairs; i++)
+    {
+        vector< VectorTerm > divisor;
+        vector< VectorTerm > quotient;
+        vector< VectorTerm > remainder;
+
+        int attempt = 0;
+        for (; attempt < maxAttempts; attempt++)
+        {
+            divisor = randomMultivariate(engine, options, options.divisorTerms, options.degree, nullptr);
+            quotient = randomMultivariate(engine, options, options.quotientTerms, options.degree, nullptr);
+
+            // no term of the remainder is divisible by the leading term of the divisor
+            int remainderTerms = uniform_int_distribution< int >(0, options.remainderTerms)(engine);
+            remainder = randomMultivariate(engine, options, remainderTerms, options.degree, &divisor[0].expon);
+
+            if (static_cast< int >(divisor.size()) == options.divisorTerms &&
+                static_cast< int >(quotient.size()) == options.quotientTerms &&
+                composeMultivariate(divisor, quotient, remainder, dividend))
+                break;
+        }
+
+        if (attempt == maxAttempts)
+        {
+            cerr << "Could not generate pair " << i << "; try fewer terms or a higher degree" << endl;
+            return 1;
+        }
+
+        totalDividendTerms += dividend.size();
+
+        const vector< VectorTerm >* polynomials[2] = { &dividend, &divisor };
+        for (int p = 0; p < 2; p++)
+        {
+            vector< int > coefficients;
+            vector< int > exponents;
+            for (size_t t = 0; t < polynomials[p]->size(); t++)
+            {
+                coefficients.push_back((*polynomials[p])[t].coef);
+                exponents.insert(exponents.end(), (*polynomials[p])[t].expon.begin(), (*polynomials[p])[t].expon.end());
+            }
+            writeMultivariate(scalableFile, coefficients, exponents);
+        }
+    }
+
+    cout << options.numPairs << " pairs written, " << totalDividendTerms / (options.numPairs > 0 ? options.numPairs : 1)
+        << " dividend terms on average" << endl;
+    return 0;
+}
\ No newline at end of file
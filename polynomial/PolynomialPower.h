@@ -0,0 +1,403 @@
+// PolynomialPower.h
+// Powers p^k and compositions p( q( x ) ) of sparse polynomials.
+//
+// A PowerLadder keeps the squares p, p^2, p^4, ... of its base, and p^k is the product of the
+// squares for the bits set in k, so p^k costs about log k products instead of k. A ladder also
+// remembers the powers it has built, and a composition asks one ladder for every gap between
+// the exponents of the outer polynomial.
+//
+// Squaring pays only when the terms of the powers combine: the product of two powers of n terms
+// takes n^2 products of terms, while k multiplications by p take k n t for a base of t terms.
+// A power of a base whose terms spread out stays sparse, and multiplying by p again and again is
+// then cheaper. So the number of terms of every power is estimated, by the number of ways to
+// pick its factors and, in one variable, by the range of its exponents, and the way that takes
+// the fewest products of terms is chosen.
+//
+// The third way is the multinomial theorem: every term of ( a1 x^e1 + ... + at x^et )^k is
+// k! / ( i1! ... it! ) a1^i1 ... at^it x^( i1 e1 + ... + it et ) for i1 + ... + it = k,
+// so each of the C( k + t - 1, t - 1 ) choices costs a product of precomputed factors and no
+// polynomial is multiplied at all. It is the fast way for a sparse base of few terms.
+//
+// A composition runs Horner's rule over the terms of the outer polynomial,
+// p( q ) = ( ... ( c0 q^( e0 - e1 ) + c1 ) q^( e1 - e2 ) + ... ) q^em, with the products by the
+// kernels of sparseMultiplication.
+//
+// The dense layout of hw6, the coefficient of x^i at position i, is converted to terms and back.
+
+#ifndef POLYNOMIAL_POWER_H
+#define POLYNOMIAL_POWER_H
+
+#include <algorithm>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "SparseMultiplication.h"
+
+// the cost of one choice of the multinomial theorem, in products of terms by the kernels
+const double multinomialChoiceCost = 8;
+
+// the cost of a product of terms of two powers relative to one of a power and the base, whose
+// coefficients are smaller and which the kernels merge faster
+const double powerProductCost = 1.5;
+
+// returns a function that appends the terms it is called with to polynomial
+template< typename TermType >
+auto appendTerms(std::vector< TermType >& polynomial)
+{
+    return [&polynomial](const auto& coef, const auto& expon)
+    {
+        TermType term;
+        term.coef = coef;
+        term.expon = expon;
+        polynomial.push_back(term);
+    };
+}
+
+// returns multiplicand * multiplier
+template< typename TermType >
+std::vector< TermType > multiplyTerms(const std::vector< TermType >& multiplicand, const std::vector< TermType >& multiplier)
+{
+    std::vector< TermType > product;
+    sparseMultiplication(termLayout(multiplicand), termLayout(multiplier), appendTerms(product));
+    return product;
+}
+
+// returns the constant polynomial 1
+template< typename TermType >
+std::vector< TermType > unitPolynomial()
+{
+    typedef decltype(TermType::coef) Coef;
+    typedef decltype(TermType::expon) Expon;
+
+    TermType one;
+    one.coef = Coef(1);
+    one.expon = Expon();
+    return std::vector< TermType >(1, one);
+}
+
+// returns an estimate of the number of terms of polynomial * base^exponent, for nonempty
+// polynomial and base: at most one for every term of polynomial and choice of exponent terms
+// of base, and in one variable at most one for every exponent in the range of the product
+template< typename TermType >
+double productTerms(const std::vector< TermType >& polynomial, const std::vector< TermType >& base, int exponent)
+{
+    double terms = static_cast< double >(polynomial.size());
+    for (size_t i = 1; i < base.size(); i++)
+        terms = terms * (exponent + i) / i;
+
+    if constexpr (std::is_arithmetic< decltype(TermType::expon) >::value)
+    {
+        double range = static_cast< double >(polynomial.front().expon - polynomial.back().expon)
+            + static_cast< double >(base.front().expon - base.back().expon) * exponent + 1;
+        terms = std::min(terms, range);
+    }
+
+    return terms;
+}
+
+// the powers of one nonempty base, built by repeated squaring
+template< typename TermType >
+class PowerLadder
+{
+public:
+    explicit PowerLadder(const std::vector< TermType >& base)
+        : squares(1, base), unit(unitPolynomial< TermType >())
+    {
+    }
+
+    // returns base^exponent, provided that exponent >= 0
+    const std::vector< TermType >& power(int exponent)
+    {
+        typename std::unordered_map< int, std::vector< TermType > >::iterator known = powers.find(exponent);
+        if (known != powers.end())
+            return known->second;
+
+        std::vector< TermType > result;
+        bool started = false;
+        for (int bit = 0; (exponent >> bit) != 0; bit++)
+        {
+            if (bit == static_cast< int >(squares.size()))
+                squares.push_back(multiplyTerms(squares.back(), squares.back()));
+
+            if ((exponent >> bit) & 1)
+            {
+                result = started ? multiplyTerms(result, squares[bit]) : squares[bit];
+                started = true;
+            }
+        }
+
+        if (!started)
+            result = unit;
+
+        return powers[exponent] = result;
+    }
+
+    // polynomial = polynomial * base^exponent, either by one product with base^exponent or by
+    // exponent products with base, whichever is estimated to take fewer products of terms
+    void multiplyByPower(std::vector< TermType >& polynomial, int exponent)
+    {
+        if (polynomial.empty() || exponent == 0)
+            return;
+
+        if (powerCost(polynomial, exponent) < stepCost(polynomial, exponent))
+            polynomial = multiplyTerms(polynomial, power(exponent));
+        else
+            for (int i = 0; i < exponent; i++)
+                polynomial = multiplyTerms(polynomial, squares[0]);
+    }
+
+    // returns an estimate of the products of terms that polynomial * power( exponent ) takes,
+    // for a nonempty polynomial
+    double powerCost(const std::vector< TermType >& polynomial, int exponent) const
+    {
+        double cost = polynomial.size() * productTerms(unit, squares[0], exponent);
+        if (powers.find(exponent) == powers.end())
+            cost += squaringCost(exponent);
+        return cost * powerProductCost;
+    }
+
+    // returns an estimate of the products of terms that exponent multiplications of a nonempty
+    // polynomial by base take
+    double stepCost(const std::vector< TermType >& polynomial, int exponent) const
+    {
+        double cost = 0;
+        for (int i = 0; i < exponent; i++)
+            cost += productTerms(polynomial, squares[0], i) * squares[0].size();
+        return cost;
+    }
+
+    // returns an estimate of the products of terms that power( exponent ) takes
+    double squaringCost(int exponent) const
+    {
+        const std::vector< TermType >& base = squares[0];
+        double cost = 0;
+        int done = 0; // the sum of the squares multiplied into the result so far
+        for (int bit = 0; (exponent >> bit) != 0; bit++)
+        {
+            if (bit >= static_cast< int >(squares.size()))
+            {
+                double half = productTerms(unit, base, 1 << (bit - 1));
+                cost += half * half;
+            }
+
+            if ((exponent >> bit) & 1)
+            {
+                if (done != 0)
+                    cost += productTerms(unit, base, done) * productTerms(unit, base, 1 << bit);
+                done += 1 << bit;
+            }
+        }
+
+        return cost;
+    }
+
+private:
+    std::vector< std::vector< TermType > > squares; // squares[ i ] = base^( 2^i )
+    std::vector< TermType > unit;                   // the constant polynomial 1
+    std::unordered_map< int, std::vector< TermType > > powers;
+};
+
+// returns base^exponent by the multinomial theorem, provided that base is nonempty and exponent >= 1
+template< typename TermType >
+std::vector< TermType > multinomialPower(const std::vector< TermType >& base, int exponent)
+{
+    typedef typename std::remove_cv< decltype(TermType::coef) >::type Coef;
+    typedef typename std::remove_cv< decltype(TermType::expon) >::type Expon;
+
+    int numTerms = static_cast< int >(base.size());
+
+    // binomial[ n ][ r ] = C( n, r ); coefPowers[ j ][ i ] = a_j^i; exponMultiples[ j ][ i ] = i e_j
+    std::vector< std::vector< Coef > > binomial(exponent + 1);
+    for (int n = 0; n <= exponent; n++)
+    {
+        binomial[n].assign(n + 1, Coef(1));
+        for (int r = 1; r < n; r++)
+            binomial[n][r] = binomial[n - 1][r - 1] + binomial[n - 1][r];
+    }
+
+    std::vector< std::vector< Coef > > coefPowers(numTerms, std::vector< Coef >(exponent + 1, Coef(1)));
+    std::vector< std::vector< Expon > > exponMultiples(numTerms, std::vector< Expon >(exponent + 1, Expon()));
+    for (int j = 0; j < numTerms; j++)
+        for (int i = 1; i <= exponent; i++)
+        {
+            coefPowers[j][i] = coefPowers[j][i - 1] * base[j].coef;
+            exponMultiples[j][i] = exponMultiples[j][i - 1] + base[j].expon;
+        }
+
+    // every i1 + ... + it = exponent; term j takes i of the remaining powers, with the factor
+    // C( remaining, i ) of the multinomial coefficient
+    std::vector< TermType > terms;
+    std::vector< int > taken(numTerms, 0);
+    std::vector< Coef > coefs(numTerms + 1, Coef(1));
+    std::vector< Expon > expons(numTerms + 1, Expon());
+    int j = 0;
+    int remaining = exponent;
+    taken[0] = exponent + 1;
+    while (j >= 0)
+    {
+        // the next choice for term j, or back to term j - 1 when there is none
+        if (taken[j] == 0)
+        {
+            j--;
+            if (j >= 0)
+                remaining += taken[j];
+            continue;
+        }
+
+        int i = --taken[j];
+        if (j == numTerms - 1 && i != remaining)
+            continue;
+
+        coefs[j + 1] = coefs[j] * binomial[remaining][i] * coefPowers[j][i];
+        expons[j + 1] = expons[j] + exponMultiples[j][i];
+
+        if (j == numTerms - 1)
+        {
+            TermType term;
+            term.coef = coefs[j + 1];
+            term.expon = expons[j + 1];
+            terms.push_back(term);
+            taken[j] = 0;
+            continue;
+        }
+
+        remaining -= i;
+        j++;
+        taken[j] = remaining + 1;
+    }
+
+    // terms of equal exponents are added
+    std::sort(terms.begin(), terms.end(),
+        [](const TermType& term1, const TermType& term2) { return term1.expon > term2.expon; });
+
+    std::vector< TermType > result;
+    for (size_t k = 0; k < terms.size(); k++)
+    {
+        if (!result.empty() && result.back().expon == terms[k].expon)
+        {
+            result.back().coef = result.back().coef + terms[k].coef;
+            if (result.back().coef == Coef())
+                result.pop_back();
+        }
+        else if (terms[k].coef != Coef())
+            result.push_back(terms[k]);
+    }
+
+    return result;
+}
+
+// returns base^exponent, provided that exponent >= 0
+template< typename TermType >
+std::vector< TermType > polynomialPower(const std::vector< TermType >& base, int exponent)
+{
+    if (exponent == 0)
+        return unitPolynomial< TermType >();
+    if (base.empty() || exponent == 1)
+        return base;
+
+    // the multinomial theorem makes a term for every choice, and sorts them; the ladder takes
+    // the cheaper of repeated squaring and repeated multiplication
+    PowerLadder< TermType > ladder(base);
+    std::vector< TermType > result = base;
+    double choices = 1;
+    for (size_t i = 1; i < base.size(); i++)
+        choices = choices * (exponent + i) / i;
+
+    double ladderCost = std::min(ladder.powerCost(base, exponent - 1), ladder.stepCost(base, exponent - 1));
+    if (multinomialChoiceCost * choices < ladderCost)
+        return multinomialPower(base, exponent);
+
+    ladder.multiplyByPower(result, exponent - 1);
+    return result;
+}
+
+// returns outer( inner( x ) ) for polynomials in one variable with exponents >= 0
+template< typename TermType >
+std::vector< TermType > polynomialComposition(const std::vector< TermType >& outer, const std::vector< TermType >& inner)
+{
+    typedef typename std::remove_cv< decltype(TermType::coef) >::type Coef;
+
+    std::vector< TermType > result;
+    if (outer.empty())
+        return result;
+
+    PowerLadder< TermType > ladder(inner.empty() ? unitPolynomial< TermType >() : inner);
+    result.push_back(outer[0]);
+    result.back().expon = 0;
+
+    for (size_t i = 0; i < outer.size(); i++)
+    {
+        // result = result * inner^gap + c, where c is the coefficient of the next outer term
+        int gap = outer[i].expon - (i + 1 < outer.size() ? outer[i + 1].expon : 0);
+        if (!inner.empty())
+            ladder.multiplyByPower(result, gap);
+        else if (gap > 0)
+            result.clear();
+
+        if (i + 1 < outer.size())
+        {
+            const Coef& coef = outer[i + 1].coef;
+            if (!result.empty() && result.back().expon == 0)
+            {
+                result.back().coef = result.back().coef + coef;
+                if (result.back().coef == Coef())
+                    result.pop_back();
+            }
+            else
+            {
+                TermType term;
+                term.coef = coef;
+                term.expon = 0;
+                result.push_back(term);
+            }
+        }
+    }
+
+    return result;
+}
+
+// the term of a dense polynomial
+template< typename Coef >
+struct DenseTerm
+{
+    Coef coef;
+    int expon;
+};
+
+// returns the terms of the dense polynomial[ 0 .. degree ], in descending order of exponents
+template< typename Coef >
+std::vector< DenseTerm< Coef > > denseTerms(const Coef* polynomial, int degree)
+{
+    std::vector< DenseTerm< Coef > > terms;
+    for (int i = degree; i >= 0; i--)
+        if (polynomial[i] != Coef())
+            terms.push_back(DenseTerm< Coef >{ polynomial[i], i });
+    return terms;
+}
+
+// returns the dense coefficients of terms, without leading zeroes ( { 0 } for the zero polynomial )
+template< typename Coef >
+std::vector< Coef > denseCoefficients(const std::vector< DenseTerm< Coef > >& terms)
+{
+    std::vector< Coef > polynomial(terms.empty() ? 1 : terms[0].expon + 1, Coef());
+    for (size_t i = 0; i < terms.size(); i++)
+        polynomial[terms[i].expon] = terms[i].coef;
+    return polynomial;
+}
+
+// returns polynomial^exponent for the dense polynomial[ 0 .. degree ]
+template< typename Coef >
+std::vector< Coef > densePower(const Coef* polynomial, int degree, int exponent)
+{
+    return denseCoefficients(polynomialPower(denseTerms(polynomial, degree), exponent));
+}
+
+// returns outer( inner( x ) ) for the dense outer[ 0 .. outerDegree ] and inner[ 0 .. innerDegree ]
+template< typename Coef >
+std::vector< Coef > denseComposition(const Coef* outer, int outerDegree, const Coef* inner, int innerDegree)
+{
+    return denseCoefficients(polynomialComposition(denseTerms(outer, outerDegree), denseTerms(inner, innerDegree)));
+}
+
+#endif
@@ -0,0 +1,250 @@
+// PolynomialStore.h
+// Hash-consed polynomials with memoized products and quotients.
+//
+// A PolynomialStore keeps every distinct polynomial once, together with a 64-bit hash of its
+// terms computed when it is interned. A polynomial is referred to by the address of its
+// stored copy, so two handles are equal exactly when the polynomials are, and comparing them
+// is one pointer comparison. Stored polynomials are never moved or freed before the store.
+//
+// Products and quotients are remembered in a fixed-size cache keyed by ( operation, lhs, rhs ):
+// a two-way set-associative table indexed by the hashes of the operands, in which a new result
+// replaces the less recently used entry of its set, so that two keys sharing a set do not keep
+// evicting each other. Sums are interned but not cached, since adding costs no more than
+// hashing the result. The counters tell how often interning found an existing polynomial and
+// how often the cache answered.
+
+#ifndef POLYNOMIAL_STORE_H
+#define POLYNOMIAL_STORE_H
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "SparseAddition.h"
+#include "SparseMultiplication.h"
+#include "HeapDivision.h"
+
+// mixes the bits of a 64-bit value ( the finalizer of splitmix64 )
+inline uint64_t mixBits(uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return value;
+}
+
+// the hash of a coefficient or an exponent; other types provide an overload found by ADL
+inline uint64_t hashValue(int value)
+{
+    return mixBits(static_cast< uint64_t >(static_cast< long long >(value)));
+}
+
+inline uint64_t hashValue(long long value)
+{
+    return mixBits(static_cast< uint64_t >(value));
+}
+
+// the counters of a PolynomialStore
+struct StoreStatistics
+{
+    long long internHits = 0;     // polynomials that were stored already
+    long long internMisses = 0;   // polynomials stored anew
+    long long cacheHits = 0;      // products and quotients found in the cache
+    long long cacheMisses = 0;    // products and quotients computed
+    long long cacheEvictions = 0; // cached results replaced by others
+
+    double internHitRate() const
+    {
+        return internHits + internMisses == 0 ? 0.0 : static_cast< double >(internHits) / (internHits + internMisses);
+    }
+
+    double cacheHitRate() const
+    {
+        return cacheHits + cacheMisses == 0 ? 0.0 : static_cast< double >(cacheHits) / (cacheHits + cacheMisses);
+    }
+};
+
+// the number of cache slots of a store unless given
+const int defaultCacheSlots = 1 << 12;
+
+template< typename TermType >
+class PolynomialStore
+{
+public:
+    // a stored polynomial
+    struct Node
+    {
+        std::vector< TermType > terms; // in descending order of exponents, without zero terms
+        uint64_t hash;
+    };
+
+    typedef const Node* Polynomial;
+
+    // the cache has cacheSlots slots, rounded up to a power of two of at least 2
+    explicit PolynomialStore(int cacheSlots = defaultCacheSlots)
+    {
+        size_t size = 2;
+        while (size < static_cast< size_t >(cacheSlots))
+            size *= 2;
+        cache.assign(size, CacheEntry());
+    }
+
+    PolynomialStore(const PolynomialStore&) = delete;
+    PolynomialStore& operator=(const PolynomialStore&) = delete;
+
+    // returns the stored copy of terms, storing it if it is new
+    Polynomial intern(std::vector< TermType > terms)
+    {
+        uint64_t hash = hashTerms(terms);
+
+        std::vector< Node* >& bucket = buckets[hash];
+        for (size_t i = 0; i < bucket.size(); i++)
+            if (sameTerms(bucket[i]->terms, terms))
+            {
+                statistics.internHits++;
+                return bucket[i];
+            }
+
+        statistics.internMisses++;
+        nodes.push_back(Node{ std::move(terms), hash });
+        bucket.push_back(&nodes.back());
+        return &nodes.back();
+    }
+
+    // returns augend + addend
+    Polynomial add(Polynomial augend, Polynomial addend)
+    {
+        std::vector< TermType > sum;
+        sparseAddition(termLayout(augend->terms), termLayout(addend->terms), append(sum));
+        return intern(std::move(sum));
+    }
+
+    // returns multiplicand * multiplier
+    Polynomial multiply(Polynomial multiplicand, Polynomial multiplier)
+    {
+        CacheEntry& entry = lookup(MULTIPLY, multiplicand, multiplier);
+        if (entry.result != nullptr)
+            return entry.result;
+
+        std::vector< TermType > product;
+        sparseMultiplication(termLayout(multiplicand->terms), termLayout(multiplier->terms), append(product));
+        entry.result = intern(std::move(product));
+        return entry.result;
+    }
+
+    // quotient = dividend / divisor; remainder = dividend % divisor, provided that divisor != 0
+    void divide(Polynomial dividend, Polynomial divisor, Polynomial& quotient, Polynomial& remainder)
+    {
+        CacheEntry& entry = lookup(DIVIDE, dividend, divisor);
+        if (entry.result == nullptr)
+        {
+            std::vector< TermType > quotientTerms;
+            std::vector< TermType > remainderTerms;
+            heapDivision(termLayout(dividend->terms), termLayout(divisor->terms),
+                append(quotientTerms), append(remainderTerms));
+            entry.result = intern(std::move(quotientTerms));
+            entry.secondResult = intern(std::move(remainderTerms));
+        }
+
+        quotient = entry.result;
+        remainder = entry.secondResult;
+    }
+
+    const StoreStatistics& counters() const
+    {
+        return statistics;
+    }
+
+    // returns the number of distinct polynomials stored
+    size_t size() const
+    {
+        return nodes.size();
+    }
+
+private:
+    enum Operation { NONE, MULTIPLY, DIVIDE };
+
+    struct CacheEntry
+    {
+        Operation operation = NONE;
+        Polynomial lhs = nullptr;
+        Polynomial rhs = nullptr;
+        Polynomial result = nullptr;
+        Polynomial secondResult = nullptr; // the remainder of a division
+        long long lastUse = 0;             // the value of useCount when the entry was last used
+    };
+
+    static uint64_t hashTerms(const std::vector< TermType >& terms)
+    {
+        uint64_t hash = mixBits(terms.size());
+        for (size_t i = 0; i < terms.size(); i++)
+            hash = mixBits(hash ^ hashValue(terms[i].coef)) + hashValue(terms[i].expon);
+
+        return hash;
+    }
+
+    static bool sameTerms(const std::vector< TermType >& terms1, const std::vector< TermType >& terms2)
+    {
+        if (terms1.size() != terms2.size())
+            return false;
+
+        for (size_t i = 0; i < terms1.size(); i++)
+            if (terms1[i].coef != terms2[i].coef || terms1[i].expon != terms2[i].expon)
+                return false;
+
+        return true;
+    }
+
+    // returns a function that appends the terms it is called with to terms
+    static auto append(std::vector< TermType >& terms)
+    {
+        return [&terms](const auto& coef, const auto& expon)
+        {
+            TermType term;
+            term.coef = coef;
+            term.expon = expon;
+            terms.push_back(term);
+        };
+    }
+
+    // returns the entry of ( operation, lhs, rhs ); its result is null unless it was cached,
+    // in which case an entry is taken over for the result about to be computed
+    CacheEntry& lookup(Operation operation, Polynomial lhs, Polynomial rhs)
+    {
+        uint64_t hash = mixBits(lhs->hash * 31 + rhs->hash + static_cast< uint64_t >(operation));
+        CacheEntry* set = &cache[(hash * 2) & (cache.size() - 1)];
+        useCount++;
+
+        for (int way = 0; way < 2; way++)
+            if (set[way].operation == operation && set[way].lhs == lhs && set[way].rhs == rhs)
+            {
+                statistics.cacheHits++;
+                set[way].lastUse = useCount;
+                return set[way];
+            }
+
+        statistics.cacheMisses++;
+        CacheEntry& entry = set[0].lastUse <= set[1].lastUse ? set[0] : set[1];
+        if (entry.operation != NONE)
+            statistics.cacheEvictions++;
+
+        entry = CacheEntry();
+        entry.operation = operation;
+        entry.lhs = lhs;
+        entry.rhs = rhs;
+        entry.lastUse = useCount;
+        return entry;
+    }
+
+    std::deque< Node > nodes; // a deque never moves its elements when it grows
+    std::unordered_map< uint64_t, std::vector< Node* > > buckets;
+    std::vector< CacheEntry > cache; // sets of two entries
+    long long useCount = 0;
+    StoreStatistics statistics;
+};
+
+#endif
@@ -0,0 +1,234 @@
+// Times powers and compositions of the divisors of a workload
+//
+// Every divisor is raised to the given power by repeated multiplication, by repeated squaring
+// and by polynomialPower, which chooses between them and the multinomial theorem. Every divisor
+// is composed with the next one, if the result is small enough, by summing c_i q^e_i and by
+// Horner's rule, and powers and compositions are computed again in the dense layout of hw6.
+// The coefficients are Coefficients, so that large powers do not overflow, and all results are
+// checked against repeated multiplication.
+//
+// usage: PowerBenchmark file [exponent [numPolynomials]]
+//   file            a workload in any layout of PolynomialFile.h ( see PolynomialGenerator.cpp )
+//   exponent        the power the divisors are raised to (16)
+//   numPolynomials  the number of divisors used, at most (200)
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <iomanip>
+using std::setw;
+using std::fixed;
+using std::setprecision;
+
+#include <vector>
+using std::vector;
+
+#include <chrono>
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+#include <cstdlib>
+
+#include "Coefficient.h"
+#include "PolynomialFile.h"
+#include "PolynomialPower.h"
+#include "SparseAddition.h"
+
+struct Term
+{
+    int coef = 0;  // the coefficient of a term
+    int expon = 0; // the exponent of a term
+};
+
+struct BigTerm
+{
+    Coefficient coef; // the coefficient of a term
+    int expon = 0;    // the exponent of a term
+};
+
+// returns true if and only if polynomial1 == polynomial2
+template< typename TermType1, typename TermType2 >
+bool equal(const vector< TermType1 >& polynomial1, const vector< TermType2 >& polynomial2);
+
+// returns the dense coefficients of polynomial
+vector< Coefficient > dense(const vector< BigTerm >& polynomial);
+
+// returns true if and only if outer( inner( x ) ) has a degree of at most maxCompositionDegree
+bool composable(const vector< BigTerm >& outer, const vector< BigTerm >& inner);
+
+// the largest degree of a power computed in the dense layout
+const int maxDenseDegree = 1 << 16;
+
+// the largest degree of a composition
+const int maxCompositionDegree = 1 << 12;
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "usage: PowerBenchmark file [exponent [numPolynomials]]" << endl;
+        return 1;
+    }
+
+    int exponent = argc > 2 ? atoi(argv[2]) : 16;
+    size_t numPolynomials = argc > 3 ? atoi(argv[3]) : 200;
+
+    vector< vector< Term > > dividends;
+    vector< vector< Term > > divisors;
+    if (!readWorkload(argv[1], dividends, divisors))
+    {
+        cerr << "File could not be opened" << endl;
+        return 1;
+    }
+
+    if (divisors.size() < numPolynomials)
+        numPolynomials = divisors.size();
+
+    vector< vector< BigTerm > > bases(numPolynomials);
+    for (size_t i = 0; i < numPolynomials; i++)
+        for (size_t j = 0; j < divisors[i].size(); j++)
+        {
+            BigTerm term;
+            term.coef = divisors[i][j].coef;
+            term.expon = divisors[i][j].expon;
+            bases[i].push_back(term);
+        }
+
+    cout << numPolynomials << " polynomials, exponent " << exponent << "\n\n";
+
+    // powers
+    vector< vector< BigTerm > > expected(numPolynomials);
+    steady_clock::time_point start = steady_clock::now();
+    for (size_t i = 0; i < numPolynomials; i++)
+    {
+        expected[i] = unitPolynomial< BigTerm >();
+        for (int k = 0; k < exponent; k++)
+            expected[i] = multiplyTerms(expected[i], bases[i]);
+    }
+    double repeatedSeconds = duration< double >(steady_clock::now() - start).count();
+
+    int numErrors = 0;
+    start = steady_clock::now();
+    for (size_t i = 0; i < numPolynomials; i++)
+    {
+        PowerLadder< BigTerm > ladder(bases[i]);
+        if (!equal(ladder.power(exponent), expected[i]))
+            numErrors++;
+    }
+    double squaringSeconds = duration< double >(steady_clock::now() - start).count();
+
+    start = steady_clock::now();
+    for (size_t i = 0; i < numPolynomials; i++)
+        if (!equal(polynomialPower(bases[i], exponent), expected[i]))
+            numErrors++;
+    double powerSeconds = duration< double >(steady_clock::now() - start).count();
+
+    start = steady_clock::now();
+    for (size_t i = 0; i < numPolynomials; i++)
+    {
+        int degree = bases[i].empty() ? 0 : bases[i][0].expon;
+        if (static_cast< long long >(degree) * exponent > maxDenseDegree)
+            continue;
+
+        vector< Coefficient > base = dense(bases[i]);
+        if (densePower(base.data(), degree, exponent) != dense(expected[i]))
+            numErrors++;
+    }
+    double densePowerSeconds = duration< double >(steady_clock::now() - start).count();
+
+    // compositions of every divisor with the next one, unless the result is too large
+    vector< vector< BigTerm > > compositions(numPolynomials);
+    start = steady_clock::now();
+    for (size_t i = 0; i + 1 < numPolynomials; i++)
+    {
+        if (!composable(bases[i], bases[i + 1]))
+            continue;
+
+        const vector< BigTerm >& outer = bases[i];
+        const vector< BigTerm >& inner = bases[i + 1];
+
+        // inner^e for the exponents e of outer, in ascending order
+        vector< BigTerm > innerPower = unitPolynomial< BigTerm >();
+        int innerExpon = 0;
+        for (size_t j = outer.size(); j-- > 0; )
+        {
+            for (; innerExpon < outer[j].expon; innerExpon++)
+                innerPower = multiplyTerms(innerPower, inner);
+
+            vector< BigTerm > term(1, outer[j]);
+            term[0].expon = 0;
+            vector< BigTerm > sum;
+            sparseAddition(termLayout(compositions[i]), termLayout(multiplyTerms(innerPower, term)), appendTerms(sum));
+            compositions[i].swap(sum);
+        }
+    }
+    double summedSeconds = duration< double >(steady_clock::now() - start).count();
+
+    start = steady_clock::now();
+    for (size_t i = 0; i + 1 < numPolynomials; i++)
+        if (composable(bases[i], bases[i + 1]) && !equal(polynomialComposition(bases[i], bases[i + 1]), compositions[i]))
+            numErrors++;
+    double hornerSeconds = duration< double >(steady_clock::now() - start).count();
+
+    start = steady_clock::now();
+    for (size_t i = 0; i + 1 < numPolynomials; i++)
+    {
+        if (!composable(bases[i], bases[i + 1]))
+            continue;
+
+        int outerDegree = bases[i].empty() ? 0 : bases[i][0].expon;
+        int innerDegree = bases[i + 1].empty() ? 0 : bases[i + 1][0].expon;
+
+        vector< Coefficient > outer = dense(bases[i]);
+        vector< Coefficient > inner = dense(bases[i + 1]);
+        if (denseComposition(outer.data(), outerDegree, inner.data(), innerDegree) != dense(compositions[i]))
+            numErrors++;
+    }
+    double denseCompositionSeconds = duration< double >(steady_clock::now() - start).count();
+
+    cout << fixed << setprecision(4);
+    cout << setw(24) << "repeated multiplication" << setw(12) << repeatedSeconds << endl;
+    cout << setw(24) << "repeated squaring" << setw(12) << squaringSeconds << endl;
+    cout << setw(24) << "polynomialPower" << setw(12) << powerSeconds << endl;
+    cout << setw(24) << "densePower" << setw(12) << densePowerSeconds << endl;
+    cout << setw(24) << "summed composition" << setw(12) << summedSeconds << endl;
+    cout << setw(24) << "Horner composition" << setw(12) << hornerSeconds << endl;
+    cout << setw(24) << "denseComposition" << setw(12) << denseCompositionSeconds << endl;
+
+    cout << "\nThere are " << numErrors << " errors!\n";
+
+    return numErrors == 0 ? 0 : 1;
+}
+
+// returns true if and only if polynomial1 == polynomial2
+template< typename TermType1, typename TermType2 >
+bool equal(const vector< TermType1 >& polynomial1, const vector< TermType2 >& polynomial2)
+{
+    if (polynomial1.size() != polynomial2.size())
+        return false;
+
+    for (size_t i = 0; i < polynomial1.size(); i++)
+        if (polynomial1[i].coef != polynomial2[i].coef || polynomial1[i].expon != polynomial2[i].expon)
+            return false;
+
+    return true;
+}
+
+// returns the dense coefficients of polynomial
+vector< Coefficient > dense(const vector< BigTerm >& polynomial)
+{
+    vector< Coefficient > coefficients(polynomial.empty() ? 1 : polynomial[0].expon + 1);
+    for (size_t i = 0; i < polynomial.size(); i++)
+        coefficients[polynomial[i].expon] = polynomial[i].coef;
+    return coefficients;
+}
+
+// returns true if and only if outer( inner( x ) ) has a degree of at most maxCompositionDegree
+bool composable(const vector< BigTerm >& outer, const vector< BigTerm >& inner)
+{
+    long long outerDegree = outer.empty() ? 0 : outer[0].expon;
+    long long innerDegree = inner.empty() ? 0 : inner[0].expon;
+    return outerDegree * innerDegree <= maxCompositionDegree;
+}
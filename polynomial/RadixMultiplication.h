@@ -0,0 +1,184 @@
+// RadixMultiplication.h
+// Sparse polynomial multiplication by sorting all products.
+//
+// All n * m products are written to one flat buffer, each with a key that counts down from the
+// largest exponent of the product, so that ascending keys are descending exponents and the keys
+// need no more bits than the range of exponents of the product. An LSD radix sort on the key,
+// radixDigitBits bits per pass and only as many passes as the range needs, brings equal exponents
+// together, and one linear pass adds them up. Every pass reads and writes the buffer in order whatever the
+// exponents are, where the heap merge pays O( log n ) for every product and the probes of the
+// hash table miss the cache once the product has more terms than the cache holds.
+//
+// The products are generated and every pass is run on several threads: every thread counts the
+// digits of its slice of the buffer, the counts give every ( digit, thread ) its own range of the
+// output, and every thread scatters its slice into its ranges. The sort stays stable, so the
+// result does not depend on the number of threads.
+
+#ifndef RADIX_MULTIPLICATION_H
+#define RADIX_MULTIPLICATION_H
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// the buffers of radixMultiplication take at most this many bytes
+const long long radixMaxBytes = 1LL << 28;
+
+// buffers of at most this many bytes are kept for the next call on the same thread; larger ones
+// are freed before radixMultiplication returns
+const long long radixKeptBytes = 1LL << 22;
+
+// the number of bits sorted by every pass; a pass writes to 2^radixDigitBits places of the buffer
+// at once, and fewer passes pay off as long as those fit in the cache
+const int radixDigitBits = 12;
+
+// every thread of radixMultiplication gets at least this many products
+const long long radixMinProductsPerThread = 1LL << 16;
+
+// calls work( t ) for t = 0, 1, ..., numThreads - 1, each on its own thread;
+// work( 0 ) runs on the calling thread
+template< typename Work >
+void runOnThreads(int numThreads, Work work)
+{
+    std::vector< std::thread > threads;
+    for (int t = 1; t < numThreads; t++)
+        threads.emplace_back(work, t);
+    work(0);
+    for (size_t t = 0; t < threads.size(); t++)
+        threads[t].join();
+}
+
+// a product of two terms in the buffers of radixMultiplication
+template< typename Coef >
+struct RadixProduct
+{
+    unsigned key; // the largest exponent of the product minus the exponent of this one
+    Coef coef;
+};
+
+// returns the number of bytes of the buffers radixMultiplication needs for multiplicand * multiplier
+template< typename Layout1, typename Layout2 >
+long long radixBytes(const Layout1& multiplicand, const Layout2& multiplier)
+{
+    return 2LL * multiplicand.size * multiplier.size * sizeof(RadixProduct< typename Layout1::Coef >);
+}
+
+// calls emit( coef, expon ) for every term of multiplicand * multiplier,
+// in descending order of exponents, using numThreads threads, provided that the exponents are ints
+// and the exponents of the product span less than 2^32; emit is called on the calling thread only
+template< typename Layout1, typename Layout2, typename Emit >
+void radixMultiplication(const Layout1& multiplicand, const Layout2& multiplier, Emit emit, int numThreads = 1)
+{
+    typedef typename Layout1::Coef Coef;
+    typedef RadixProduct< Coef > Product;
+
+    if (multiplicand.size == 0 || multiplier.size == 0)
+        return;
+
+    size_t numProducts = static_cast< size_t >(multiplicand.size) * multiplier.size;
+    if (numThreads > static_cast< long long >(numProducts) / radixMinProductsPerThread)
+        numThreads = static_cast< int >(numProducts / radixMinProductsPerThread);
+    if (numThreads < 1)
+        numThreads = 1;
+
+    long long top = static_cast< long long >(multiplicand.expon(0)) + multiplier.expon(0);
+    long long range = top - multiplicand.expon(multiplicand.size - 1) - multiplier.expon(multiplier.size - 1);
+
+    // small buffers are reused by later calls on the same thread; the other threads reach them
+    // through these references, since a thread_local named in a lambda is the running thread's own
+    static thread_local std::vector< Product > productStorage;
+    static thread_local std::vector< Product > bufferStorage;
+    std::vector< Product >& products = productStorage;
+    std::vector< Product >& buffer = bufferStorage;
+    if (products.size() < numProducts)
+    {
+        products.resize(numProducts);
+        buffer.resize(numProducts);
+    }
+
+    // thread t multiplies the terms numTerms * t / numThreads .. numTerms * ( t + 1 ) / numThreads - 1
+    // of the multiplicand by the whole multiplier
+    runOnThreads(numThreads, [&](int t)
+    {
+        int first = static_cast< int >(static_cast< long long >(multiplicand.size) * t / numThreads);
+        int last = static_cast< int >(static_cast< long long >(multiplicand.size) * (t + 1) / numThreads);
+        for (int i = first; i < last; i++)
+        {
+            Coef coef = multiplicand.coef(i);
+            long long expon = top - multiplicand.expon(i);
+            Product* row = &products[static_cast< size_t >(i) * multiplier.size];
+            for (int j = 0; j < multiplier.size; j++)
+            {
+                row[j].key = static_cast< unsigned >(expon - multiplier.expon(j));
+                row[j].coef = coef * multiplier.coef(j);
+            }
+        }
+    });
+
+    // thread t sorts the products numProducts * t / numThreads .. numProducts * ( t + 1 ) / numThreads - 1;
+    // counts[ t * numDigits + digit ] is first the number of its products with digit, then where the next goes
+    const unsigned numDigits = 1u << radixDigitBits;
+    std::vector< size_t > counts(static_cast< size_t >(numThreads) * numDigits);
+    auto sliceBegin = [&](int t) { return numProducts * t / numThreads; };
+
+    for (int shift = 0; shift < 32 && (range >> shift) != 0; shift += radixDigitBits)
+    {
+        runOnThreads(numThreads, [&](int t)
+        {
+            size_t* count = &counts[static_cast< size_t >(t) * numDigits];
+            std::fill(count, count + numDigits, 0);
+            for (size_t i = sliceBegin(t); i < sliceBegin(t + 1); i++)
+                count[(products[i].key >> shift) & (numDigits - 1)]++;
+        });
+
+        // a pass in which all products share the digit changes nothing
+        size_t offset = 0;
+        bool trivial = false;
+        for (unsigned digit = 0; digit < numDigits; digit++)
+        {
+            size_t numWithDigit = 0;
+            for (int t = 0; t < numThreads; t++)
+            {
+                size_t count = counts[static_cast< size_t >(t) * numDigits + digit];
+                counts[static_cast< size_t >(t) * numDigits + digit] = offset + numWithDigit;
+                numWithDigit += count;
+            }
+
+            trivial = trivial || numWithDigit == numProducts;
+            offset += numWithDigit;
+        }
+        if (trivial)
+            continue;
+
+        runOnThreads(numThreads, [&](int t)
+        {
+            size_t* next = &counts[static_cast< size_t >(t) * numDigits];
+            for (size_t i = sliceBegin(t); i < sliceBegin(t + 1); i++)
+                buffer[next[(products[i].key >> shift) & (numDigits - 1)]++] = std::move(products[i]);
+        });
+
+        products.swap(buffer);
+    }
+
+    // products of equal exponents are now adjacent
+    for (size_t i = 0; i < numProducts; )
+    {
+        unsigned key = products[i].key;
+        Coef coef = std::move(products[i].coef);
+        for (i++; i < numProducts && products[i].key == key; i++)
+            coef += products[i].coef;
+
+        if (coef != Coef())
+            emit(coef, static_cast< int >(top - key));
+    }
+
+    // a thread that once multiplied a large product should not hold its buffers for good
+    if (static_cast< long long >((productStorage.capacity() + bufferStorage.capacity()) * sizeof(Product)) > radixKeptBytes)
+    {
+        std::vector< Product >().swap(productStorage);
+        std::vector< Product >().swap(bufferStorage);
+    }
+}
+
+#endif
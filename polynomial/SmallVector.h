@@ -0,0 +1,108 @@
+// SmallVector.h
+// A vector that keeps its first N elements inside the object.
+//
+// Short polynomials and the heaps of short operands fit in the inline storage,
+// so building them never calls the allocator; longer ones grow on the heap by doubling.
+// Elements are copied by assignment, which suits the plain structs used here.
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <cstddef>
+
+template< typename T, int N >
+class SmallVector
+{
+public:
+    SmallVector() = default;
+
+    SmallVector(const SmallVector& vector2)
+    {
+        *this = vector2;
+    }
+
+    ~SmallVector()
+    {
+        if (items != inlineItems)
+            delete[] items;
+    }
+
+    SmallVector& operator=(const SmallVector& vector2)
+    {
+        if (this != &vector2)
+        {
+            numItems = 0;
+            reserve(vector2.numItems);
+            for (int i = 0; i < vector2.numItems; i++)
+                items[i] = vector2.items[i];
+            numItems = vector2.numItems;
+        }
+
+        return *this;
+    }
+
+    // makes room for capacity elements, keeping the current ones
+    void reserve(int capacity)
+    {
+        if (capacity <= numAllocated)
+            return;
+
+        int newCapacity = 2 * numAllocated;
+        if (newCapacity < capacity)
+            newCapacity = capacity;
+
+        T* newItems = new T[newCapacity];
+        for (int i = 0; i < numItems; i++)
+            newItems[i] = items[i];
+
+        if (items != inlineItems)
+            delete[] items;
+        items = newItems;
+        numAllocated = newCapacity;
+    }
+
+    void push_back(const T& item)
+    {
+        if (numItems == numAllocated)
+            reserve(numItems + 1);
+        items[numItems++] = item;
+    }
+
+    void pop_back()
+    {
+        numItems--;
+    }
+
+    // removes all elements; the storage is kept for reuse
+    void clear()
+    {
+        numItems = 0;
+    }
+
+    size_t size() const
+    {
+        return static_cast< size_t >(numItems);
+    }
+
+    bool empty() const
+    {
+        return numItems == 0;
+    }
+
+    T& operator[](size_t i) { return items[i]; }
+    const T& operator[](size_t i) const { return items[i]; }
+
+    T& front() { return items[0]; }
+    const T& front() const { return items[0]; }
+
+    T& back() { return items[numItems - 1]; }
+    const T& back() const { return items[numItems - 1]; }
+
+private:
+    T inlineItems[N];
+    T* items = inlineItems;
+    int numItems = 0;
+    int numAllocated = N;
+};
+
+#endif
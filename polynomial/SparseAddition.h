@@ -0,0 +1,44 @@
+// SparseAddition.h
+// Sparse polynomial addition for any term layout.
+
+#ifndef SPARSE_ADDITION_H
+#define SPARSE_ADDITION_H
+
+// calls emit( coef, expon ) for every term of augend + addend, in descending order of exponents;
+// terms that cancel are skipped
+template< typename Layout1, typename Layout2, typename Emit >
+void sparseAddition(const Layout1& augend, const Layout2& addend, Emit emit)
+{
+    typedef typename Layout1::Coef Coef;
+
+    int i = 0;
+    int j = 0;
+    while (i < augend.size && j < addend.size)
+    {
+        if (augend.expon(i) > addend.expon(j))
+        {
+            emit(augend.coef(i), augend.expon(i));
+            i++;
+        }
+        else if (addend.expon(j) > augend.expon(i))
+        {
+            emit(addend.coef(j), addend.expon(j));
+            j++;
+        }
+        else
+        {
+            Coef coef = augend.coef(i) + addend.coef(j);
+            if (coef != Coef())
+                emit(coef, augend.expon(i));
+            i++;
+            j++;
+        }
+    }
+
+    for (; i < augend.size; i++)
+        emit(augend.coef(i), augend.expon(i));
+    for (; j < addend.size; j++)
+        emit(addend.coef(j), addend.expon(j));
+}
+
+#endif
@@ -0,0 +1,113 @@
+// SparseMultiplication.h
+// Chooses a sparse multiplication kernel from the expected density of the product,
+// and spreads large products over all cores.
+//
+// The hash kernel wins while many products fall on every output term and its table fits in
+// the cache; sorting all products wins once their exponents rarely meet or the table outgrows
+// the cache, as long as the products fit in memory; the heap merge takes the rest.
+
+#ifndef SPARSE_MULTIPLICATION_H
+#define SPARSE_MULTIPLICATION_H
+
+#include <type_traits>
+
+#include "HeapMultiplication.h"
+#include "HashMultiplication.h"
+#include "ParallelMultiplication.h"
+#include "RadixMultiplication.h"
+
+// below this many term products the heap merge is always used
+const long long hashMinProducts = 256;
+
+// the hash kernel is used when at least this many products fall on every output term on average
+const long long hashMinCollisions = 4;
+
+// from this many term products on, the product is computed on all cores
+const long long parallelMinProducts = 1LL << 22;
+
+// below this many term products the products are never sorted
+const long long radixMinProducts = 1LL << 14;
+
+// from this many possible output terms on, the products are sorted even if many fall on every
+// output term, since the table of the hash kernel no longer fits in the cache
+const long long radixMinTerms = 1LL << 19;
+
+// returns true if and only if multiplicand * multiplier is computed by sorting all term products
+template< typename Layout1, typename Layout2 >
+bool radixSuited(const Layout1& multiplicand, const Layout2& multiplier)
+{
+    // the keys of the sort are int exponents spanning less than 2^32
+    if constexpr (std::is_same< typename Layout1::Expon, int >::value)
+    {
+        long long numProducts = static_cast< long long >(multiplicand.size) * multiplier.size;
+        if (numProducts < radixMinProducts || radixBytes(multiplicand, multiplier) > radixMaxBytes)
+            return false;
+
+        long long span = static_cast< long long >(multiplicand.expon(0)) + multiplier.expon(0) -
+            multiplicand.expon(multiplicand.size - 1) - multiplier.expon(multiplier.size - 1) + 1;
+        long long bound = productSizeBound(multiplicand, multiplier);
+
+        return span <= 1LL << 32 && (numProducts < hashMinCollisions * bound || bound >= radixMinTerms);
+    }
+    else
+        return false;
+}
+
+// calls emit( coef, expon ) for every term of multiplicand * multiplier,
+// in descending order of exponents, on the calling thread only
+template< typename Layout1, typename Layout2, typename Emit >
+void sequentialMultiplication(const Layout1& multiplicand, const Layout2& multiplier, Emit emit)
+{
+    // the hash table is keyed by int exponents; packed monomials always use the heap
+    if constexpr (std::is_same< typename Layout1::Expon, int >::value)
+    {
+        long long numProducts = static_cast< long long >(multiplicand.size) * multiplier.size;
+        long long bound = productSizeBound(multiplicand, multiplier);
+
+        if (radixSuited(multiplicand, multiplier))
+        {
+            radixMultiplication(multiplicand, multiplier, emit);
+            return;
+        }
+
+        if (numProducts >= hashMinProducts && numProducts >= hashMinCollisions * bound)
+        {
+            hashMultiplication(multiplicand, multiplier, emit);
+            return;
+        }
+    }
+
+    heapMultiplication(multiplicand, multiplier, emit);
+}
+
+// calls emit( coef, expon ) for every term of multiplicand * multiplier,
+// in descending order of exponents
+template< typename Layout1, typename Layout2, typename Emit >
+void sparseMultiplication(const Layout1& multiplicand, const Layout2& multiplier, Emit emit)
+{
+    static const int numThreads = defaultThreadCount();
+
+    // the sort runs on as many threads as the products keep busy
+    if constexpr (std::is_same< typename Layout1::Expon, int >::value)
+    {
+        if (radixSuited(multiplicand, multiplier))
+        {
+            radixMultiplication(multiplicand, multiplier, emit, numThreads);
+            return;
+        }
+    }
+
+    if (numThreads > 1 && static_cast< long long >(multiplicand.size) * multiplier.size >= parallelMinProducts)
+    {
+        parallelMultiplication(multiplicand, multiplier, emit, numThreads,
+            [](const auto& block, const Layout2& factor, auto emitBlock)
+            {
+                sequentialMultiplication(block, factor, emitBlock);
+            });
+        return;
+    }
+
+    sequentialMultiplication(multiplicand, multiplier, emit);
+}
+
+#endif
@@ -0,0 +1,162 @@
+// Runs the verify loop of hw8 with plain term vectors and with a PolynomialStore
+//
+// For every pair the loop divides, multiplies the divisor by the quotient, adds the remainder and
+// checks the sum against the dividend. Repeating the loop recomputes the same sub-expressions,
+// which the store answers from its cache; its check is a pointer comparison instead of a walk
+// over both term arrays.
+//
+// usage: StoreBenchmark file [repetitions [cacheSlots]]
+//   file         a workload in any layout of PolynomialFile.h ( see PolynomialGenerator.cpp )
+//   repetitions  the number of times the loop runs (5)
+//   cacheSlots   the number of slots of the cache of products and quotients (4096)
+
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
+
+#include <iomanip>
+using std::setw;
+using std::fixed;
+using std::setprecision;
+
+#include <vector>
+using std::vector;
+
+#include <chrono>
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+#include <cstdlib>
+
+#include "PolynomialFile.h"
+#include "PolynomialStore.h"
+
+struct Term
+{
+    int coef = 0;  // the coefficient of a term
+    int expon = 0; // the exponent of a term
+};
+
+typedef PolynomialStore< Term > Store;
+
+// returns a function that appends the terms it is called with to polynomial
+auto append(vector< Term >& polynomial)
+{
+    return [&polynomial](int coef, int expon)
+    {
+        Term term;
+        term.coef = coef;
+        term.expon = expon;
+        polynomial.push_back(term);
+    };
+}
+
+// returns true if and only if polynomial1 == polynomial2
+bool equal(const vector< Term >& polynomial1, const vector< Term >& polynomial2);
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        cerr << "usage: StoreBenchmark file [repetitions [cacheSlots]]" << endl;
+        return 1;
+    }
+
+    int repetitions = argc > 2 ? atoi(argv[2]) : 5;
+    int cacheSlots = argc > 3 ? atoi(argv[3]) : defaultCacheSlots;
+
+    vector< vector< Term > > dividends;
+    vector< vector< Term > > divisors;
+    if (!readWorkload(argv[1], dividends, divisors))
+    {
+        cerr << "File could not be opened" << endl;
+        return 1;
+    }
+
+    size_t numPairs = dividends.size();
+    cout << numPairs << " pairs, " << repetitions << " repetitions, " << cacheSlots << " cache slots\n\n";
+
+    // plain term vectors
+    vector< vector< Term > > quotients(numPairs);
+    int numPlainErrors = 0;
+
+    steady_clock::time_point start = steady_clock::now();
+    for (int r = 0; r < repetitions; r++)
+        for (size_t i = 0; i < numPairs; i++)
+        {
+            vector< Term > remainder;
+            vector< Term > product;
+            vector< Term > sum;
+            quotients[i].clear();
+            heapDivision(termLayout(dividends[i]), termLayout(divisors[i]), append(quotients[i]), append(remainder));
+            sparseMultiplication(termLayout(divisors[i]), termLayout(quotients[i]), append(product));
+            sparseAddition(termLayout(product), termLayout(remainder), append(sum));
+            if (!equal(sum, dividends[i]))
+                numPlainErrors++;
+        }
+    double plainSeconds = duration< double >(steady_clock::now() - start).count();
+
+    // the store
+    Store store(cacheSlots);
+    vector< Store::Polynomial > dividendHandles(numPairs);
+    vector< Store::Polynomial > divisorHandles(numPairs);
+    vector< Store::Polynomial > quotientHandles(numPairs);
+    int numStoreErrors = 0;
+
+    start = steady_clock::now();
+    for (size_t i = 0; i < numPairs; i++)
+    {
+        dividendHandles[i] = store.intern(dividends[i]);
+        divisorHandles[i] = store.intern(divisors[i]);
+    }
+
+    for (int r = 0; r < repetitions; r++)
+        for (size_t i = 0; i < numPairs; i++)
+        {
+            Store::Polynomial remainder;
+            store.divide(dividendHandles[i], divisorHandles[i], quotientHandles[i], remainder);
+            Store::Polynomial product = store.multiply(divisorHandles[i], quotientHandles[i]);
+            if (store.add(product, remainder) != dividendHandles[i])
+                numStoreErrors++;
+        }
+    double storeSeconds = duration< double >(steady_clock::now() - start).count();
+
+    // both ways must find the same quotients
+    int numMismatches = 0;
+    for (size_t i = 0; i < numPairs; i++)
+        if (!equal(quotientHandles[i]->terms, quotients[i]))
+            numMismatches++;
+
+    const StoreStatistics& counters = store.counters();
+
+    cout << fixed << setprecision(4);
+    cout << setw(20) << "plain seconds" << setw(12) << plainSeconds << endl;
+    cout << setw(20) << "store seconds" << setw(12) << storeSeconds << endl;
+    cout << setw(20) << "polynomials" << setw(12) << store.size() << endl;
+    cout << setw(20) << "intern hits" << setw(12) << counters.internHits << endl;
+    cout << setw(20) << "intern misses" << setw(12) << counters.internMisses << endl;
+    cout << setw(20) << "intern hit rate" << setw(12) << counters.internHitRate() << endl;
+    cout << setw(20) << "cache hits" << setw(12) << counters.cacheHits << endl;
+    cout << setw(20) << "cache misses" << setw(12) << counters.cacheMisses << endl;
+    cout << setw(20) << "cache evictions" << setw(12) << counters.cacheEvictions << endl;
+    cout << setw(20) << "cache hit rate" << setw(12) << counters.cacheHitRate() << endl;
+
+    int numErrors = numPlainErrors + numStoreErrors + numMismatches;
+    cout << "\nThere are " << numErrors << " errors!\n";
+
+    return numErrors == 0 ? 0 : 1;
+}
+
+// returns true if and only if polynomial1 == polynomial2
+bool equal(const vector< Term >& polynomial1, const vector< Term >& polynomial2)
+{
+    if (polynomial1.size() != polynomial2.size())
+        return false;
+
+    for (size_t i = 0; i < polynomial1.size(); i++)
+        if (polynomial1[i].coef != polynomial2[i].coef || polynomial1[i].expon != polynomial2[i].expon)
+            return false;
+
+    return true;
+}
@@ -0,0 +1,555 @@
+// TermTree.h
+// A sorted container of terms built as a B+ tree of cache-line-sized chunks.
+//
+// The terms are kept in descending order of exponents in leaves of about 64 bytes, linked from
+// first to last for iteration; branches route an exponent to its leaf by up to 16 keys. Adding
+// to, inserting or erasing one exponent touches one leaf and the path above it, so a remainder
+// that changes a few terms at a time is never copied as a whole.
+//
+// A leaf that fills up is split in half, except at the end of the tree, where appending in
+// descending order starts a new leaf and leaves the full ones full. A node that falls below a
+// quarter of its capacity is merged into a neighbour when both fit in one node, and an empty
+// node is always removed, so no leaf is ever empty.
+
+#ifndef TERM_TREE_H
+#define TERM_TREE_H
+
+#include <type_traits>
+#include <vector>
+
+template< typename TermType >
+class TermTree
+{
+public:
+    typedef typename std::remove_cv< decltype(TermType::coef) >::type Coef;
+    typedef typename std::remove_cv< decltype(TermType::expon) >::type Expon;
+
+    // the number of terms in a leaf ( one cache line of terms, at least 4 ) and of children of a branch
+    static const int leafCapacity = 4 * sizeof(TermType) <= 64 ? static_cast< int >(64 / sizeof(TermType)) : 4;
+    static const int branchCapacity = 16;
+
+private:
+    struct Leaf
+    {
+        int size = 0;
+        Leaf* previous = nullptr;
+        Leaf* next = nullptr;
+        TermType terms[leafCapacity];
+    };
+
+    // keys[ i ] is at least the largest exponent under children[ i ] and smaller than every
+    // exponent under children[ i - 1 ]
+    struct Branch
+    {
+        int size = 0;
+        Expon keys[branchCapacity];
+        void* children[branchCapacity];
+    };
+
+public:
+    // iterates over the terms in descending order of exponents
+    class const_iterator
+    {
+    public:
+        const_iterator(const Leaf* leaf = nullptr, int index = 0)
+            : leaf(leaf), index(index)
+        {
+        }
+
+        const TermType& operator*() const { return leaf->terms[index]; }
+        const TermType* operator->() const { return &leaf->terms[index]; }
+
+        const_iterator& operator++()
+        {
+            if (++index == leaf->size)
+            {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        bool operator==(const const_iterator& iterator2) const
+        {
+            return leaf == iterator2.leaf && index == iterator2.index;
+        }
+
+        bool operator!=(const const_iterator& iterator2) const
+        {
+            return !(*this == iterator2);
+        }
+
+    private:
+        const Leaf* leaf; // null at the end
+        int index;
+    };
+
+    TermTree() = default;
+
+    TermTree(const TermTree&) = delete;
+    TermTree& operator=(const TermTree&) = delete;
+
+    ~TermTree()
+    {
+        clear();
+    }
+
+    // removes every term
+    void clear()
+    {
+        if (root != nullptr)
+            destroy(root, height);
+
+        root = nullptr;
+        height = 0;
+        first = nullptr;
+        last = nullptr;
+        numTerms = 0;
+    }
+
+    int size() const
+    {
+        return numTerms;
+    }
+
+    bool empty() const
+    {
+        return numTerms == 0;
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(first, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator();
+    }
+
+    // returns the term of the largest exponent, provided that the tree is not empty
+    const TermType& front() const
+    {
+        return first->terms[0];
+    }
+
+    // returns the first term whose exponent is less than or equal to expon
+    const_iterator lowerBound(const Expon& expon) const
+    {
+        const Leaf* leaf = findLeaf(expon);
+        if (leaf == nullptr)
+            return end();
+
+        int position = leafPosition(leaf, expon);
+        return position < leaf->size ? const_iterator(leaf, position) : const_iterator(leaf->next, 0);
+    }
+
+    // returns the first term whose exponent is less than expon
+    const_iterator upperBound(const Expon& expon) const
+    {
+        const_iterator iterator = lowerBound(expon);
+        if (iterator != end() && iterator->expon == expon)
+            ++iterator;
+        return iterator;
+    }
+
+    // returns the term of exponent expon, or null if there is none
+    const TermType* find(const Expon& expon) const
+    {
+        const_iterator iterator = lowerBound(expon);
+        return iterator != end() && iterator->expon == expon ? &*iterator : nullptr;
+    }
+
+    // appends a term whose exponent is smaller than every exponent in the tree
+    void append(const Coef& coef, const Expon& expon)
+    {
+        if (last != nullptr && last->size < leafCapacity)
+        {
+            last->terms[last->size].coef = coef;
+            last->terms[last->size].expon = expon;
+            last->size++;
+            numTerms++;
+        }
+        else
+            add(coef, expon);
+    }
+
+    // adds coef to the term of exponent expon, inserting it if there is none and erasing it if
+    // the sum is zero
+    void add(const Coef& coef, const Expon& expon)
+    {
+        if (root == nullptr)
+        {
+            if (coef == Coef())
+                return;
+
+            Leaf* leaf = new Leaf();
+            leaf->terms[0].coef = coef;
+            leaf->terms[0].expon = expon;
+            leaf->size = 1;
+            root = leaf;
+            first = leaf;
+            last = leaf;
+            numTerms = 1;
+            return;
+        }
+
+        Leaf* leaf = descend(expon, true);
+        int position = leafPosition(leaf, expon);
+
+        if (position < leaf->size && leaf->terms[position].expon == expon)
+        {
+            Coef sum = leaf->terms[position].coef + coef;
+            if (sum == Coef())
+                eraseAt(leaf, position);
+            else
+                leaf->terms[position].coef = sum;
+        }
+        else if (coef != Coef())
+            insertAt(leaf, position, coef, expon);
+    }
+
+    // erases the term of exponent expon; returns false if there is none
+    bool erase(const Expon& expon)
+    {
+        if (root == nullptr)
+            return false;
+
+        Leaf* leaf = descend(expon, false);
+        int position = leafPosition(leaf, expon);
+        if (position == leaf->size || leaf->terms[position].expon != expon)
+            return false;
+
+        eraseAt(leaf, position);
+        return true;
+    }
+
+private:
+    // a branch on the path from the root to a leaf and the index of the child taken
+    struct Step
+    {
+        Branch* branch;
+        int index;
+    };
+
+    // returns the index of the child of branch whose exponents include expon
+    static int childIndex(const Branch* branch, const Expon& expon)
+    {
+        int i = 0;
+        while (i + 1 < branch->size && branch->keys[i + 1] >= expon)
+            i++;
+        return i;
+    }
+
+    // returns the position of the first term of leaf whose exponent is less than or equal to expon
+    static int leafPosition(const Leaf* leaf, const Expon& expon)
+    {
+        int position = 0;
+        while (position < leaf->size && leaf->terms[position].expon > expon)
+            position++;
+        return position;
+    }
+
+    // returns the largest exponent of node, a leaf if level == height
+    Expon firstExpon(void* node, int level) const
+    {
+        return level == height ? static_cast< Leaf* >(node)->terms[0].expon : static_cast< Branch* >(node)->keys[0];
+    }
+
+    // returns the leaf where expon is or belongs, or null if the tree is empty
+    const Leaf* findLeaf(const Expon& expon) const
+    {
+        const void* node = root;
+        for (int level = 0; node != nullptr && level < height; level++)
+        {
+            const Branch* branch = static_cast< const Branch* >(node);
+            node = branch->children[childIndex(branch, expon)];
+        }
+        return static_cast< const Leaf* >(node);
+    }
+
+    // returns the leaf where expon is or belongs and records the path to it; a key is raised
+    // when expon is about to be inserted above every exponent of its child
+    Leaf* descend(const Expon& expon, bool inserting)
+    {
+        path.clear();
+        void* node = root;
+        for (int level = 0; level < height; level++)
+        {
+            Branch* branch = static_cast< Branch* >(node);
+            int i = childIndex(branch, expon);
+            if (inserting && branch->keys[i] < expon)
+                branch->keys[i] = expon;
+            path.push_back(Step{ branch, i });
+            node = branch->children[i];
+        }
+        return static_cast< Leaf* >(node);
+    }
+
+    // returns true if the node at level of the path is the last of its level
+    bool isLast(int level) const
+    {
+        for (int l = 0; l < level; l++)
+            if (path[l].index != path[l].branch->size - 1)
+                return false;
+        return true;
+    }
+
+    // inserts a term at position of leaf, the leaf at the end of path
+    void insertAt(Leaf* leaf, int position, const Coef& coef, const Expon& expon)
+    {
+        numTerms++;
+        if (leaf->size < leafCapacity)
+        {
+            insertTerm(leaf, position, coef, expon);
+            return;
+        }
+
+        // appending in order starts a new leaf; otherwise the upper half moves to a new leaf
+        Leaf* right = new Leaf();
+        int keep = position == leafCapacity && leaf == last ? leafCapacity : leafCapacity / 2;
+        for (int i = keep; i < leafCapacity; i++)
+            right->terms[i - keep] = leaf->terms[i];
+        right->size = leafCapacity - keep;
+        leaf->size = keep;
+
+        right->previous = leaf;
+        right->next = leaf->next;
+        if (leaf->next != nullptr)
+            leaf->next->previous = right;
+        leaf->next = right;
+        if (last == leaf)
+            last = right;
+
+        if (position <= keep && keep < leafCapacity)
+            insertTerm(leaf, position, coef, expon);
+        else
+            insertTerm(right, position - keep, coef, expon);
+
+        insertChild(height - 1, right->terms[0].expon, right);
+    }
+
+    static void insertTerm(Leaf* leaf, int position, const Coef& coef, const Expon& expon)
+    {
+        for (int i = leaf->size; i > position; i--)
+            leaf->terms[i] = leaf->terms[i - 1];
+        leaf->terms[position].coef = coef;
+        leaf->terms[position].expon = expon;
+        leaf->size++;
+    }
+
+    // inserts child, whose largest exponent is key, after the child taken at level of the path
+    void insertChild(int level, const Expon& key, void* child)
+    {
+        if (level < 0)
+        {
+            // the root was split; a new root holds both halves
+            Branch* branch = new Branch();
+            branch->keys[0] = firstExpon(root, 0);
+            branch->children[0] = root;
+            branch->keys[1] = key;
+            branch->children[1] = child;
+            branch->size = 2;
+            root = branch;
+            height++;
+            return;
+        }
+
+        Branch* branch = path[level].branch;
+        int position = path[level].index + 1;
+        if (branch->size < branchCapacity)
+        {
+            insertKey(branch, position, key, child);
+            return;
+        }
+
+        Branch* right = new Branch();
+        int keep = position == branchCapacity && isLast(level) ? branchCapacity : branchCapacity / 2;
+        for (int i = keep; i < branchCapacity; i++)
+        {
+            right->keys[i - keep] = branch->keys[i];
+            right->children[i - keep] = branch->children[i];
+        }
+        right->size = branchCapacity - keep;
+        branch->size = keep;
+
+        if (position <= keep && keep < branchCapacity)
+            insertKey(branch, position, key, child);
+        else
+            insertKey(right, position - keep, key, child);
+
+        insertChild(level - 1, right->keys[0], right);
+    }
+
+    static void insertKey(Branch* branch, int position, const Expon& key, void* child)
+    {
+        for (int i = branch->size; i > position; i--)
+        {
+            branch->keys[i] = branch->keys[i - 1];
+            branch->children[i] = branch->children[i - 1];
+        }
+        branch->keys[position] = key;
+        branch->children[position] = child;
+        branch->size++;
+    }
+
+    // erases the term at position of leaf, the leaf at the end of path
+    void eraseAt(Leaf* leaf, int position)
+    {
+        numTerms--;
+        for (int i = position + 1; i < leaf->size; i++)
+            leaf->terms[i - 1] = leaf->terms[i];
+        leaf->size--;
+
+        if (height == 0)
+        {
+            if (leaf->size == 0)
+                clear();
+            return;
+        }
+
+        if (leaf->size < leafCapacity / 4)
+            rebalance(height - 1);
+    }
+
+    // removes an empty child or merges an underfull one, the child taken at level of the path,
+    // with a neighbour; continues with the parent when it becomes underfull in turn
+    void rebalance(int level)
+    {
+        Branch* branch = path[level].branch;
+        int index = path[level].index;
+        bool leaves = level == height - 1;
+        int capacity = leaves ? leafCapacity : branchCapacity;
+
+        if (nodeSize(branch->children[index], leaves) == 0)
+        {
+            removeChild(branch, index, leaves);
+            destroyNode(branch->children[index], leaves);
+            eraseKey(branch, index);
+        }
+        else if (branch->size > 1)
+        {
+            // merge the pair of index and its left neighbour, or else its right neighbour
+            int left = index > 0 && nodeSize(branch->children[index - 1], leaves) +
+                nodeSize(branch->children[index], leaves) <= capacity ? index - 1 : index;
+            if (left + 1 < branch->size && nodeSize(branch->children[left], leaves) +
+                nodeSize(branch->children[left + 1], leaves) <= capacity)
+            {
+                merge(branch->children[left], branch->children[left + 1], leaves);
+                removeChild(branch, left + 1, leaves);
+                destroyNode(branch->children[left + 1], leaves);
+                eraseKey(branch, left + 1);
+            }
+        }
+
+        if (level == 0)
+        {
+            // a root with one child is replaced by it
+            if (branch->size == 1)
+            {
+                root = branch->children[0];
+                height--;
+                delete branch;
+            }
+            else if (branch->size == 0)
+            {
+                delete branch;
+                root = nullptr;
+                height = 0;
+            }
+        }
+        else if (branch->size < branchCapacity / 4)
+            rebalance(level - 1);
+    }
+
+    static int nodeSize(void* node, bool leaf)
+    {
+        return leaf ? static_cast< Leaf* >(node)->size : static_cast< Branch* >(node)->size;
+    }
+
+    // unlinks the leaf children[ index ] from the list of leaves
+    void removeChild(Branch* branch, int index, bool leaves)
+    {
+        if (!leaves)
+            return;
+
+        Leaf* leaf = static_cast< Leaf* >(branch->children[index]);
+        if (leaf->previous != nullptr)
+            leaf->previous->next = leaf->next;
+        else
+            first = leaf->next;
+        if (leaf->next != nullptr)
+            leaf->next->previous = leaf->previous;
+        else
+            last = leaf->previous;
+    }
+
+    static void eraseKey(Branch* branch, int index)
+    {
+        for (int i = index + 1; i < branch->size; i++)
+        {
+            branch->keys[i - 1] = branch->keys[i];
+            branch->children[i - 1] = branch->children[i];
+        }
+        branch->size--;
+    }
+
+    // moves the contents of right to the end of left
+    static void merge(void* left, void* right, bool leaves)
+    {
+        if (leaves)
+        {
+            Leaf* leftLeaf = static_cast< Leaf* >(left);
+            Leaf* rightLeaf = static_cast< Leaf* >(right);
+            for (int i = 0; i < rightLeaf->size; i++)
+                leftLeaf->terms[leftLeaf->size + i] = rightLeaf->terms[i];
+            leftLeaf->size += rightLeaf->size;
+            rightLeaf->size = 0;
+        }
+        else
+        {
+            Branch* leftBranch = static_cast< Branch* >(left);
+            Branch* rightBranch = static_cast< Branch* >(right);
+            for (int i = 0; i < rightBranch->size; i++)
+            {
+                leftBranch->keys[leftBranch->size + i] = rightBranch->keys[i];
+                leftBranch->children[leftBranch->size + i] = rightBranch->children[i];
+            }
+            leftBranch->size += rightBranch->size;
+            rightBranch->size = 0;
+        }
+    }
+
+    // frees node, whose children have been moved or freed
+    static void destroyNode(void* node, bool leaf)
+    {
+        if (leaf)
+            delete static_cast< Leaf* >(node);
+        else
+            delete static_cast< Branch* >(node);
+    }
+
+    // frees node and everything under it; levels is the number of branch levels from node down
+    static void destroy(void* node, int levels)
+    {
+        if (levels == 0)
+        {
+            delete static_cast< Leaf* >(node);
+            return;
+        }
+
+        Branch* branch = static_cast< Branch* >(node);
+        for (int i = 0; i < branch->size; i++)
+            destroy(branch->children[i], levels - 1);
+        delete branch;
+    }
+
+    void* root = nullptr; // a Leaf if height == 0, otherwise a Branch
+    int height = 0;       // the number of branch levels
+    Leaf* first = nullptr;
+    Leaf* last = nullptr;
+    int numTerms = 0;
+    std::vector< Step > path; // the path taken by the last descend
+};
+
+#endif
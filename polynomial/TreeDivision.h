@@ -0,0 +1,65 @@
+// TreeDivision.h
+// Sparse polynomial division on a remainder kept in a TermTree.
+//
+// The remainder starts as a copy of the dividend. Every quotient term subtracts one scaled
+// copy of the divisor from it, term by term, in O( |divisor| * log |remainder| ) instead of
+// rewriting the whole remainder, and the division goes on with the next term below the one
+// just divided. When no term is left to divide, the tree holds the remainder.
+
+#ifndef TREE_DIVISION_H
+#define TREE_DIVISION_H
+
+#include "HeapDivision.h"
+#include "TermTree.h"
+
+// quotient = dividend / divisor; remainder = dividend % divisor, provided that divisor != 0;
+// calls emitQuotient( coef, expon ) and emitRemainder( coef, expon ) for their terms, each in
+// descending order of exponents, with the integer quotients of heapDivision
+template< typename Layout1, typename Layout2, typename EmitQuotient, typename EmitRemainder >
+void treeDivision(const Layout1& dividend, const Layout2& divisor,
+    EmitQuotient emitQuotient, EmitRemainder emitRemainder)
+{
+    typedef typename Layout1::Coef Coef;
+    typedef typename Layout1::Expon Expon;
+
+    struct Term
+    {
+        Coef coef;
+        Expon expon;
+    };
+
+    TermTree< Term > remainder;
+    for (int k = 0; k < dividend.size; k++)
+        remainder.append(dividend.coef(k), dividend.expon(k));
+
+    const Coef leadingCoef = divisor.coef(0);
+    const Expon leadingExpon = divisor.expon(0);
+
+    typename TermTree< Term >::const_iterator next = remainder.begin();
+    while (next != remainder.end())
+    {
+        Expon expon = next->expon;
+        Coef quotient = Coef();
+        if (exponentDivides(leadingExpon, expon))
+            quotient = next->coef / leadingCoef;
+
+        if (quotient == Coef())
+        {
+            ++next;
+            continue;
+        }
+
+        // remainder -= divisor * quotient term; the term of expon keeps the rest of its coefficient
+        Expon quotientExpon = expon - leadingExpon;
+        emitQuotient(quotient, quotientExpon);
+        for (int i = 0; i < divisor.size; i++)
+            remainder.add(-(divisor.coef(i) * quotient), divisor.expon(i) + quotientExpon);
+
+        next = remainder.upperBound(expon);
+    }
+
+    for (typename TermTree< Term >::const_iterator term = remainder.begin(); term != remainder.end(); ++term)
+        emitRemainder(term->coef, term->expon);
+}
+
+#endif
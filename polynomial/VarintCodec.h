@@ -0,0 +1,102 @@
+// VarintCodec.h
+// Variable-length integers for the compact polynomial layout.
+//
+// An unsigned value is stored 7 bits per byte, least significant group first; the high bit
+// of a byte is set when more bytes follow ( LEB128 ). A signed value is first mapped by
+// zigzag encoding, 0, -1, 1, -2, ... to 0, 1, 2, 3, ..., so that small magnitudes of either
+// sign take one byte.
+//
+// Decoding looks at 8 bytes at a time ( SWAR, "SIMD within a register" ): when none of them
+// has its high bit set, they are 8 one-byte values and are stored without a loop over bits.
+// Term exponent gaps and small coefficients are almost always one byte, so this is the
+// common case; the words are read with memcpy, which needs no alignment and no intrinsics.
+
+#ifndef VARINT_CODEC_H
+#define VARINT_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// the largest number of bytes of a varint of a 64-bit value
+const int maxVarintBytes = 10;
+
+// maps a signed value to an unsigned one with small values for small magnitudes
+inline uint64_t zigzagEncode(long long value)
+{
+    return (static_cast< uint64_t >(value) << 1) ^ static_cast< uint64_t >(value >> 63);
+}
+
+// the inverse of zigzagEncode
+inline long long zigzagDecode(uint64_t value)
+{
+    return static_cast< long long >((value >> 1) ^ (0 - (value & 1)));
+}
+
+// appends the varint of value to bytes
+inline void appendVarint(std::vector< unsigned char >& bytes, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        bytes.push_back(static_cast< unsigned char >(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast< unsigned char >(value));
+}
+
+// decodes one varint from data[ position .. size - 1 ] into value and advances position;
+// returns false if the varint is cut off or longer than maxVarintBytes
+inline bool decodeVarint(const unsigned char* data, size_t size, size_t& position, uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 7 * maxVarintBytes && position < size; shift += 7)
+    {
+        unsigned char byte = data[position++];
+        value |= static_cast< uint64_t >(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+// decodes count varints from data[ position .. size - 1 ] into values and advances position;
+// returns false if the data ends too early or holds a malformed varint
+inline bool decodeVarints(const unsigned char* data, size_t size, size_t& position,
+    uint64_t* values, size_t count)
+{
+    const uint64_t highBits = 0x8080808080808080ULL;
+
+    size_t i = 0;
+    while (i < count)
+    {
+        // eight one-byte varints are copied at once; otherwise the varints that start in
+        // these 8 bytes are decoded one by one before the next word is tried
+        size_t wordEnd = position + 8;
+        if (count - i >= 8 && size - position >= 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, data + position, 8);
+            if ((word & highBits) == 0)
+            {
+                for (int k = 0; k < 8; k++)
+                    values[i + k] = data[position + k];
+                i += 8;
+                position += 8;
+                continue;
+            }
+        }
+
+        do
+        {
+            if (!decodeVarint(data, size, position, values[i]))
+                return false;
+            i++;
+        } while (i < count && position < wordEnd);
+    }
+
+    return true;
+}
+
+#endif